@@ -0,0 +1,65 @@
+/*!
+ * minter-tx.
+ * main.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <iostream>
+#include <string>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_multisend_planner.h>
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+int main(int argc, char **argv) {
+    po::options_description desc("Minter multisend payouts planner");
+    desc.add_options()
+            ("help", "print this help");
+
+    desc.add_options()
+            ("input", po::value<std::string>(), "Payouts file, row per line: coin,address,amount")
+            ("output", po::value<std::string>(), "Signed transactions file, hex encoded, one per line")
+            ("private-key", po::value<std::string>(), "Sender private key, hex encoded")
+            ("nonce", po::value<uint64_t>(), "Nonce of the first transaction")
+            ("chain-id", po::value<unsigned>()->default_value(minter::mainnet), "1 - mainnet, 2 - testnet")
+            ("gas-coin", po::value<std::string>()->default_value("BIP"), "Gas coin")
+            ("gas-price", po::value<std::string>()->default_value("1"), "Gas price")
+            ("max-items", po::value<size_t>()->default_value(100), "Items per transaction")
+            ("threads", po::value<size_t>()->default_value(0), "Signing threads, 0 - all hardware threads");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") || !vm.count("input") || !vm.count("output") || !vm.count("private-key")
+        || !vm.count("nonce")) {
+        std::cout << desc << "\n";
+        return vm.count("help") ? 0 : 1;
+    }
+
+    minter::tx_multisend_planner::options opts;
+    opts.chain_id = (uint8_t) vm.at("chain-id").as<unsigned>();
+    opts.gas_coin = vm.at("gas-coin").as<std::string>();
+    opts.gas_price = dev::bigint(vm.at("gas-price").as<std::string>());
+    opts.max_items = vm.at("max-items").as<size_t>();
+    opts.threads = vm.at("threads").as<size_t>();
+
+    minter::tx_multisend_plan_stats stats;
+    try {
+        const minter::privkey_t pk(vm.at("private-key").as<std::string>().c_str());
+        minter::tx_multisend_planner planner(pk, vm.at("nonce").as<uint64_t>(), opts);
+        stats = planner.plan_file(vm.at("input").as<std::string>(), vm.at("output").as<std::string>());
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::cerr << "planned " << stats.rows << " payouts in " << stats.txs << " transactions, fee "
+              << minter::utils::humanize_value(stats.fee) << " (" << stats.bytes << " bytes) in "
+              << stats.seconds << " s: " << (size_t) stats.rows_per_second() << " rows/s\n";
+    return 0;
+}
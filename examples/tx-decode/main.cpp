@@ -0,0 +1,90 @@
+/*!
+ * minter-tx.
+ * main.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <iostream>
+#include <string>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_stream_decoder.h>
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+int main(int argc, char **argv) {
+    po::options_description desc("Minter transactions dump decoder");
+    desc.add_options()
+            ("help", "print this help");
+
+    desc.add_options()
+            ("input", po::value<std::string>(), "Dump file, \"-\" or nothing to read stdin")
+            ("format", po::value<std::string>()->default_value("hex"),
+             "Dump format: hex (transaction per line) or binary (4-byte big-endian length before transaction)")
+            ("threads", po::value<size_t>()->default_value(0), "Decoding threads, 0 - all hardware threads")
+            ("batch", po::value<size_t>()->default_value(1024), "Transactions per worker batch")
+            ("quiet", "Print only errors and summary");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << "\n";
+        return 0;
+    }
+
+    minter::tx_stream_decoder::options opts;
+    const std::string format = vm.at("format").as<std::string>();
+    if (format == "hex") {
+        opts.format = minter::tx_stream_format::hex_lines;
+    } else if (format == "binary") {
+        opts.format = minter::tx_stream_format::length_prefixed;
+    } else {
+        std::cerr << "Invalid format: " << format << "\n";
+        return 1;
+    }
+    opts.threads = vm.at("threads").as<size_t>();
+    opts.batch_size = vm.at("batch").as<size_t>();
+    const bool quiet = vm.count("quiet") > 0;
+
+    auto print = [quiet](const minter::tx_stream_record &record) {
+        if (!record.status) {
+            std::cerr << record.index << ": error at " << record.status.offset << ": " << record.status.message()
+                      << "\n";
+            return;
+        }
+        if (quiet) {
+            return;
+        }
+
+        const char *type = minter::tx_type_registry::name(record.tx->get_type());
+        std::cout << record.index << ": "
+                  << (type != nullptr ? type : "unknown")
+                  << " nonce=" << record.tx->get_nonce()
+                  << " gas_coin=" << record.tx->get_gas_coin().c_str()
+                  << "\n";
+    };
+
+    minter::tx_stream_decoder decoder(opts);
+    minter::tx_stream_stats stats;
+    try {
+        if (!vm.count("input") || vm.at("input").as<std::string>() == "-") {
+            stats = decoder.decode(std::cin, print);
+        } else {
+            stats = decoder.decode_file(vm.at("input").as<std::string>(), print);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::cerr << "decoded " << stats.records << " transactions (" << stats.failed << " failed, "
+              << stats.bytes << " bytes) in " << stats.seconds << " s: "
+              << (size_t) stats.records_per_second() << " tx/s\n";
+
+    return stats.failed == 0 ? 0 : 2;
+}
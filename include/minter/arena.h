@@ -0,0 +1,120 @@
+/*!
+ * minter_tx.
+ * arena.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_ARENA_H
+#define MINTER_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include "minter/eth/Common.h"
+
+namespace minter {
+
+/// \brief Monotonic memory region for batch processing: allocation is a pointer bump, memory is never freed
+/// piece by piece, but all at once by release() or destructor.
+/// Transactions made with value_tx(arena*) keep their variable-length data here: long payload, service data
+/// and signature, multisend items. value_tx::sign_single() writes signed transactions here.
+/// Not thread-safe: use one arena per thread, so threads don't contend on global allocator.
+class arena {
+public:
+    static constexpr size_t default_chunk_size = 64 * 1024;
+
+    explicit arena(size_t chunk_size = default_chunk_size);
+    arena(const arena &other) = delete;
+    arena &operator=(const arena &other) = delete;
+    arena(arena &&other) noexcept;
+    arena &operator=(arena &&other) noexcept;
+    ~arena();
+
+    /// \brief Allocates memory from current chunk, or from a new one if it doesn't fit
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    /// \brief Allocates uninitialized byte buffer
+    dev::bytesRef allocate_bytes(size_t size);
+
+    /// \brief Releases all allocated memory at once. First chunk is kept for reuse, if it has default size,
+    /// so cycling batches through the same arena doesn't touch global allocator at all.
+    /// Objects keeping data here (value_tx, small_bytes, send_target_list) must not be used after it
+    void release() noexcept;
+
+    /// \brief true if p points into memory of this arena
+    bool contains(const void *p) const noexcept;
+
+    /// \brief Bytes handed out since last release()
+    size_t allocated() const noexcept;
+    /// \brief Bytes reserved from global allocator
+    size_t capacity() const noexcept;
+
+private:
+    struct chunk {
+      chunk *next;
+      size_t size;
+    };
+
+    void add_chunk(size_t min_size);
+    void free_chunks(chunk *from) noexcept;
+
+    chunk *m_head = nullptr;
+    uint8_t *m_cur = nullptr;
+    uint8_t *m_end = nullptr;
+    size_t m_chunk_size;
+    size_t m_allocated = 0;
+    size_t m_capacity = 0;
+};
+
+/// \brief Standard allocator over arena, or over global heap if arena is nullptr.
+/// Deallocation from arena does nothing, memory is freed by arena::release().
+/// Allocator follows memory on copy, move and swap, so containers never keep memory of one arena
+/// while allocating from another.
+template<typename T>
+class arena_allocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    arena_allocator() noexcept = default;
+    explicit arena_allocator(minter::arena *arena) noexcept : m_arena(arena) { }
+    template<typename U>
+    arena_allocator(const arena_allocator<U> &other) noexcept : m_arena(other.get_arena()) { }
+
+    T *allocate(size_t n) {
+        if (m_arena == nullptr) {
+            return (T *) ::operator new(n * sizeof(T));
+        }
+        return (T *) m_arena->allocate(n * sizeof(T), alignof(T));
+    }
+    void deallocate(T *p, size_t) noexcept {
+        if (m_arena == nullptr) {
+            ::operator delete(p);
+        }
+    }
+
+    minter::arena *get_arena() const noexcept {
+        return m_arena;
+    }
+
+private:
+    minter::arena *m_arena = nullptr;
+};
+
+template<typename T, typename U>
+bool operator==(const arena_allocator<T> &lhs, const arena_allocator<U> &rhs) noexcept {
+    return lhs.get_arena() == rhs.get_arena();
+}
+template<typename T, typename U>
+bool operator!=(const arena_allocator<T> &lhs, const arena_allocator<U> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}
+
+#endif //MINTER_ARENA_H
@@ -0,0 +1,89 @@
+/*!
+ * minter_tx.
+ * coin_symbol.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_COIN_SYMBOL_H
+#define MINTER_COIN_SYMBOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include "minter/eth/Common.h"
+
+namespace minter {
+namespace data {
+
+/// \brief Coin ticker, stored inline as null-padded bytes, the same way it is encoded in transaction.
+/// Trivially copyable, so copying, comparing, encoding and decoding of coins never allocates.
+class coin_symbol {
+public:
+    /// \brief Encoded (and maximum) symbol length
+    static constexpr size_t max_length = 10;
+
+    coin_symbol() noexcept;
+    /// \throws std::runtime_error if symbol is longer than max_length
+    coin_symbol(const char *symbol);
+    /// \throws std::runtime_error if symbol is longer than max_length
+    coin_symbol(const std::string &symbol);
+    /// \brief Creates coin from encoded (null-padded) bytes, null bytes are skipped
+    /// \throws std::runtime_error if symbol is longer than max_length
+    explicit coin_symbol(dev::bytesConstRef encoded);
+
+    /// \brief Null-terminated symbol
+    const char *c_str() const noexcept;
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+    /// \brief Checks symbol conforms to blockchain rules: 3-10 chars of A-Z and 0-9
+    bool is_valid() const noexcept;
+    /// \brief Symbol padded with null bytes up to max_length, as it should be written to RLP
+    dev::bytesConstRef encoded() const noexcept;
+    std::string to_string() const;
+
+    operator std::string() const;
+
+    bool operator==(const coin_symbol &other) const noexcept {
+        return memcmp(m_data, other.m_data, sizeof(m_data)) == 0;
+    }
+    bool operator!=(const coin_symbol &other) const noexcept {
+        return !operator==(other);
+    }
+    bool operator<(const coin_symbol &other) const noexcept {
+        return memcmp(m_data, other.m_data, sizeof(m_data)) < 0;
+    }
+
+private:
+    void assign(const char *symbol, size_t len);
+
+    // rounded up to two machine words, so comparison is just two word compares and c_str() is always terminated
+    alignas(8) uint8_t m_data[16];
+};
+
+static_assert(std::is_trivially_copyable<coin_symbol>::value, "coin_symbol must be trivially copyable");
+
+} // data
+
+using coin_symbol = minter::data::coin_symbol;
+} // minter
+
+namespace std {
+template<>
+struct hash<minter::coin_symbol> {
+  std::size_t operator()(const minter::coin_symbol &k) const noexcept {
+      uint64_t words[2];
+      memcpy(words, k.c_str(), sizeof(words));
+      return std::hash<uint64_t>()(words[0] ^ (words[1] * 0x9e3779b97f4a7c15ULL));
+  }
+};
+}
+
+std::ostream &operator<<(std::ostream &out, const minter::coin_symbol &coin);
+
+#endif //MINTER_COIN_SYMBOL_H
@@ -453,6 +453,60 @@ private:
     std::vector<std::pair<size_t, size_t>> m_listStack;
 };
 
+/// @returns the size of the header RLPStream writes for a string or list with @a _payloadSize bytes of payload.
+inline size_t rlpHeaderSize(size_t _payloadSize) { return _payloadSize < c_rlpDataImmLenCount ? 1 : 1 + bytesRequired(_payloadSize); }
+
+/// @returns the encoded size of a byte string of @a _len bytes. Not exact for single bytes below 0x80, use rlpItemSize() for them.
+inline size_t rlpDataSize(size_t _len) { return rlpHeaderSize(_len) + _len; }
+
+/// @returns the encoded size of a list with @a _payloadSize bytes of already encoded items.
+inline size_t rlpListSize(size_t _payloadSize) { return rlpHeaderSize(_payloadSize) + _payloadSize; }
+
+/// @returns the exact size RLPStream::append(bytesConstRef) writes for @a _s.
+inline size_t rlpItemSize(bytesConstRef _s) { return (_s.size() == 1 && _s[0] < c_rlpDataImmLenStart) ? 1 : rlpDataSize(_s.size()); }
+inline size_t rlpItemSize(bytes const& _s) { return rlpItemSize(bytesConstRef(&_s)); }
+inline size_t rlpItemSize(std::string const& _s) { return rlpItemSize(bytesConstRef(_s)); }
+
+/// @returns the exact size RLPStream::append(bigint) writes for @a _i.
+inline size_t rlpItemSize(bigint const& _i)
+{
+    if (_i < c_rlpDataImmLenStart)
+        return 1;
+    return rlpDataSize(boost::multiprecision::msb(_i) / 8 + 1);
+}
+
+/// Writes the header RLPStream writes for a string (or a list if @a _isList) with @a _payloadSize bytes of payload.
+/// @returns the number of bytes written, i.e. rlpHeaderSize(_payloadSize).
+size_t rlpWriteHeader(byte* _out, size_t _payloadSize, bool _isList);
+
+/// Writes @a _s exactly as RLPStream::append(bytesConstRef) does. @returns the number of bytes written, i.e. rlpItemSize(_s).
+size_t rlpWriteItem(byte* _out, bytesConstRef _s);
+
+/// Writes @a _i exactly as RLPStream::append(bigint) does. @returns the number of bytes written, i.e. rlpItemSize(_i).
+size_t rlpWriteItem(byte* _out, bigint const& _i);
+
+/// Errors of non-throwing RLP parsing.
+enum class RLPError: uint8_t
+{
+    None = 0,
+    Truncated,      ///< Item goes beyond the data, or its length prefix is too big.
+    NonCanonical,   ///< Length encoded in a longer form than needed.
+    Oversize,       ///< Data continues after the item.
+    TooDeep         ///< Lists nested deeper than c_rlpMaxDepth.
+};
+
+/// Max nesting of lists accepted by rlpValidate().
+static const size_t c_rlpMaxDepth = 32;
+
+/// Non-throwing parse of the header of the item at the start of @a _d.
+/// On success sets @a _isList, @a _headerSize and @a _payloadSize, and guarantees the item fits in @a _d.
+RLPError rlpTryParseHeader(bytesConstRef _d, bool& _isList, size_t& _headerSize, size_t& _payloadSize);
+
+/// Non-throwing check that @a _d holds exactly one well-formed item, including all nested items,
+/// so it can be read with RLP without structural exceptions. Walks the data once, without recursion or allocations.
+/// @returns error, and sets @a _errorOffset to offset of the bad item in @a _d.
+RLPError rlpValidate(bytesConstRef _d, size_t& _errorOffset);
+
 template <class _T> void rlpListAux(RLPStream& _out, _T _t) { _out << _t; }
 template <class _T, class ... _Ts> void rlpListAux(RLPStream& _out, _T _t, _Ts ... _ts) { rlpListAux(_out << _t, _ts...); }
 
@@ -0,0 +1,59 @@
+/*!
+ * minter_tx.
+ * hex.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_HEX_H
+#define MINTER_HEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "minter/eth/Common.h"
+
+namespace minter {
+
+/// \brief Hex encoder/decoder implementation. Vectorized implementations (SSE2, AVX2) are compiled on x86
+/// with GCC or Clang, the fastest one supported by CPU is chosen at runtime; elsewhere scalar one is used.
+struct hex_codec {
+  /// \brief Writes 2 * size lowercase hex chars to out, without trailing zero
+  using encode_fn = void (*)(const uint8_t *data, size_t size, char *out);
+  /// \brief Decodes even number of hex chars (any case) to size / 2 bytes
+  /// \return false if input has non-hex char, its position is written to error_pos; out is partially written
+  using decode_fn = bool (*)(const char *hex, size_t size, uint8_t *out, size_t &error_pos);
+
+  const char *name;
+  encode_fn encode;
+  decode_fn decode;
+
+  /// \brief Fastest codec supported by CPU, chosen on first call
+  static const hex_codec &get();
+  /// \brief All codecs supported by CPU, scalar first
+  static std::vector<const hex_codec *> supported();
+};
+
+/// \brief Writes 2 * size lowercase hex chars to out using fastest codec
+void hex_encode(const uint8_t *data, size_t size, char *out);
+/// \brief Decodes hex chars to size / 2 bytes using fastest codec
+/// \return false if size is odd (error_pos is size) or input has non-hex char (error_pos is its position)
+bool hex_decode(const char *hex, size_t size, uint8_t *out, size_t &error_pos);
+
+std::string to_hex(dev::bytesConstRef data);
+/// \brief Decodes hex string, "0x" prefix is optional, odd length is read as if it had leading zero
+/// \throws std::runtime_error if string has non-hex char
+std::vector<uint8_t> from_hex(const char *hex, size_t size);
+std::vector<uint8_t> from_hex(const char *hex);
+std::vector<uint8_t> from_hex(const std::string &hex);
+
+/// \brief Writes hex to stream through fixed stack buffer, without building a string
+void write_hex(std::ostream &out, dev::bytesConstRef data);
+
+}
+
+#endif //MINTER_HEX_H
@@ -0,0 +1,279 @@
+/*!
+ * minter_tx.
+ * small_bytes.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_SMALL_BYTES_H
+#define MINTER_SMALL_BYTES_H
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "minter/arena.h"
+#include "minter/eth/Common.h"
+
+namespace minter {
+
+/// \brief Byte container which keeps up to N bytes inline and allocates only for longer data.
+/// Longer data is kept in regular dev::bytes, so moving a long vector in does not copy it.
+/// If container is made with arena, longer data is kept in arena instead. Arena follows data on copy and move.
+/// Converts implicitly to dev::bytesConstRef, so it can be passed to RLP and anything else accepting refs.
+template<size_t N>
+class small_bytes {
+public:
+    using value_type = uint8_t;
+    using iterator = uint8_t *;
+    using const_iterator = const uint8_t *;
+    static constexpr size_t inline_capacity = N;
+
+    small_bytes() noexcept = default;
+    /// \brief Empty container, which keeps data longer than N in arena. Arena must outlive container
+    explicit small_bytes(minter::arena *arena) noexcept : m_arena(arena) { }
+    small_bytes(dev::bytesConstRef data) {
+        assign(data.data(), data.size());
+    }
+    small_bytes(const dev::bytes &data) {
+        assign(data.data(), data.size());
+    }
+    small_bytes(dev::bytes &&data) {
+        assign(std::move(data));
+    }
+    small_bytes(const uint8_t *data, size_t len) {
+        assign(data, len);
+    }
+    small_bytes(const small_bytes &other) : m_arena(other.m_arena) {
+        assign(other.data(), other.size());
+    }
+    small_bytes(small_bytes &&other) noexcept {
+        move_from(std::move(other));
+    }
+
+    small_bytes &operator=(const small_bytes &other) {
+        if (this != &other) {
+            use_arena(other.m_arena);
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+    small_bytes &operator=(small_bytes &&other) noexcept {
+        if (this != &other) {
+            move_from(std::move(other));
+        }
+        return *this;
+    }
+    small_bytes &operator=(dev::bytesConstRef data) {
+        assign(data.data(), data.size());
+        return *this;
+    }
+    small_bytes &operator=(const dev::bytes &data) {
+        assign(data.data(), data.size());
+        return *this;
+    }
+    small_bytes &operator=(dev::bytes &&data) {
+        assign(std::move(data));
+        return *this;
+    }
+
+    void assign(const uint8_t *data, size_t len) {
+        if (len <= N) {
+            if (len) {
+                memmove(m_inline, data, len);
+            }
+            m_heap.clear();
+        } else if (m_arena != nullptr) {
+            // source may be in old arena buffer, it stays valid
+            memmove(reserve_arena(len), data, len);
+        } else if (data >= m_heap.data() && data < m_heap.data() + m_heap.size()) {
+            // source is a part of own heap buffer: vector::assign can't take it
+            memmove(m_heap.data(), data, len);
+            m_heap.resize(len);
+        } else {
+            m_heap.assign(data, data + len);
+        }
+        m_size = len;
+    }
+
+    void assign(dev::bytes &&data) {
+        if (data.size() <= N || m_arena != nullptr) {
+            assign(data.data(), data.size());
+            return;
+        }
+        m_heap = std::move(data);
+        m_size = m_heap.size();
+    }
+
+    void resize(size_t len) {
+        if (len <= N) {
+            if (!is_inline()) {
+                memcpy(m_inline, data(), len);
+                m_heap.clear();
+            } else if (len > m_size) {
+                memset(m_inline + m_size, 0, len - m_size);
+            }
+        } else if (m_arena != nullptr) {
+            const uint8_t *old = data();
+            uint8_t *out = reserve_arena(len);
+            if (old != out && m_size) {
+                memcpy(out, old, m_size);
+            }
+            if (len > m_size) {
+                memset(out + m_size, 0, len - m_size);
+            }
+        } else if (is_inline()) {
+            m_heap.resize(len);
+            if (m_size) {
+                memcpy(m_heap.data(), m_inline, m_size);
+            }
+        } else {
+            m_heap.resize(len);
+        }
+        m_size = len;
+    }
+
+    void push_back(uint8_t value) {
+        resize(m_size + 1);
+        data()[m_size - 1] = value;
+    }
+
+    void clear() noexcept {
+        m_heap.clear();
+        m_size = 0;
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+    /// \brief true if data is kept inline, without heap allocation
+    bool is_inline() const noexcept {
+        return m_size <= N;
+    }
+    /// \brief Arena keeping data longer than N, nullptr if it's kept in global heap
+    minter::arena *get_arena() const noexcept {
+        return m_arena;
+    }
+
+    uint8_t *data() noexcept {
+        return is_inline() ? m_inline : (m_arena != nullptr ? m_arena_data : m_heap.data());
+    }
+    const uint8_t *data() const noexcept {
+        return is_inline() ? m_inline : (m_arena != nullptr ? m_arena_data : m_heap.data());
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+    iterator end() noexcept {
+        return data() + m_size;
+    }
+    const_iterator begin() const noexcept {
+        return data();
+    }
+    const_iterator end() const noexcept {
+        return data() + m_size;
+    }
+
+    uint8_t &operator[](size_t idx) noexcept {
+        return data()[idx];
+    }
+    uint8_t operator[](size_t idx) const noexcept {
+        return data()[idx];
+    }
+
+    dev::bytesConstRef ref() const noexcept {
+        return dev::bytesConstRef(data(), m_size);
+    }
+    dev::bytes to_bytes() const {
+        return dev::bytes(begin(), end());
+    }
+
+    operator dev::bytesConstRef() const noexcept {
+        return ref();
+    }
+    explicit operator dev::bytes() const {
+        return to_bytes();
+    }
+
+private:
+    void move_from(small_bytes &&other) noexcept {
+        if (other.is_inline() && other.m_size) {
+            memcpy(m_inline, other.m_inline, other.m_size);
+        }
+        m_heap = std::move(other.m_heap);
+        m_arena = other.m_arena;
+        m_arena_data = other.m_arena_data;
+        m_arena_capacity = other.m_arena_capacity;
+        m_size = other.m_size;
+        other.m_heap.clear();
+        other.m_arena_data = nullptr;
+        other.m_arena_capacity = 0;
+        other.m_size = 0;
+    }
+
+    /// \brief Switches storage of long data to arena, current long data is dropped
+    void use_arena(minter::arena *arena) noexcept {
+        if (arena != m_arena) {
+            m_heap.clear();
+            m_arena = arena;
+            m_arena_data = nullptr;
+            m_arena_capacity = 0;
+        }
+    }
+
+    /// \brief Arena buffer of at least len bytes. Previous buffer is not copied and stays valid until arena release
+    uint8_t *reserve_arena(size_t len) {
+        if (len > m_arena_capacity) {
+            // doubled, so appending byte by byte doesn't take new buffer every time
+            const size_t capacity = len > m_arena_capacity * 2 ? len : m_arena_capacity * 2;
+            m_arena_data = (uint8_t *) m_arena->allocate(capacity, 1);
+            m_arena_capacity = capacity;
+        }
+        return m_arena_data;
+    }
+
+    size_t m_size = 0;
+    uint8_t m_inline[N];
+    dev::bytes m_heap;
+    minter::arena *m_arena = nullptr;
+    uint8_t *m_arena_data = nullptr;
+    size_t m_arena_capacity = 0;
+};
+
+template<size_t N>
+constexpr size_t small_bytes<N>::inline_capacity;
+
+template<size_t N, size_t M>
+bool operator==(const small_bytes<N> &lhs, const small_bytes<M> &rhs) noexcept {
+    return lhs.size() == rhs.size() && (lhs.empty() || memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+template<size_t N>
+bool operator==(const small_bytes<N> &lhs, const dev::bytes &rhs) noexcept {
+    return lhs.size() == rhs.size() && (lhs.empty() || memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+template<size_t N>
+bool operator==(const dev::bytes &lhs, const small_bytes<N> &rhs) noexcept {
+    return rhs == lhs;
+}
+template<size_t N, size_t M>
+bool operator!=(const small_bytes<N> &lhs, const small_bytes<M> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+template<size_t N>
+bool operator!=(const small_bytes<N> &lhs, const dev::bytes &rhs) noexcept {
+    return !(lhs == rhs);
+}
+template<size_t N>
+bool operator!=(const dev::bytes &lhs, const small_bytes<N> &rhs) noexcept {
+    return !(rhs == lhs);
+}
+
+}
+
+#endif //MINTER_SMALL_BYTES_H
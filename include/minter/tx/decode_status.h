@@ -0,0 +1,83 @@
+/*!
+ * minter_tx.
+ * decode_status.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_DECODE_STATUS_H
+#define MINTER_DECODE_STATUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <minter/eth/RLP.h>
+
+namespace minter {
+
+enum class decode_error : uint8_t {
+  none = 0,
+  // RLP structure
+  truncated,
+  non_canonical_rlp,
+  oversize,
+  too_deep,
+  // transaction structure
+  list_expected,
+  string_expected,
+  invalid_field_count,
+  non_canonical_int,
+  int_too_big,
+  invalid_length,
+  unknown_type,
+  invalid_data,
+};
+
+/// \brief Result of non-throwing decoding
+struct decode_status {
+  decode_error error = decode_error::none;
+  // offset of the bad item in decoded data
+  size_t offset = 0;
+
+  decode_status() = default;
+  decode_status(decode_error error, size_t offset) : error(error), offset(offset) { }
+
+  bool ok() const {
+      return error == decode_error::none;
+  }
+  explicit operator bool() const {
+      return ok();
+  }
+
+  /// \brief Same status with offset moved by base, to report it relative to enclosing data
+  decode_status shifted(size_t base) const {
+      return ok() ? *this : decode_status(error, offset + base);
+  }
+
+  const char *message() const;
+};
+
+minter::decode_error to_decode_error(dev::RLPError error);
+
+/// \brief Non-throwing check of RLP structure
+minter::decode_status validate_rlp(dev::bytesConstRef data);
+
+/// \brief Keeps decoding error and its offset while decoding items of already validated RLP
+struct decode_context {
+  explicit decode_context(const dev::RLP &root) : base(root.data().data()) { }
+
+  /// \brief Records error at item
+  /// \return false, to return it right away
+  bool fail(minter::decode_error error, const dev::RLP &at) {
+      status = minter::decode_status(error, (size_t) (at.data().data() - base));
+      return false;
+  }
+
+  const uint8_t *base;
+  minter::decode_status status;
+};
+
+}
+
+#endif //MINTER_DECODE_STATUS_H
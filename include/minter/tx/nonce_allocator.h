@@ -0,0 +1,107 @@
+/*!
+ * minter_tx.
+ * nonce_allocator.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_NONCE_ALLOCATOR_H
+#define MINTER_NONCE_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "minter/address.h"
+
+namespace minter {
+
+/// \brief Hands out nonces of one address to concurrent signers, lock-free.
+/// Each nonce is reserved by one signer only. When transaction is sent, its reservation is committed;
+/// when it's abandoned, reservation is released and the nonce is handed out again before fresh ones,
+/// so sequence of used nonces has no gaps. Released nonces wait in a fixed number of slots.
+class nonce_allocator {
+public:
+    /// \brief Reserved nonce. Released on destruction, if not committed
+    class reservation {
+    public:
+        reservation() = default;
+        reservation(const reservation &other) = delete;
+        reservation &operator=(const reservation &other) = delete;
+        reservation(reservation &&other) noexcept;
+        reservation &operator=(reservation &&other) noexcept;
+        ~reservation();
+
+        /// \brief false if reservation is empty, committed or released
+        bool valid() const noexcept;
+        uint64_t nonce() const noexcept;
+
+        /// \brief Marks nonce as used by sent transaction, it won't be handed out again
+        void commit() noexcept;
+        /// \brief Returns nonce to allocator, for abandoned transaction
+        /// \return false if nonce was not returned: it was reserved before resync() or all release slots are busy
+        bool release() noexcept;
+
+    private:
+        friend class nonce_allocator;
+        reservation(nonce_allocator *owner, uint64_t ticket);
+
+        nonce_allocator *m_owner = nullptr;
+        uint64_t m_ticket = 0;
+    };
+
+    /// \param next_nonce first nonce to hand out: nonce of the last transaction on chain + 1
+    /// \param release_slots max released nonces waiting to be handed out again
+    explicit nonce_allocator(uint64_t next_nonce = 1, size_t release_slots = 64);
+    nonce_allocator(const nonce_allocator &other) = delete;
+    nonce_allocator &operator=(const nonce_allocator &other) = delete;
+
+    /// \brief Reserves lowest released nonce, or next fresh one
+    reservation reserve();
+    /// \brief Starts sequence again from known chain value, e.g. after transactions were dropped.
+    /// Released nonces are forgotten, reservations made before are stale: their release() does nothing.
+    /// Resyncs are counted modulo 65536, so a reservation kept alive over 65536 resyncs is not recognized as stale
+    void resync(uint64_t next_nonce);
+
+    /// \brief Next fresh nonce (released ones go before it)
+    uint64_t next() const noexcept;
+    /// \brief Released nonces waiting to be handed out again (including ones being released right now)
+    size_t released() const noexcept;
+
+private:
+    // ticket is a nonce (low bits) with number of resync() calls (high bits, wraps after 65536), so one atomic
+    // increment gives both, and stale tickets are recognized
+    static const unsigned nonce_bits = 48;
+    static const uint64_t nonce_mask = (uint64_t(1) << nonce_bits) - 1;
+
+    bool release(uint64_t ticket) noexcept;
+    bool take_released(uint64_t &ticket) noexcept;
+
+    std::atomic<uint64_t> m_next;
+    // ticket + 1 of released nonce, 0 - empty slot
+    std::unique_ptr<std::atomic<uint64_t>[]> m_slots;
+    size_t m_slots_count;
+    std::atomic<size_t> m_released;
+};
+
+/// \brief Nonce allocators of many addresses. Lookup takes a lock, so signers should keep the returned reference:
+/// allocators live as long as registry
+class nonce_registry {
+public:
+    /// \param next_nonce used only if address has no allocator yet
+    minter::nonce_allocator &get(const minter::address_t &address, uint64_t next_nonce);
+    /// \return nullptr if address has no allocator
+    minter::nonce_allocator *find(const minter::address_t &address);
+
+private:
+    std::mutex m_lock;
+    std::unordered_map<minter::address_t, std::unique_ptr<minter::nonce_allocator>> m_allocators;
+};
+
+}
+
+#endif //MINTER_NONCE_ALLOCATOR_H
@@ -0,0 +1,132 @@
+/*!
+ * minter_tx.
+ * ordered_batches.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_ORDERED_BATCHES_H
+#define MINTER_ORDERED_BATCHES_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace minter {
+
+/// \brief Processes batches on a pool of worker threads and hands them back on the calling thread
+/// in the order they were pushed. At most max_batches are in flight: push() waits for the oldest one
+/// when the limit is reached, so memory is bounded by the limit, not by input size.
+/// Used by stream decoder and multisend planner.
+/// \tparam Batch batch type, is not shared between workers
+template<typename Batch>
+class ordered_batches {
+public:
+    using batch_ptr = std::unique_ptr<Batch>;
+    using work_func = std::function<void(Batch &b)>;
+    using emit_func = std::function<void(const Batch &b)>;
+
+    /// \param threads number of worker threads
+    /// \param max_batches batches in flight, at least 1
+    /// \param work called on worker thread for each batch
+    /// \param emit called on pushing thread for each processed batch, in push order
+    ordered_batches(size_t threads, size_t max_batches, work_func work, emit_func emit) :
+        m_max_batches(max_batches == 0 ? 1 : max_batches),
+        m_work(std::move(work)),
+        m_emit(std::move(emit)) {
+        for (size_t i = 0; i < threads; i++) {
+            m_threads.emplace_back([this] { run(); });
+        }
+    }
+
+    ordered_batches(const ordered_batches &other) = delete;
+    ordered_batches &operator=(const ordered_batches &other) = delete;
+
+    /// \brief Stops workers. Batches which are not emitted yet are dropped
+    ~ordered_batches() {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto &t: m_threads) {
+            t.join();
+        }
+    }
+
+    /// \brief Queues batch, emits oldest one first if max_batches are in flight
+    /// \throws exception of work or emit function for the oldest batch
+    void push(batch_ptr b) {
+        if (m_in_flight.size() >= m_max_batches) {
+            emit_front();
+        }
+        std::promise<void> done;
+        m_in_flight.emplace_back(std::move(b), done.get_future());
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_queue.emplace_back(m_in_flight.back().first.get(), std::move(done));
+        }
+        m_cv.notify_one();
+    }
+
+    /// \brief Waits for and emits all batches in flight
+    /// \throws exception of work or emit function
+    void finish() {
+        while (!m_in_flight.empty()) {
+            emit_front();
+        }
+    }
+
+private:
+    void emit_front() {
+        m_in_flight.front().second.get();
+        m_emit(*m_in_flight.front().first);
+        m_in_flight.pop_front();
+    }
+
+    void run() {
+        for (;;) {
+            std::pair<Batch *, std::promise<void>> item;
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+                m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+                if (m_stop) {
+                    return;
+                }
+                item = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            try {
+                m_work(*item.first);
+                item.second.set_value();
+            } catch (...) {
+                item.second.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    size_t m_max_batches;
+    work_func m_work;
+    emit_func m_emit;
+    // owned by pushing thread only
+    std::deque<std::pair<batch_ptr, std::future<void>>> m_in_flight;
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::deque<std::pair<Batch *, std::promise<void>>> m_queue;
+    bool m_stop = false;
+    std::vector<std::thread> m_threads;
+};
+
+}
+
+#endif //MINTER_ORDERED_BATCHES_H
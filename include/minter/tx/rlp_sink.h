@@ -0,0 +1,73 @@
+/*!
+ * minter_tx.
+ * rlp_sink.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_RLP_SINK_H
+#define MINTER_RLP_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <minter/crypto/sha3.h>
+#include "minter/eth/RLP.h"
+
+namespace minter {
+
+/// \brief Destination of RLP encoder output. Items are passed to write() as they are encoded,
+/// so whole output doesn't have to be built in memory first. List is written as its header and then its items:
+/// header needs payload size, which is computed without encoding (see dev::rlpItemSize() and friends)
+class rlp_sink {
+public:
+    virtual ~rlp_sink() = default;
+    virtual void write(const uint8_t *data, size_t size) = 0;
+
+    /// \brief List header, followed by payload_size bytes of items
+    rlp_sink &append_list(size_t payload_size);
+    /// \brief Same as RLPStream::append()
+    rlp_sink &append(dev::bytesConstRef data);
+    rlp_sink &append(const dev::bigint &value);
+    /// \brief Already encoded RLP, written as is
+    rlp_sink &append_raw(dev::bytesConstRef encoded);
+};
+
+/// \brief Appends output to byte buffer
+class rlp_buffer_sink : public rlp_sink {
+public:
+    explicit rlp_buffer_sink(dev::bytes &out);
+    void write(const uint8_t *data, size_t size) override;
+
+private:
+    dev::bytes &m_out;
+};
+
+/// \brief Hashes output with incremental Keccak-256, result is the same as utils::sha3k() of whole output
+class rlp_hash_sink : public rlp_sink {
+public:
+    rlp_hash_sink();
+    void write(const uint8_t *data, size_t size) override;
+    /// \brief Writes 32 bytes hash to out and starts hashing from scratch
+    void finish(uint8_t *out);
+
+private:
+    SHA3_CTX m_ctx;
+};
+
+/// \brief Writes output to file or any other stream
+class rlp_stream_sink : public rlp_sink {
+public:
+    explicit rlp_stream_sink(std::ostream &out);
+    /// \throws std::runtime_error if stream fails
+    void write(const uint8_t *data, size_t size) override;
+
+private:
+    std::ostream &m_out;
+};
+
+}
+
+#endif //MINTER_RLP_SINK_H
@@ -24,6 +24,12 @@ typedef struct {
   bool success = false;
 } signature;
 
+/// \brief Same as signature, but in fixed arrays, so signing doesn't allocate
+typedef struct {
+  uint8_t r[32], s[32], v[1];
+  bool success = false;
+} fixed_signature;
+
 }
 
 #endif //MINTER_SIGNATURE_H
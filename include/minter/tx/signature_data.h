@@ -20,6 +20,8 @@ namespace minter {
 class signature_data {
 public:
     virtual dev::bytes encode() = 0;
+    /// \brief Exact size of encode() result, computed without encoding
+    virtual size_t encoded_size() const = 0;
     virtual void decode(const dev::RLP &data) = 0;
     virtual ~signature_data() = default;
 };
@@ -38,6 +40,7 @@ public:
     const dev::bytes & get_s() const;
 
     dev::bytes encode() override;
+    size_t encoded_size() const override;
     void decode(const dev::RLP &data) override;
 private:
     dev::bytes m_v, m_r, m_s;
@@ -46,7 +49,11 @@ private:
 class signature_multi_data: public virtual minter::signature_data {
 public:
     signature_multi_data &set_signatures(const minter::data::address &address, std::vector<minter::signature_single_data> &&signs);
+    const minter::data::address &get_address() const;
+    const std::vector<minter::signature_single_data> &get_signs() const;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
+    /// \brief Decodes list of multisig address and signatures list: [address, [[v, r, s], ...]]
     void decode(const dev::RLP &data) override;
 
 private:
@@ -0,0 +1,50 @@
+/*!
+ * minter_tx.
+ * signed_layout.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_SIGNED_LAYOUT_H
+#define MINTER_SIGNED_LAYOUT_H
+
+#include <cstddef>
+#include <minter/eth/RLP.h>
+#include "minter/tx/signature.h"
+
+namespace minter {
+
+/// \brief Buffer of transaction with single signature, signed in place.
+/// Signed and unsigned transactions have the same fields, only list header differs, so fields are written once
+/// at their place in signed transaction. Unsigned list is shorter, its header is put right before fields for hashing,
+/// and after signing it's overwritten by signed list header.
+class single_signed_layout {
+public:
+    /// \brief Encoded signature_single_data: v (1 byte), r and s (32 bytes each)
+    static const size_t signature_size;
+
+    /// \param fields size of encoded transaction fields, without signature
+    explicit single_signed_layout(size_t fields);
+
+    /// \brief Size of signed transaction buffer
+    size_t size() const;
+    /// \brief Offset of fields in buffer
+    size_t fields_offset() const;
+
+    /// \brief Writes unsigned list header before fields
+    /// \return unsigned transaction inside out, to hash for signing
+    dev::bytesConstRef write_unsigned_header(dev::bytesRef out) const;
+    /// \brief Writes signed list header and signature after fields
+    /// \return encoded signature data inside out
+    dev::bytesConstRef write_signature(dev::bytesRef out, const minter::fixed_signature &sig) const;
+
+private:
+    size_t m_fields;
+    size_t m_payload_size;
+};
+
+}
+
+#endif //MINTER_SIGNED_LAYOUT_H
@@ -10,8 +10,12 @@
 #ifndef MINTER_TX_H
 #define MINTER_TX_H
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 #include <secp256k1.h>
 #include <secp256k1_ecdh.h>
 #include <secp256k1_recovery.h>
@@ -20,7 +24,12 @@
 #include "minter/eth/RLP.h"
 #include "minter/eth/vector_ref.h"
 #include "minter/address.h"
+#include "minter/coin_symbol.h"
+#include "minter/hash.h"
+#include "minter/small_bytes.h"
 #include "minter/private_key.h"
+#include "decode_status.h"
+#include "rlp_sink.h"
 #include "signature_data.h"
 #include "signature.h"
 #include "tx_fwd.h"
@@ -35,15 +44,45 @@ typedef enum {
 
 extern const std::unordered_map<std::string, chain_id> chain_id_str_map;
 
+/// \brief What transaction encoder writes
+enum class tx_encoding {
+  // signed transaction, as sign_single() returns it
+  signed_tx,
+  // unsigned data, which hash is signed
+  unsigned_data
+};
+
 class tx_builder;
 
 class tx : public std::enable_shared_from_this<minter::tx> {
     friend class tx_builder;
     friend class tx_data;
+    friend class tx_send_coin_template;
+    friend class value_tx;
 public:
     static std::shared_ptr<minter::tx> create();
     static std::shared_ptr<minter::tx> decode(const char *encodedHex);
     static std::shared_ptr<minter::tx> decode(const dev::bytes &tx);
+    /// \brief Non-throwing decode, for untrusted input
+    /// \param out decoded transaction, set only on success
+    /// \return error and offset of the bad item in data, if any
+    static minter::decode_status try_decode(dev::bytesConstRef data, std::shared_ptr<minter::tx> &out);
+    /// \brief Checks encoded transaction in one pass, without decoding it and without allocations:
+    /// RLP structure, fields count, integers encoding and width of every field, including data of known type
+    /// and signature. decode() and try_decode() do it before creating anything.
+    /// \return error and offset of the bad item in data, if any
+    static minter::decode_status validate(dev::bytesConstRef data);
+    /// \brief Checks signature data as validate() does, without allocations. Unknown signature types are not checked
+    /// \param data encoded signature: payload of the signature field
+    /// \return error and offset of the bad item in data, if any
+    static minter::decode_status validate_signature(uint8_t signature_type, dev::bytesConstRef data);
+    /// \brief Network hash of encoded signed transaction: sha256 of its bytes. Data is not validated
+    static minter::hash_t hash(dev::bytesConstRef encoded);
+    /// \brief Hashes many encoded transactions in parallel, same as hash() for each of them
+    /// \param threads 0 - number of hardware threads; small inputs use fewer threads
+    /// \return hashes in the same order
+    static std::vector<minter::hash_t> hash_batch(const std::vector<dev::bytesConstRef> &encoded, size_t threads = 0);
+    static std::vector<minter::hash_t> hash_batch(const std::vector<dev::bytes> &encoded, size_t threads = 0);
     /// \brief DON'T use it directly, otherwise bad_weak_ptr exception will threw
     tx();
     virtual ~tx() = default;
@@ -51,41 +90,73 @@ public:
     dev::bigint get_nonce() const;
     uint8_t get_chain_id() const;
     dev::bigint get_gas_price() const;
-    std::string get_gas_coin() const;
+    minter::coin_symbol get_gas_coin() const;
     uint16_t get_type() const;
+    /// \brief Typed transaction data. Decoded transaction keeps only encoded data, and typed data is created
+    /// on the first call, once, even if called concurrently
+    /// \return data or nullptr if it has other type
     template<typename T = minter::tx_data>
     std::shared_ptr<T> get_data() const {
-        return std::dynamic_pointer_cast<T>(m_data_raw);
+        return std::dynamic_pointer_cast<T>(get_data_object());
     }
-    const dev::bytes &get_data_raw() const;
-    const dev::bytes &get_payload() const;
-    const dev::bytes &get_service_data() const;
+    const minter::small_bytes<128> &get_data_raw() const;
+    const minter::small_bytes<64> &get_payload() const;
+    const minter::small_bytes<32> &get_service_data() const;
     uint8_t get_signature_type() const;
     template<typename T>
     std::shared_ptr<T> get_signature_data() const {
         return std::dynamic_pointer_cast<T>(m_signature);
     }
 
+    /// \brief Exact size of encoded transaction, computed without encoding
+    /// \param encoding if transaction is not signed yet, size of signed one is computed with single signature
+    /// \return bytes count
+    size_t encoded_size(minter::tx_encoding encoding = minter::tx_encoding::signed_tx) const;
+    /// \brief Encodes transaction straight into sink, in one pass without intermediate buffers
+    /// \throws std::runtime_error if signed transaction is requested, but transaction is not signed
+    void encode_to(minter::rlp_sink &out, minter::tx_encoding encoding = minter::tx_encoding::signed_tx) const;
+
+    /// \brief Network hash of this transaction (Mt...), as hash() of sign_single() result.
+    /// Computed on first call and cached until transaction is signed again or its data is rebuilt
+    /// \throws std::runtime_error if transaction is not signed
+    minter::hash_t get_hash() const;
+
     minter::Data sign_single(const minter::data::private_key &pk);
     minter::Data sign_multiple(const minter::data::address &address, const minter::data::private_key &pk);
 
 protected:
     dev::bytes encode(bool include_signature);
-    minter::signature sign_with_private(const minter::secp256k1_raii &ctx,
-                                        const dev::bytes &hash,
-                                        const dev::bytes &pk);
+    static minter::signature sign_with_private(const minter::secp256k1_raii &ctx,
+                                               const dev::bytes &hash,
+                                               const dev::bytes &pk);
+    /// \brief Same as above, without allocations
+    /// \param hash 32 bytes
+    /// \param pk 32 bytes
+    static minter::fixed_signature sign_with_private(const minter::secp256k1_raii &ctx,
+                                                     const uint8_t *hash,
+                                                     const uint8_t *pk);
     void create_data_from_type();
+    const std::shared_ptr<minter::tx_data> &get_data_object() const;
+    static std::shared_ptr<minter::tx> decode_validated(dev::bytesConstRef data);
+    void reset_hash();
+    size_t payload_size(minter::tx_encoding encoding) const;
 
 private:
     dev::bigint m_nonce;
     dev::bigint m_chain_id;
     dev::bigint m_gas_price;
-    std::string m_gas_coin;
+    minter::coin_symbol m_gas_coin;
     dev::bigint m_type;
-    dev::bytes m_data;
+    minter::small_bytes<128> m_data;
     std::shared_ptr<minter::tx_data> m_data_raw;
-    dev::bytes m_payload;
-    dev::bytes m_service_data;
+    // m_data_raw is not created yet from decoded m_data
+    mutable std::atomic<bool> m_data_pending;
+    // guards lazy creation of m_data_raw and m_hash
+    mutable std::mutex m_data_lock;
+    mutable std::atomic<bool> m_hash_ready;
+    mutable std::array<uint8_t, 32> m_hash;
+    minter::small_bytes<64> m_payload;
+    minter::small_bytes<32> m_service_data;
     dev::bigint m_signature_type;
     std::shared_ptr<minter::signature_data> m_signature;
 };
@@ -15,6 +15,7 @@
 #include <minter/eth/Common.h>
 #include "minter/tx/tx_fwd.h"
 #include "minter/tx/tx.h"
+#include "minter/tx/nonce_allocator.h"
 
 #include "minter/tx/tx_send_coin.h"
 #include "minter/tx/tx_sell_coin.h"
@@ -38,12 +39,15 @@ public:
     ~tx_builder() = default;
     tx_builder &set_nonce(const dev::bigint &num);
     tx_builder &set_nonce(const char *num);
+    /// \brief Uses reserved nonce. Reservation still has to be committed, when transaction is sent
+    tx_builder &set_nonce(const minter::nonce_allocator::reservation &nonce);
     tx_builder &set_chain_id(uint8_t id);
     tx_builder &set_gas_price(const std::string &amountNormalized);
     tx_builder &set_gas_price(const dev::bigdec18 &amountNormalized);
     tx_builder &set_gas_price(const dev::bigint &amount);
     tx_builder &set_gas_coin(const std::string &coin);
     tx_builder &set_gas_coin(const char *coin);
+    tx_builder &set_gas_coin(const minter::coin_symbol &coin);
     tx_builder &set_payload(const dev::bytes &payload);
     tx_builder &set_payload(dev::bytes &&payload);
     tx_builder &set_payload(const std::string &payload);
@@ -71,6 +75,12 @@ public:
     std::shared_ptr<minter::tx_multisend> tx_multisend();
     std::shared_ptr<minter::tx_edit_candidate> tx_edit_candidate();
 
+    /// \brief Creates data of type T, including custom types added to minter::tx_type_registry
+    template<typename T>
+    std::shared_ptr<T> tx_data() {
+        return std::make_shared<T>(m_tx);
+    }
+
 private:
     std::shared_ptr<minter::tx> m_tx;
 };
@@ -11,40 +11,61 @@
 #define MINTER_TX_BUY_COIN_H
 
 #include "tx_data.h"
+#include "tx_schema.h"
 
 namespace minter {
 
 class tx_buy_coin: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_buy_coin(std::shared_ptr<minter::tx> tx);
+    explicit tx_buy_coin(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
-    std::string get_coin_to_buy() const;
+    minter::coin_symbol get_coin_to_buy() const;
     dev::bigdec18 get_value_to_buy() const;
-    std::string get_coin_to_sell() const;
+    minter::coin_symbol get_coin_to_sell() const;
     dev::bigdec18 get_max_value_to_sell() const;
 
     tx_buy_coin& set_coin_to_buy(const char* coin);
+
+    tx_buy_coin& set_coin_to_buy(const minter::coin_symbol &coin);
     tx_buy_coin& set_coin_to_buy(const std::string &coin);
     tx_buy_coin& set_value_to_buy(const char* valueDec);
     tx_buy_coin& set_value_to_buy(const dev::bigdec18 &valueDec);
     tx_buy_coin& set_value_to_buy(const dev::bigint &valueRaw);
     tx_buy_coin& set_coin_to_sell(const char* coin);
+    tx_buy_coin& set_coin_to_sell(const minter::coin_symbol &coin);
     tx_buy_coin& set_coin_to_sell(const std::string &coin);
     tx_buy_coin& set_max_value_to_sell(const char* valueDec);
     tx_buy_coin& set_max_value_to_sell(const dev::bigdec18 &valueDec);
     tx_buy_coin& set_max_value_to_sell(const dev::bigint &value);
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
-    std::string m_coin_to_buy;
+    minter::coin_symbol m_coin_to_buy;
     dev::bigint m_value_to_buy;
-    std::string m_coin_to_sell;
+    minter::coin_symbol m_coin_to_sell;
     dev::bigint m_max_value_to_sell;
 };
 
+template<>
+struct tx_schema<minter::tx_buy_coin> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_buy_coin, minter::coin_symbol, &minter::tx_buy_coin::m_coin_to_buy>,
+      tx_field<minter::tx_buy_coin, dev::bigint, &minter::tx_buy_coin::m_value_to_buy>,
+      tx_field<minter::tx_buy_coin, minter::coin_symbol, &minter::tx_buy_coin::m_coin_to_sell>,
+      tx_field<minter::tx_buy_coin, dev::bigint, &minter::tx_buy_coin::m_max_value_to_sell>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"coin_to_buy", "value_to_buy", "coin_to_sell", "max_value_to_sell"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_BUY_COIN_H
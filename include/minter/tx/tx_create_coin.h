@@ -11,17 +11,21 @@
 #define MINTER_TX_CREATE_COIN_H
 
 #include "tx_data.h"
+#include "tx_schema.h"
 
 namespace minter {
 
 class tx_create_coin: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_create_coin(std::shared_ptr<minter::tx> tx);
+    explicit tx_create_coin(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     tx_create_coin& set_name(const char* coin_name);
     tx_create_coin& set_ticker(const char* coin_symbol);
+    tx_create_coin& set_ticker(const minter::coin_symbol &coin);
     tx_create_coin& set_initial_amount(const char* amount);
     tx_create_coin& set_initial_amount(const dev::bigdec18 &amount);
     tx_create_coin& set_initial_amount(const dev::bigint &amount);
@@ -34,22 +38,38 @@ public:
     tx_create_coin& set_crr(unsigned crr);
 
     std::string get_name() const;
-    std::string get_ticker() const;
+    minter::coin_symbol get_ticker() const;
     dev::bigdec18 get_initial_amount() const;
     dev::bigdec18 get_initial_reserve() const;
     unsigned get_crr() const;
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
     std::string m_name;
-    std::string m_ticker;
+    minter::coin_symbol m_ticker;
     dev::bigint m_initial_amount;
     dev::bigint m_initial_reserve;
     dev::bigint m_crr;
 };
 
+template<>
+struct tx_schema<minter::tx_create_coin> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_create_coin, std::string, &minter::tx_create_coin::m_name>,
+      tx_field<minter::tx_create_coin, minter::coin_symbol, &minter::tx_create_coin::m_ticker>,
+      tx_field<minter::tx_create_coin, dev::bigint, &minter::tx_create_coin::m_initial_amount>,
+      tx_field<minter::tx_create_coin, dev::bigint, &minter::tx_create_coin::m_initial_reserve>,
+      tx_field<minter::tx_create_coin, dev::bigint, &minter::tx_create_coin::m_crr>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"name", "ticker", "initial_amount", "initial_reserve", "crr"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_CREATE_COIN_H
@@ -12,13 +12,16 @@
 
 #include <vector>
 #include "tx_data.h"
+#include "tx_schema.h"
 namespace minter {
 
 class tx_create_multisig_address: public minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_create_multisig_address(std::shared_ptr<minter::tx> tx);
+    explicit tx_create_multisig_address(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     unsigned get_threshold() const;
     const std::vector<dev::bigint>& get_weights() const;
@@ -30,6 +33,7 @@ public:
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
     dev::bigint m_threshold;
@@ -37,6 +41,19 @@ private:
     std::vector<minter::data::address> m_addresses;
 };
 
+template<>
+struct tx_schema<minter::tx_create_multisig_address> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_create_multisig_address, dev::bigint, &minter::tx_create_multisig_address::m_threshold>,
+      tx_field<minter::tx_create_multisig_address, std::vector<dev::bigint>, &minter::tx_create_multisig_address::m_weights>,
+      tx_field<minter::tx_create_multisig_address, std::vector<minter::data::address>, &minter::tx_create_multisig_address::m_addresses>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"threshold", "weights", "addresses"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_CREATE_MULTISIG_ADDRESS_H
@@ -11,18 +11,24 @@
 #define MINTER_TX_DATA_H
 
 #include <memory>
+#include <stdexcept>
 #include "tx.h"
 
 namespace minter {
 
 // Data for concrete transaction
+// Transaction owns its data, data keeps only weak back reference to transaction, so they don't form ownership cycle.
+// Until data is attached to transaction (by build() or tx::decode), data keeps transaction alive itself.
 class tx_data: public std::enable_shared_from_this<minter::tx_data> {
+    friend class tx;
 public:
     tx_data() = default;
-    explicit tx_data(std::shared_ptr<minter::tx> tx) : m_tx(std::move(tx)) { }
+    explicit tx_data(std::shared_ptr<minter::tx> tx) : m_tx_owner(tx), m_tx(tx) { }
     virtual ~tx_data() = default;
     virtual uint16_t type() const = 0;
     virtual dev::bytes encode() = 0;
+    /// \brief Exact size of encode() result, computed without encoding
+    virtual size_t encoded_size() const = 0;
 
     void decode(const char* hexEncoded) {
         minter::Data given(hexEncoded);
@@ -31,23 +37,54 @@ public:
     void decode(const dev::bytes &data) {
         decode_internal(dev::RLP(data));
     }
+    void decode(dev::bytesConstRef data) {
+        decode_internal(dev::RLP(data));
+    }
+    /// \brief Non-throwing decode, for untrusted input. Data may be partially filled on error.
+    /// \return error and offset of the bad item in data, if any
+    minter::decode_status try_decode(dev::bytesConstRef data) {
+        minter::decode_status status = minter::validate_rlp(data);
+        if (!status) {
+            return status;
+        }
+        return try_decode_internal(dev::RLP(data));
+    }
 
+    /// \throws std::runtime_error if transaction has been already built and destroyed
     std::shared_ptr<minter::tx> build() {
-        tx()->m_data = encode();
-        tx()->m_data_raw = shared_from_this();
-        tx()->m_type = type();
+        std::shared_ptr<minter::tx> out = tx();
+        if (!out) {
+            throw std::runtime_error("Transaction has been destroyed, data can't be built again");
+        }
 
-        return tx();
+        out->m_data = encode();
+        out->m_data_raw = shared_from_this();
+        out->m_type = type();
+        out->reset_hash();
+        m_tx_owner.reset();
+
+        return out;
     }
 
 protected:
     virtual void decode_internal(dev::RLP rlp) {};
+    /// \brief Decodes RLP with already validated structure, must not throw
+    virtual minter::decode_status try_decode_internal(const dev::RLP &rlp) {
+        // fallback for types without own non-throwing decoder
+        try {
+            decode_internal(rlp);
+        } catch (const std::exception &) {
+            return minter::decode_status(minter::decode_error::invalid_data, 0);
+        }
+        return minter::decode_status();
+    }
 
     std::shared_ptr<minter::tx> tx() {
-        return m_tx;
+        return m_tx.lock();
     }
 private:
-    std::shared_ptr<minter::tx> m_tx;
+    std::shared_ptr<minter::tx> m_tx_owner;
+    std::weak_ptr<minter::tx> m_tx;
 };
 
 
@@ -11,15 +11,18 @@
 #define MINTER_TX_DECLARE_CANDIDACY_H
 
 #include "tx_data.h"
+#include "tx_schema.h"
 #include "minter/public_key.h"
 
 namespace minter {
 
 class tx_declare_candidacy: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_declare_candidacy(std::shared_ptr<minter::tx> tx);
+    explicit tx_declare_candidacy(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
 
     tx_declare_candidacy& set_address(const minter::data::address &address);
@@ -30,27 +33,44 @@ public:
     /// \return
     tx_declare_candidacy& set_commission(unsigned commission);
     tx_declare_candidacy& set_coin(const char* coin);
+    tx_declare_candidacy& set_coin(const minter::coin_symbol &coin);
     tx_declare_candidacy& set_stake(const char* amount);
     tx_declare_candidacy& set_stake(const dev::bigdec18 &amount);
 
     const minter::data::address& get_address() const;
-    const minter::pubkey_t& get_pub_key() const;
+    minter::pubkey_t get_pub_key() const;
     unsigned get_commission() const;
-    std::string get_coin() const;
+    minter::coin_symbol get_coin() const;
     dev::bigdec18 get_stake() const;
 
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
     minter::data::address m_address;
-    minter::pubkey_t m_pub_key;
+    minter::small_bytes<32> m_pub_key;
     dev::bigint m_commission;
-    std::string m_coin;
+    minter::coin_symbol m_coin;
     dev::bigint m_stake;
 };
 
+template<>
+struct tx_schema<minter::tx_declare_candidacy> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_declare_candidacy, minter::data::address, &minter::tx_declare_candidacy::m_address>,
+      tx_field<minter::tx_declare_candidacy, minter::small_bytes<32>, &minter::tx_declare_candidacy::m_pub_key>,
+      tx_field<minter::tx_declare_candidacy, dev::bigint, &minter::tx_declare_candidacy::m_commission>,
+      tx_field<minter::tx_declare_candidacy, minter::coin_symbol, &minter::tx_declare_candidacy::m_coin>,
+      tx_field<minter::tx_declare_candidacy, dev::bigint, &minter::tx_declare_candidacy::m_stake>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"address", "pub_key", "commission", "coin", "stake"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_DECLARE_CANDIDACY_H
@@ -13,34 +13,52 @@
 #include <string>
 #include "minter/public_key.h"
 #include "tx_data.h"
+#include "tx_schema.h"
 namespace minter {
 
 class tx_delegate: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_delegate(std::shared_ptr<minter::tx> tx);
+    explicit tx_delegate(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     tx_delegate& set_pub_key(const dev::bytes &pub_key);
     tx_delegate& set_pub_key(const minter::pubkey_t &pub_key);
     tx_delegate& set_coin(const char* coin);
+    tx_delegate& set_coin(const minter::coin_symbol &coin);
     tx_delegate& set_coin(const std::string &coin);
     tx_delegate& set_stake(const char* amount);
     tx_delegate& set_stake(const dev::bigdec18 &amount);
 
-    const minter::pubkey_t& get_pub_key() const;
-    std::string get_coin() const;
+    minter::pubkey_t get_pub_key() const;
+    minter::coin_symbol get_coin() const;
     dev::bigdec18 get_stake() const;
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
-    minter::pubkey_t m_pub_key;
-    std::string m_coin;
+    minter::small_bytes<32> m_pub_key;
+    minter::coin_symbol m_coin;
     dev::bigint m_stake;
 };
 
+template<>
+struct tx_schema<minter::tx_delegate> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_delegate, minter::small_bytes<32>, &minter::tx_delegate::m_pub_key>,
+      tx_field<minter::tx_delegate, minter::coin_symbol, &minter::tx_delegate::m_coin>,
+      tx_field<minter::tx_delegate, dev::bigint, &minter::tx_delegate::m_stake>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"pub_key", "coin", "stake"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_DELEGATE_H
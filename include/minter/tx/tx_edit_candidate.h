@@ -11,34 +11,51 @@
 #define MINTER_TX_EDIT_CANDIDATE_H
 
 #include "tx_data.h"
+#include "tx_schema.h"
 #include "minter/public_key.h"
 
 namespace minter {
 
 class tx_edit_candidate: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_edit_candidate(std::shared_ptr<minter::tx> tx);
+    explicit tx_edit_candidate(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     tx_edit_candidate& set_pub_key(const minter::pubkey_t &pub_key);
     tx_edit_candidate& set_pub_key(const dev::bytes &pub_key);
     tx_edit_candidate& set_reward_address(const minter::data::address &address);
     tx_edit_candidate& set_owner_address(const minter::data::address &address);
 
-    const minter::pubkey_t& get_pub_key() const;
+    minter::pubkey_t get_pub_key() const;
     const minter::data::address get_reward_address() const;
     const minter::data::address get_owner_address() const;
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
-    minter::pubkey_t m_pub_key;
+    minter::small_bytes<32> m_pub_key;
     minter::data::address m_reward_address;
     minter::data::address m_owner_address;
 };
 
+template<>
+struct tx_schema<minter::tx_edit_candidate> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_edit_candidate, minter::small_bytes<32>, &minter::tx_edit_candidate::m_pub_key>,
+      tx_field<minter::tx_edit_candidate, minter::data::address, &minter::tx_edit_candidate::m_reward_address>,
+      tx_field<minter::tx_edit_candidate, minter::data::address, &minter::tx_edit_candidate::m_owner_address>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"pub_key", "reward_address", "owner_address"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_EDIT_CANDIDATE_H
@@ -10,14 +10,18 @@
 #ifndef MINTER_TX_MULTISEND_H
 #define MINTER_TX_MULTISEND_H
 
+#include <cstddef>
+#include <iterator>
 #include <vector>
+#include "minter/arena.h"
 #include "tx_send_coin.h"
 #include "tx_data.h"
+#include "tx_schema.h"
 #include "minter/tx/utils.h"
 namespace minter {
 
     struct send_target {
-        std::string coin;
+        minter::coin_symbol coin;
         minter::data::address to;
         dev::bigint amount;
 
@@ -26,22 +30,180 @@ namespace minter {
         }
     };
 
+/// \brief Multisend items stored as arrays: null-padded coins, addresses and 256-bit big-endian amounts,
+/// each item at fixed offset. Adding or decoding an item doesn't allocate, except when arrays grow.
+/// operator[] and iteration give send_target copies; coin(), to() and amount_bytes() read in place.
+/// Arrays can be kept in arena, which follows them on copy and move.
+class send_target_list {
+public:
+    static constexpr size_t coin_size = minter::coin_symbol::max_length;
+    static constexpr size_t address_size = 20;
+    static constexpr size_t amount_size = 32;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = minter::send_target;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = minter::send_target;
+
+        const_iterator(const send_target_list *list, size_t pos) : m_list(list), m_pos(pos) { }
+        minter::send_target operator*() const {
+            return (*m_list)[m_pos];
+        }
+        const_iterator &operator++() {
+            m_pos++;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator out = *this;
+            m_pos++;
+            return out;
+        }
+        bool operator==(const const_iterator &other) const {
+            return m_pos == other.m_pos && m_list == other.m_list;
+        }
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const send_target_list *m_list;
+        size_t m_pos;
+    };
+
+    send_target_list() = default;
+    /// \brief Empty list keeping its arrays in arena. Arena must outlive the list
+    explicit send_target_list(minter::arena *arena);
+    /// \brief Copy of other keeping its arrays in arena
+    send_target_list(const send_target_list &other, minter::arena *arena);
+
+    /// \brief Arena keeping arrays, nullptr if they are in global heap
+    minter::arena *get_arena() const noexcept;
+
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+    void reserve(size_t count);
+    void clear() noexcept;
+    /// \throws std::runtime_error if amount is negative or doesn't fit in 256 bits
+    void push_back(const minter::coin_symbol &coin, const minter::data::address &to, const dev::bigint &amount);
+
+    minter::send_target operator[](size_t i) const;
+    minter::send_target front() const;
+    minter::send_target back() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    std::vector<minter::send_target> to_vector() const;
+
+    minter::coin_symbol coin(size_t i) const;
+    /// \brief Coin padded with null bytes, as it's encoded
+    dev::bytesConstRef coin_bytes(size_t i) const;
+    dev::bytesConstRef to(size_t i) const;
+    dev::bigint amount(size_t i) const;
+    /// \brief Amount without leading zero bytes, as it's encoded
+    dev::bytesConstRef amount_bytes(size_t i) const;
+
+private:
+    friend struct rlp_codec<send_target_list>;
+
+    /// \brief Appends item of encoded values, without checks: sizes are checked by codec
+    /// \param coin at most coin_size bytes
+    /// \param to address_size bytes
+    /// \param amount big-endian, at most amount_size bytes
+    void push_encoded(dev::bytesConstRef coin, dev::bytesConstRef to, dev::bytesConstRef amount);
+
+    using byte_array = std::vector<uint8_t, minter::arena_allocator<uint8_t>>;
+
+    byte_array m_coins;
+    byte_array m_addresses;
+    byte_array m_amounts;
+    // significant bytes of each amount, which is right-aligned in its slot
+    byte_array m_amount_sizes;
+};
+
 class tx_multisend: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_multisend(std::shared_ptr<minter::tx> tx);
+    explicit tx_multisend(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     tx_multisend& add_item(const char* coin, const minter::data::address &to, const char* amount);
     tx_multisend& add_item(const char* coin, const minter::data::address &to, const dev::bigdec18 &amount);
+    tx_multisend& add_item(const minter::coin_symbol &coin, const minter::data::address &to, const dev::bigint &amount);
 
-    const std::vector<minter::send_target>& get_items() const;
+    const minter::send_target_list& get_items() const;
+    /// \brief Keeps items in arena instead of global heap, items added before are copied there.
+    /// Arena must outlive this object
+    void set_arena(minter::arena *arena);
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
-    std::vector<send_target> m_items;
+    minter::send_target_list m_items;
+};
+
+template<>
+struct tx_schema<minter::send_target> {
+  using fields = tx_field_list<
+      tx_field<minter::send_target, minter::coin_symbol, &minter::send_target::coin>,
+      tx_field<minter::send_target, minter::data::address, &minter::send_target::to>,
+      tx_field<minter::send_target, dev::bigint, &minter::send_target::amount>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"coin", "to", "amount"};
+      return out;
+  }
+};
+
+/// \brief Items list is encoded and decoded in one pass over arrays, without building send_target objects.
+/// Items are read by walking RLP headers in place, instead of creating dev::RLP for every field
+template<>
+struct rlp_codec<minter::send_target_list> {
+  static size_t item_payload_size(const minter::send_target_list &value, size_t i) {
+      return dev::rlpDataSize(minter::send_target_list::coin_size)
+          + dev::rlpDataSize(minter::send_target_list::address_size)
+          + dev::rlpItemSize(value.amount_bytes(i));
+  }
+  static size_t payload_size(const minter::send_target_list &value) {
+      size_t out = 0;
+      for (size_t i = 0; i < value.size(); i++) {
+          out += dev::rlpListSize(item_payload_size(value, i));
+      }
+      return out;
+  }
+  static size_t size(const minter::send_target_list &value) {
+      return dev::rlpListSize(payload_size(value));
+  }
+  static size_t write(uint8_t *out, const minter::send_target_list &value) {
+      uint8_t *p = out;
+      p += dev::rlpWriteHeader(p, payload_size(value), true);
+      for (size_t i = 0; i < value.size(); i++) {
+          p += dev::rlpWriteHeader(p, item_payload_size(value, i), true);
+          p += dev::rlpWriteItem(p, value.coin_bytes(i));
+          p += dev::rlpWriteItem(p, value.to(i));
+          p += dev::rlpWriteItem(p, value.amount_bytes(i));
+      }
+      return (size_t) (p - out);
+  }
+  static void read(const dev::RLP &rlp, minter::send_target_list &value);
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx);
+  static bool try_read(const dev::RLP &rlp, minter::send_target_list &value, minter::decode_context &ctx);
+};
+
+template<>
+struct tx_schema<minter::tx_multisend> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_multisend, minter::send_target_list, &minter::tx_multisend::m_items>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"items"};
+      return out;
+  }
 };
 
 }
@@ -0,0 +1,99 @@
+/*!
+ * minter_tx.
+ * tx_multisend_planner.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TX_MULTISEND_PLANNER_H
+#define MINTER_TX_MULTISEND_PLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+#include <minter/bip39/utils.h>
+#include "minter/coin_symbol.h"
+#include "minter/private_key.h"
+#include "minter/tx/tx_multisend.h"
+
+namespace minter {
+
+/// \brief Signed multisend transaction made by planner
+struct planned_multisend {
+  uint64_t nonce = 0;
+  // index of first row of the transaction, rows are counted from 0, empty and comment lines are not counted
+  size_t first_row = 0;
+  size_t items = 0;
+  // fee in base coin pips, see tx_multisend_planner::fee()
+  dev::bigint fee;
+  minter::Data data;
+};
+
+struct tx_multisend_plan_stats {
+  size_t rows = 0;
+  size_t txs = 0;
+  dev::bigint fee;
+  // output bytes written by plan_file()
+  size_t bytes = 0;
+  double seconds = 0;
+
+  double rows_per_second() const {
+      return seconds > 0 ? rows / seconds : 0;
+  }
+};
+
+/// \brief Splits a list of payouts into signed multisend transactions with sequential nonces.
+/// Rows are text lines "coin,address,amount", amount is in coins ("1.5"), lines starting with '#' are skipped.
+/// Input is read in batches of rows, which are parsed, built and signed in parallel, and passed to callback
+/// in input order on the calling thread. Memory is bounded by the number of batches in flight, so lists of
+/// any size can be planned.
+class tx_multisend_planner {
+public:
+    using callback = std::function<void(const minter::planned_multisend &tx)>;
+
+    struct options {
+      // network limit of items per multisend
+      size_t max_items = 100;
+      // 0 - number of hardware threads
+      size_t threads = 0;
+      // transactions per batch, built by one worker
+      size_t batch_txs = 64;
+      // batches being built or waiting for callback; 0 - twice the threads count
+      size_t max_batches = 0;
+
+      uint8_t chain_id = minter::mainnet;
+      dev::bigint gas_price = 1;
+      minter::coin_symbol gas_coin = "BIP";
+      dev::bytes payload;
+    };
+
+    /// \param first_nonce nonce of the first transaction: nonce of the last transaction on chain + 1
+    tx_multisend_planner(const minter::data::private_key &pk, uint64_t first_nonce, const options &opts);
+    tx_multisend_planner(const minter::data::private_key &pk, uint64_t first_nonce);
+
+    /// \brief Plans all rows of stream
+    /// \throws std::runtime_error with row number if row is invalid; exceptions of callback are rethrown
+    minter::tx_multisend_plan_stats plan(std::istream &rows, const callback &on_tx);
+    /// \brief Plans all rows of file and writes signed transactions to output file, hex encoded, one per line
+    /// (as tx_stream_decoder reads them)
+    minter::tx_multisend_plan_stats plan_file(const std::string &rows_path, const std::string &out_path);
+
+    /// \brief Exact fee of multisend, as minter::get_multisend_fee() computes it, in pips
+    static dev::bigint fee(size_t items, size_t payload_size, const dev::bigint &gas_price);
+    /// \brief Parses "coin,address,amount" row, spaces around fields are ignored
+    /// \throws std::runtime_error if row is invalid
+    static minter::send_target parse_row(const char *row, size_t size);
+
+private:
+    const minter::data::private_key m_pk;
+    const uint64_t m_first_nonce;
+    options m_opts;
+};
+
+}
+
+#endif //MINTER_TX_MULTISEND_PLANNER_H
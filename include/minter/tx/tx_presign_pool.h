@@ -0,0 +1,115 @@
+/*!
+ * minter_tx.
+ * tx_presign_pool.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TX_PRESIGN_POOL_H
+#define MINTER_TX_PRESIGN_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <minter/bip39/utils.h>
+#include "minter/private_key.h"
+#include "minter/tx/tx.h"
+
+namespace minter {
+
+/// \brief Signs transactions of one address ahead of time, on background threads.
+/// Template is a function, which builds transaction for given nonce (with tx_builder), everything except nonce
+/// must be known in advance. For each template, transactions for the next `depth` nonces are built and signed
+/// by sign_single(), so request path only takes ready bytes. Taking a transaction consumes its nonce:
+/// transactions of other templates for this nonce are dropped, and all of them are signed for upcoming nonces.
+class tx_presign_pool {
+public:
+    using tx_factory = std::function<std::shared_ptr<minter::tx>(const dev::bigint &nonce)>;
+
+    struct options {
+      // signed transactions kept ready per template
+      size_t depth = 4;
+      // signing threads
+      size_t threads = 1;
+    };
+
+    struct signed_tx {
+      uint64_t nonce = 0;
+      minter::Data data;
+    };
+
+    /// \param next_nonce first nonce to sign for: nonce of the last transaction on chain + 1
+    tx_presign_pool(const minter::data::private_key &pk, uint64_t next_nonce, const options &opts);
+    tx_presign_pool(const minter::data::private_key &pk, uint64_t next_nonce);
+    tx_presign_pool(const tx_presign_pool &other) = delete;
+    tx_presign_pool &operator=(const tx_presign_pool &other) = delete;
+    /// \brief Stops signing threads, waiting for transactions being signed
+    ~tx_presign_pool();
+
+    /// \brief Adds template, signing for it starts right away
+    /// \return template id for take()
+    size_t add_template(tx_factory factory);
+
+    /// \brief Takes ready transaction of template for the next nonce, and consumes the nonce
+    /// \return false if it's not signed yet, nothing is consumed then
+    /// \throws std::runtime_error if template id is unknown; rethrows exception of template function
+    bool try_take(size_t template_id, signed_tx &out);
+    /// \brief Takes ready transaction, or builds and signs it on calling thread, if it's not ready.
+    /// If template function or signing throws, nonce is not consumed (unless next nonces were taken meanwhile)
+    signed_tx take(size_t template_id);
+
+    /// \brief Sets next nonce, when nonces were consumed elsewhere (or transactions were dropped).
+    /// Transactions signed for other nonces are dropped
+    void invalidate(uint64_t next_nonce);
+    /// \brief Waits until all `depth` transactions of template are signed
+    /// \return false on timeout
+    bool wait_ready(size_t template_id, std::chrono::milliseconds timeout);
+
+    uint64_t next_nonce() const;
+    /// \brief Signed transactions of template ready to take
+    size_t ready(size_t template_id) const;
+
+private:
+    struct entry {
+      tx_factory factory;
+      // nonce => signed transaction
+      std::map<uint64_t, minter::Data> ready;
+      // last exception of factory, signing of template is paused until it's rethrown by take()
+      std::exception_ptr error;
+    };
+
+    void run();
+    // under lock
+    bool next_job(size_t &template_id, uint64_t &nonce);
+    entry &get_entry(size_t template_id) const;
+    void consume(uint64_t nonce);
+    signed_tx sign(const tx_factory &factory, uint64_t nonce) const;
+
+    const minter::data::private_key m_pk;
+    const options m_opts;
+    mutable std::mutex m_lock;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_ready_cv;
+    uint64_t m_next;
+    std::vector<std::unique_ptr<entry>> m_templates;
+    // template id and nonce being signed
+    std::set<std::pair<size_t, uint64_t>> m_in_progress;
+    bool m_stop = false;
+    std::vector<std::thread> m_threads;
+};
+
+}
+
+#endif //MINTER_TX_PRESIGN_POOL_H
@@ -0,0 +1,76 @@
+/*!
+ * minter_tx.
+ * tx_projection.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TX_PROJECTION_H
+#define MINTER_TX_PROJECTION_H
+
+#include <cstdint>
+#include <minter/eth/RLP.h>
+#include "minter/coin_symbol.h"
+#include "minter/tx/decode_status.h"
+
+namespace minter {
+
+/// \brief Bits of transaction fields, for tx_projection::decode() mask
+struct tx_field_mask {
+  enum : uint32_t {
+    nonce = 1u << 0,
+    chain_id = 1u << 1,
+    gas_price = 1u << 2,
+    gas_coin = 1u << 3,
+    type = 1u << 4,
+    data = 1u << 5,
+    payload = 1u << 6,
+    service_data = 1u << 7,
+    signature_type = 1u << 8,
+    signature = 1u << 9,
+    // not a transaction field: recipient address from data of send transaction
+    recipient = 1u << 10,
+
+    header = nonce | chain_id | gas_price | gas_coin | type,
+  };
+};
+
+/// \brief Selected fields of encoded transaction. Items are walked by their headers only, and walking stops
+/// after the last requested field, so fields which were not requested are neither decoded nor validated.
+/// Byte fields are references into encoded buffer, so it must outlive the projection.
+struct tx_projection {
+  /// \brief Extracts fields of mask (combination of tx_field_mask bits) from encoded transaction. Never throws or allocates.
+  /// \param out projection, reset before decoding
+  /// \return error and offset of the bad item in encoded data, if any
+  static minter::decode_status decode(dev::bytesConstRef encoded, uint32_t mask, tx_projection &out);
+
+  /// \brief Whether field bit(s) have been extracted. Recipient is absent if transaction is not a send
+  bool has(uint32_t mask) const {
+      return (fields & mask) == mask;
+  }
+
+  // extracted fields, combination of tx_field_mask bits
+  uint32_t fields = 0;
+
+  uint64_t nonce = 0;
+  uint8_t chain_id = 0;
+  // big-endian
+  dev::bytesConstRef gas_price;
+  minter::coin_symbol gas_coin;
+  uint16_t type = 0;
+  // encoded data list
+  dev::bytesConstRef data;
+  dev::bytesConstRef payload;
+  dev::bytesConstRef service_data;
+  uint8_t signature_type = 0;
+  // encoded signature
+  dev::bytesConstRef signature;
+  // 20 bytes
+  dev::bytesConstRef recipient;
+};
+
+}
+
+#endif //MINTER_TX_PROJECTION_H
@@ -11,28 +11,44 @@
 #define MINTER_TX_REDEEM_CHECK_H
 
 #include "tx_data.h"
+#include "tx_schema.h"
 namespace minter {
 
 static const uint32_t PROOF_LEN = 65;
 
 class tx_redeem_check: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_redeem_check(std::shared_ptr<minter::tx> tx);
+    explicit tx_redeem_check(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     tx_redeem_check& set_check(const dev::bytes &data);
     tx_redeem_check& set_proof(const dev::bytes &data);
 
-    const dev::bytes get_check() const;
-    const dev::bytes get_proof() const;
+    const minter::small_bytes<256> &get_check() const;
+    const minter::small_bytes<PROOF_LEN> &get_proof() const;
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
-    dev::bytes m_check;
-    dev::bytes m_proof;
+    minter::small_bytes<256> m_check;
+    minter::small_bytes<PROOF_LEN> m_proof;
+};
+
+template<>
+struct tx_schema<minter::tx_redeem_check> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_redeem_check, minter::small_bytes<256>, &minter::tx_redeem_check::m_check>,
+      tx_field<minter::tx_redeem_check, minter::small_bytes<minter::PROOF_LEN>, &minter::tx_redeem_check::m_proof>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"check", "proof"};
+      return out;
+  }
 };
 
 }
@@ -0,0 +1,477 @@
+/*!
+ * minter_tx.
+ * tx_schema.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TX_SCHEMA_H
+#define MINTER_TX_SCHEMA_H
+
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "minter/eth/RLP.h"
+#include "minter/address.h"
+#include "minter/coin_symbol.h"
+#include "minter/small_bytes.h"
+#include "decode_status.h"
+#include "tx_fwd.h"
+
+namespace minter {
+
+/// \brief RLP encoding of a single field value: exact size, direct write into buffer and read back.
+/// check() verifies item kind and value width of already validated RLP structure, without reading the value,
+/// so it never allocates. try_read() is a non-throwing read: check() followed by read().
+/// Specialized for every field type used in transactions, and for any type having tx_schema (nested list).
+template<typename T, typename = void>
+struct rlp_codec;
+
+/// \brief Describes RLP encoded field of type Type, stored in Owner::*Member
+template<typename Owner, typename Type, Type Owner::*Member>
+struct tx_field {
+  using owner_type = Owner;
+  using value_type = Type;
+  using codec = rlp_codec<Type>;
+
+  static const Type &get(const Owner &owner) {
+      return owner.*Member;
+  }
+  static Type &get(Owner &owner) {
+      return owner.*Member;
+  }
+};
+
+/// \brief Ordered list of fields, as they go in encoded list
+template<typename... Fields>
+struct tx_field_list {
+  static constexpr size_t size = sizeof...(Fields);
+
+  template<typename T>
+  static size_t payload_size(const T &obj) {
+      size_t out = 0;
+      (void) std::initializer_list<int>{0, (out += Fields::codec::size(Fields::get(obj)), 0)...};
+      return out;
+  }
+
+  template<typename T>
+  static size_t write(uint8_t *out, const T &obj) {
+      uint8_t *p = out;
+      (void) std::initializer_list<int>{0, (p += Fields::codec::write(p, Fields::get(obj)), 0)...};
+      return (size_t) (p - out);
+  }
+
+  template<typename T>
+  static void read(const dev::RLP &rlp, T &obj) {
+      auto it = rlp.begin();
+      const auto end = rlp.end();
+      (void) std::initializer_list<int>{0, (read_one<Fields>(it, end, obj), 0)...};
+  }
+
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx) {
+      if (!check_list(rlp, ctx)) {
+          return false;
+      }
+
+      auto it = rlp.begin();
+      bool ok = true;
+      (void) std::initializer_list<int>{0, (ok = ok && Fields::codec::check(*it++, ctx), 0)...};
+      return ok;
+  }
+
+  template<typename T>
+  static bool try_read(const dev::RLP &rlp, T &obj, minter::decode_context &ctx) {
+      if (!check_list(rlp, ctx)) {
+          return false;
+      }
+
+      auto it = rlp.begin();
+      bool ok = true;
+      (void) std::initializer_list<int>{0, (ok = ok && Fields::codec::try_read(*it++, Fields::get(obj), ctx), 0)...};
+      return ok;
+  }
+
+  template<typename T, typename Visitor>
+  static void visit(const T &obj, const char *const *names, Visitor &&visitor) {
+      size_t i = 0;
+      (void) std::initializer_list<int>{0, (visitor(names[i++], Fields::get(obj)), 0)...};
+  }
+
+private:
+  static bool check_list(const dev::RLP &rlp, minter::decode_context &ctx) {
+      if (!rlp.isList()) {
+          return ctx.fail(minter::decode_error::list_expected, rlp);
+      }
+      // counted while walking, without building items index
+      size_t count = 0;
+      for (auto it = rlp.begin(); it != rlp.end() && count <= size; ++it) {
+          count++;
+      }
+      if (count != size) {
+          return ctx.fail(minter::decode_error::invalid_field_count, rlp);
+      }
+      return true;
+  }
+
+  template<typename Field, typename T>
+  static void read_one(dev::RLP::iterator &it, const dev::RLP::iterator &end, T &obj) {
+      // missing trailing items are read as empty ones, like RLP::operator[] does
+      if (it == end) {
+          Field::codec::read(dev::RLP(), Field::get(obj));
+          return;
+      }
+      Field::codec::read(*it, Field::get(obj));
+      ++it;
+  }
+};
+
+template<typename... Fields>
+constexpr size_t tx_field_list<Fields...>::size;
+
+/// \brief Field schema of type T. Specialization must define:
+///  - fields: tx_field_list of T fields, in encoding order
+///  - names(): array of fields names, used by schema_visit()
+/// Specialization have to be a friend of T to reference private members.
+template<typename T>
+struct tx_schema;
+
+namespace schema_detail {
+template<typename... Ts>
+struct make_void {
+  using type = void;
+};
+}
+
+/// \brief Size of encoded list of T fields, without list header
+template<typename T>
+size_t schema_payload_size(const T &obj) {
+    return minter::tx_schema<T>::fields::payload_size(obj);
+}
+
+/// \brief Exact size of schema_encode() result
+template<typename T>
+size_t schema_encoded_size(const T &obj) {
+    return dev::rlpListSize(schema_payload_size(obj));
+}
+
+/// \brief Writes encoded list of T fields into out, which must have at least schema_encoded_size(obj) bytes
+/// \return written bytes count
+template<typename T>
+size_t schema_write(uint8_t *out, const T &obj) {
+    const size_t payload = schema_payload_size(obj);
+    const size_t header = dev::rlpWriteHeader(out, payload, true);
+    return header + minter::tx_schema<T>::fields::write(out + header, obj);
+}
+
+/// \brief Encodes T fields as RLP list, allocating output only once
+template<typename T>
+dev::bytes schema_encode(const T &obj) {
+    dev::bytes out(schema_encoded_size(obj));
+    schema_write(out.data(), obj);
+    return out;
+}
+
+/// \brief Reads T fields from RLP list, in one pass over its items
+template<typename T>
+void schema_decode(T &obj, const dev::RLP &rlp) {
+    minter::tx_schema<T>::fields::read(rlp, obj);
+}
+
+/// \brief Non-throwing read of T fields from RLP with already validated structure
+/// \return false on error, which is recorded in ctx
+template<typename T>
+bool schema_try_read(T &obj, const dev::RLP &rlp, minter::decode_context &ctx) {
+    return minter::tx_schema<T>::fields::try_read(rlp, obj, ctx);
+}
+
+/// \brief Checks that RLP with already validated structure holds valid T fields, without decoding them
+/// \return false on error, which is recorded in ctx
+template<typename T>
+bool schema_check(const dev::RLP &rlp, minter::decode_context &ctx) {
+    return minter::tx_schema<T>::fields::check(rlp, ctx);
+}
+
+/// \brief Checks that untrusted data holds valid encoded T, in one pass and without allocations
+template<typename T>
+minter::decode_status schema_validate(dev::bytesConstRef data) {
+    minter::decode_status status = minter::validate_rlp(data);
+    if (!status) {
+        return status;
+    }
+    dev::RLP rlp(data);
+    minter::decode_context ctx(rlp);
+    schema_check<T>(rlp, ctx);
+    return ctx.status;
+}
+
+namespace schema_detail {
+using validate_func = minter::decode_status (*)(dev::bytesConstRef);
+
+/// \brief schema_validate<T> if T has schema, nullptr otherwise
+template<typename T, typename = void>
+struct validator {
+  static validate_func get() {
+      return nullptr;
+  }
+};
+template<typename T>
+struct validator<T, typename make_void<typename minter::tx_schema<T>::fields>::type> {
+  static validate_func get() {
+      return &minter::schema_validate<T>;
+  }
+};
+}
+
+/// \brief Non-throwing decode of T fields from RLP with already validated structure
+template<typename T>
+minter::decode_status schema_try_decode(T &obj, const dev::RLP &rlp) {
+    minter::decode_context ctx(rlp);
+    schema_try_read(obj, rlp, ctx);
+    return ctx.status;
+}
+
+/// \brief Non-throwing decode of T fields from untrusted data
+template<typename T>
+minter::decode_status schema_try_decode(T &obj, dev::bytesConstRef data) {
+    minter::decode_status status = minter::validate_rlp(data);
+    if (!status) {
+        return status;
+    }
+    return schema_try_decode(obj, dev::RLP(data));
+}
+
+/// \brief Calls visitor(const char *name, const FieldType &value) for every field of T
+template<typename T, typename Visitor>
+void schema_visit(const T &obj, Visitor &&visitor) {
+    minter::tx_schema<T>::fields::visit(obj, minter::tx_schema<T>::names(), std::forward<Visitor>(visitor));
+}
+
+template<>
+struct rlp_codec<dev::bigint> {
+  static size_t size(const dev::bigint &value) {
+      return dev::rlpItemSize(value);
+  }
+  static size_t write(uint8_t *out, const dev::bigint &value) {
+      return dev::rlpWriteItem(out, value);
+  }
+  static void read(const dev::RLP &rlp, dev::bigint &value) {
+      value = (dev::bigint) rlp;
+  }
+  // values are 256-bit at most
+  static const size_t max_size = 32;
+
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx) {
+      if (!rlp.isData()) {
+          return ctx.fail(minter::decode_error::string_expected, rlp);
+      }
+      if (rlp.size() > 0 && rlp.payload()[0] == 0) {
+          return ctx.fail(minter::decode_error::non_canonical_int, rlp);
+      }
+      if (rlp.size() > max_size) {
+          return ctx.fail(minter::decode_error::int_too_big, rlp);
+      }
+      return true;
+  }
+  static bool try_read(const dev::RLP &rlp, dev::bigint &value, minter::decode_context &ctx) {
+      if (!check(rlp, ctx)) {
+          return false;
+      }
+      read(rlp, value);
+      return true;
+  }
+};
+
+template<>
+struct rlp_codec<minter::coin_symbol> {
+  static size_t size(const minter::coin_symbol &) {
+      return dev::rlpDataSize(minter::coin_symbol::max_length);
+  }
+  static size_t write(uint8_t *out, const minter::coin_symbol &value) {
+      return dev::rlpWriteItem(out, value.encoded());
+  }
+  static void read(const dev::RLP &rlp, minter::coin_symbol &value) {
+      value = minter::coin_symbol(rlp.toBytesConstRef());
+  }
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx) {
+      if (!rlp.isData()) {
+          return ctx.fail(minter::decode_error::string_expected, rlp);
+      }
+      if (rlp.size() > minter::coin_symbol::max_length) {
+          return ctx.fail(minter::decode_error::invalid_length, rlp);
+      }
+      return true;
+  }
+  static bool try_read(const dev::RLP &rlp, minter::coin_symbol &value, minter::decode_context &ctx) {
+      if (!check(rlp, ctx)) {
+          return false;
+      }
+      read(rlp, value);
+      return true;
+  }
+};
+
+template<>
+struct rlp_codec<minter::data::address> {
+  static size_t size(const minter::data::address &value) {
+      return dev::rlpItemSize(value.get());
+  }
+  static size_t write(uint8_t *out, const minter::data::address &value) {
+      return dev::rlpWriteItem(out, dev::bytesConstRef(&value.get()));
+  }
+  static void read(const dev::RLP &rlp, minter::data::address &value) {
+      value = minter::data::address(rlp.toBytes());
+  }
+  static const size_t length = 20;
+
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx) {
+      if (!rlp.isData()) {
+          return ctx.fail(minter::decode_error::string_expected, rlp);
+      }
+      if (rlp.size() != length) {
+          return ctx.fail(minter::decode_error::invalid_length, rlp);
+      }
+      return true;
+  }
+  static bool try_read(const dev::RLP &rlp, minter::data::address &value, minter::decode_context &ctx) {
+      if (!check(rlp, ctx)) {
+          return false;
+      }
+      read(rlp, value);
+      return true;
+  }
+};
+
+template<>
+struct rlp_codec<std::string> {
+  static size_t size(const std::string &value) {
+      return dev::rlpItemSize(value);
+  }
+  static size_t write(uint8_t *out, const std::string &value) {
+      return dev::rlpWriteItem(out, dev::bytesConstRef(value));
+  }
+  static void read(const dev::RLP &rlp, std::string &value) {
+      value = rlp.toString();
+  }
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx) {
+      return rlp.isData() || ctx.fail(minter::decode_error::string_expected, rlp);
+  }
+  static bool try_read(const dev::RLP &rlp, std::string &value, minter::decode_context &ctx) {
+      if (!check(rlp, ctx)) {
+          return false;
+      }
+      read(rlp, value);
+      return true;
+  }
+};
+
+template<size_t N>
+struct rlp_codec<minter::small_bytes<N>> {
+  static size_t size(const minter::small_bytes<N> &value) {
+      return dev::rlpItemSize(value.ref());
+  }
+  static size_t write(uint8_t *out, const minter::small_bytes<N> &value) {
+      return dev::rlpWriteItem(out, value.ref());
+  }
+  static void read(const dev::RLP &rlp, minter::small_bytes<N> &value) {
+      value = rlp.toBytesConstRef();
+  }
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx) {
+      return rlp.isData() || ctx.fail(minter::decode_error::string_expected, rlp);
+  }
+  static bool try_read(const dev::RLP &rlp, minter::small_bytes<N> &value, minter::decode_context &ctx) {
+      if (!check(rlp, ctx)) {
+          return false;
+      }
+      read(rlp, value);
+      return true;
+  }
+};
+
+/// \brief Vector of items is encoded as a nested list
+template<typename T>
+struct rlp_codec<std::vector<T>> {
+  static size_t payload_size(const std::vector<T> &value) {
+      size_t out = 0;
+      for (const auto &item: value) {
+          out += rlp_codec<T>::size(item);
+      }
+      return out;
+  }
+  static size_t size(const std::vector<T> &value) {
+      return dev::rlpListSize(payload_size(value));
+  }
+  static size_t write(uint8_t *out, const std::vector<T> &value) {
+      uint8_t *p = out;
+      p += dev::rlpWriteHeader(p, payload_size(value), true);
+      for (const auto &item: value) {
+          p += rlp_codec<T>::write(p, item);
+      }
+      return (size_t) (p - out);
+  }
+  static void read(const dev::RLP &rlp, std::vector<T> &value) {
+      value.clear();
+      if (!rlp.isList()) {
+          return;
+      }
+      // items are visited by iterator, in one pass
+      value.reserve(rlp.itemCount());
+      for (const auto &item: rlp) {
+          T decoded;
+          rlp_codec<T>::read(item, decoded);
+          value.push_back(std::move(decoded));
+      }
+  }
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx) {
+      if (!rlp.isList()) {
+          return ctx.fail(minter::decode_error::list_expected, rlp);
+      }
+      for (const auto &item: rlp) {
+          if (!rlp_codec<T>::check(item, ctx)) {
+              return false;
+          }
+      }
+      return true;
+  }
+  static bool try_read(const dev::RLP &rlp, std::vector<T> &value, minter::decode_context &ctx) {
+      if (!rlp.isList()) {
+          return ctx.fail(minter::decode_error::list_expected, rlp);
+      }
+      value.clear();
+      value.resize(rlp.itemCount());
+      size_t i = 0;
+      for (const auto &item: rlp) {
+          if (!rlp_codec<T>::try_read(item, value[i++], ctx)) {
+              return false;
+          }
+      }
+      return true;
+  }
+};
+
+/// \brief Type with its own schema is encoded as a nested list
+template<typename T>
+struct rlp_codec<T, typename schema_detail::make_void<typename minter::tx_schema<T>::fields>::type> {
+  static size_t size(const T &value) {
+      return minter::schema_encoded_size(value);
+  }
+  static size_t write(uint8_t *out, const T &value) {
+      return minter::schema_write(out, value);
+  }
+  static void read(const dev::RLP &rlp, T &value) {
+      minter::schema_decode(value, rlp);
+  }
+  static bool check(const dev::RLP &rlp, minter::decode_context &ctx) {
+      return minter::schema_check<T>(rlp, ctx);
+  }
+  static bool try_read(const dev::RLP &rlp, T &value, minter::decode_context &ctx) {
+      return minter::schema_try_read(value, rlp, ctx);
+  }
+};
+
+}
+
+#endif //MINTER_TX_SCHEMA_H
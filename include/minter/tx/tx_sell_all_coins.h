@@ -11,36 +11,56 @@
 #define MINTER_TX_SELL_ALL_COINS_H
 
 #include "tx_data.h"
+#include "tx_schema.h"
 
 namespace minter {
 
 class tx_sell_all_coins: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_sell_all_coins(std::shared_ptr<minter::tx> tx);
+    explicit tx_sell_all_coins(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     tx_sell_all_coins& set_coin_to_sell(const char* coin);
+
+    tx_sell_all_coins& set_coin_to_sell(const minter::coin_symbol &coin);
     tx_sell_all_coins& set_coin_to_sell(const std::string &coin);
     tx_sell_all_coins& set_coin_to_buy(const char* coin);
+    tx_sell_all_coins& set_coin_to_buy(const minter::coin_symbol &coin);
     tx_sell_all_coins& set_coin_to_buy(const std::string &coin);
     tx_sell_all_coins& set_min_value_to_buy(const char* amount);
     tx_sell_all_coins& set_min_value_to_buy(const std::string &amount);
     tx_sell_all_coins& set_min_value_to_buy(const dev::bigdec18 &amount);
 
-    std::string get_coin_to_sell() const;
-    std::string get_coin_to_buy() const;
+    minter::coin_symbol get_coin_to_sell() const;
+    minter::coin_symbol get_coin_to_buy() const;
     dev::bigdec18 get_min_value_to_buy() const;
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
-    std::string m_coin_to_sell;
-    std::string m_coin_to_buy;
+    minter::coin_symbol m_coin_to_sell;
+    minter::coin_symbol m_coin_to_buy;
     dev::bigint m_min_value_to_buy;
 };
 
+template<>
+struct tx_schema<minter::tx_sell_all_coins> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_sell_all_coins, minter::coin_symbol, &minter::tx_sell_all_coins::m_coin_to_sell>,
+      tx_field<minter::tx_sell_all_coins, minter::coin_symbol, &minter::tx_sell_all_coins::m_coin_to_buy>,
+      tx_field<minter::tx_sell_all_coins, dev::bigint, &minter::tx_sell_all_coins::m_min_value_to_buy>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"coin_to_sell", "coin_to_buy", "min_value_to_buy"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_SELL_ALL_COINS_H
@@ -13,38 +13,56 @@
 #include <minter/eth/RLP.h>
 #include "minter/address.h"
 #include "tx_data.h"
+#include "tx_schema.h"
 
 namespace minter {
 
 class tx_send_coin: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_send_coin(std::shared_ptr<minter::tx> tx);
+    explicit tx_send_coin(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
     tx_send_coin& set_coin(const std::string &coin);
 
     tx_send_coin& set_coin(std::string &&coin);
     tx_send_coin& set_coin(const char* coin);
+    tx_send_coin& set_coin(const minter::coin_symbol &coin);
     tx_send_coin& set_to(const minter::data::address &address);
     tx_send_coin& set_to(const std::string &address);
     tx_send_coin& set_to(const char* address);
     tx_send_coin& set_value(const dev::bigdec18 &normalized);
     tx_send_coin& set_value(const std::string &normalized);
     tx_send_coin& set_value(const dev::bigint &raw);
-    std::string get_coin() const;
+    minter::coin_symbol get_coin() const;
 
     minter::data::address get_to() const;
     dev::bigdec18 get_value() const;
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
-    std::string m_coin;
+    minter::coin_symbol m_coin;
     minter::data::address m_to;
     dev::bigint m_value;
 };
 
+template<>
+struct tx_schema<minter::tx_send_coin> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_send_coin, minter::coin_symbol, &minter::tx_send_coin::m_coin>,
+      tx_field<minter::tx_send_coin, minter::data::address, &minter::tx_send_coin::m_to>,
+      tx_field<minter::tx_send_coin, dev::bigint, &minter::tx_send_coin::m_value>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"coin", "to", "value"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_SEND_COIN_H
@@ -0,0 +1,75 @@
+/*!
+ * minter_tx.
+ * tx_send_coin_template.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TX_SEND_COIN_TEMPLATE_H
+#define MINTER_TX_SEND_COIN_TEMPLATE_H
+
+#include <memory>
+#include <vector>
+#include <minter/bip39/utils.h>
+#include <minter/eth/RLP.h>
+#include "minter/address.h"
+#include "minter/private_key.h"
+#include "minter/tx/secp256k1_raii.h"
+#include "tx.h"
+
+namespace minter {
+
+/// \brief Pre-encoded send coin transaction, for issuing a lot of transfers which differs only by nonce, recipient and amount.
+/// Chain id, gas price, gas coin, coin, payload and service data are taken from prototype and encoded once,
+/// so signing costs just a hashing and an ECDSA signature, without building tx/tx_data objects.
+/// Output is byte-identical to the tx_builder + sign_single() result for the same values.
+/// sign_single() does not modify template, so it can be used from multiple threads simultaneously.
+class tx_send_coin_template {
+public:
+    /// \brief Variable fields of one transaction
+    struct transfer {
+      dev::bigint nonce;
+      minter::data::address to;
+      dev::bigint value;
+    };
+
+    /// \param prototype send coin transaction (nonce, recipient and value are ignored)
+    /// \throws std::runtime_error if prototype is not a send coin transaction
+    explicit tx_send_coin_template(const std::shared_ptr<minter::tx> &prototype);
+
+    /// \brief Exact size of sign_single() result for given variable fields
+    size_t encoded_size(const dev::bigint &nonce, const dev::bigint &value) const;
+
+    minter::Data sign_single(const dev::bigint &nonce,
+                             const minter::data::address &to,
+                             const dev::bigint &value,
+                             const minter::data::private_key &pk) const;
+    /// \brief Signs many transactions with the same key, same as sign_single() for each of them.
+    /// Signing hashes are computed together by utils::sha3k_batch(), several messages at once
+    /// \return signed transactions in the same order
+    std::vector<minter::Data> sign_batch(const std::vector<transfer> &transfers,
+                                         const minter::data::private_key &pk) const;
+
+private:
+    size_t fields_size(const dev::bigint &nonce, const dev::bigint &value) const;
+    /// \brief Writes transaction fields into out, sized for signed transaction (see single_signed_layout)
+    /// \return unsigned data to hash for signing, located inside out
+    dev::bytesConstRef write_unsigned(const dev::bigint &nonce,
+                                      const minter::data::address &to,
+                                      const dev::bigint &value,
+                                      dev::bytes &out) const;
+
+    // encoded chain id, gas price, gas coin and type - between nonce and data
+    dev::bytes m_head;
+    // encoded coin - first item of data list
+    dev::bytes m_coin;
+    // encoded payload, service data and signature type - after data
+    dev::bytes m_tail;
+    minter::secp256k1_raii m_secp;
+};
+
+}
+
+#endif //MINTER_TX_SEND_COIN_TEMPLATE_H
@@ -11,29 +11,33 @@
 #define MINTER_TX_SET_CANDIDATE_ON_OFF_H
 
 #include "tx_data.h"
+#include "tx_schema.h"
 #include "minter/public_key.h"
 
 namespace minter {
 
 class tx_set_candidate_on_off: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_set_candidate_on_off(std::shared_ptr<minter::tx> tx);
+    explicit tx_set_candidate_on_off(std::shared_ptr<minter::tx> tx = nullptr);
 
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     tx_set_candidate_on_off& set_pub_key(const dev::bytes &pub_key);
     tx_set_candidate_on_off& set_pub_key(const minter::pubkey_t &pub_key);
-    const minter::pubkey_t& get_pub_key() const;
+    minter::pubkey_t get_pub_key() const;
 
 protected:
     void decode_internal(dev::RLP rlp) override;
-    minter::pubkey_t m_pub_key;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
+    minter::small_bytes<32> m_pub_key;
 
 };
 
 class tx_set_candidate_on: public minter::tx_set_candidate_on_off {
 public:
-    explicit tx_set_candidate_on(std::shared_ptr<minter::tx> tx);
+    explicit tx_set_candidate_on(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
 protected:
@@ -42,14 +46,29 @@ protected:
 
 class tx_set_candidate_off: public minter::tx_set_candidate_on_off {
 public:
-    explicit tx_set_candidate_off(std::shared_ptr<minter::tx> tx);
+    explicit tx_set_candidate_off(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
 protected:
     void decode_internal(dev::RLP rlp) override;
 };
 
+template<>
+struct tx_schema<minter::tx_set_candidate_on_off> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_set_candidate_on_off, minter::small_bytes<32>, &minter::tx_set_candidate_on_off::m_pub_key>>;
 
+  static const char *const *names() {
+      static const char *const out[] = {"pub_key"};
+      return out;
+  }
+};
+
+template<>
+struct tx_schema<minter::tx_set_candidate_on> : tx_schema<minter::tx_set_candidate_on_off> { };
+
+template<>
+struct tx_schema<minter::tx_set_candidate_off> : tx_schema<minter::tx_set_candidate_on_off> { };
 
 }
 
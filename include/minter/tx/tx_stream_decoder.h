@@ -0,0 +1,90 @@
+/*!
+ * minter_tx.
+ * tx_stream_decoder.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TX_STREAM_DECODER_H
+#define MINTER_TX_STREAM_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include "minter/tx/decode_status.h"
+#include "minter/tx/tx.h"
+
+namespace minter {
+
+enum class tx_stream_format {
+  // one hex encoded transaction per line, "0x" prefix is optional, empty lines are skipped
+  hex_lines,
+  // each transaction is prefixed with its 4-byte big-endian length
+  length_prefixed,
+};
+
+/// \brief Decoded record of the stream
+struct tx_stream_record {
+  // record number in stream, starting from 0
+  size_t index = 0;
+  // decoding result, offset is relative to decoded record bytes
+  minter::decode_status status;
+  // decoded transaction, nullptr if status is an error
+  std::shared_ptr<minter::tx> tx;
+};
+
+struct tx_stream_stats {
+  size_t records = 0;
+  size_t failed = 0;
+  // input bytes read
+  size_t bytes = 0;
+  double seconds = 0;
+
+  double records_per_second() const {
+      return seconds > 0 ? records / seconds : 0;
+  }
+};
+
+/// \brief Decodes stream of encoded transactions on a pool of worker threads.
+/// Input is read in chunks and split on record boundaries into batches, which are decoded in parallel.
+/// Records are passed to callback in input order, on the calling thread. Memory is bounded by the number
+/// of batches in flight, not by input size, so dumps of any size can be decoded.
+class tx_stream_decoder {
+public:
+    using callback = std::function<void(const minter::tx_stream_record &record)>;
+
+    struct options {
+      tx_stream_format format = tx_stream_format::hex_lines;
+      // 0 - number of hardware threads
+      size_t threads = 0;
+      // records per batch, passed to worker at once
+      size_t batch_size = 1024;
+      // batches being decoded or waiting for callback; 0 - twice the threads count
+      size_t max_batches = 0;
+      // bytes read from input at once
+      size_t chunk_size = 1024 * 1024;
+      // longer records are reported as oversize; length-prefixed stream with longer record is considered broken
+      size_t max_record_size = 64 * 1024;
+    };
+
+    explicit tx_stream_decoder(const options &opts);
+    tx_stream_decoder();
+
+    /// \brief Decodes stream until its end
+    /// \throws std::runtime_error if length-prefixed stream is broken; exceptions of callback are rethrown
+    minter::tx_stream_stats decode(std::istream &in, const callback &on_record);
+    /// \throws std::runtime_error if file can't be opened, and same as decode(std::istream&)
+    minter::tx_stream_stats decode_file(const std::string &path, const callback &on_record);
+
+private:
+    options m_opts;
+};
+
+}
+
+#endif //MINTER_TX_STREAM_DECODER_H
@@ -17,10 +17,17 @@
 #include <vector>
 #include "minter/tx/tx_fwd.h"
 #include "minter/tx/tx.h"
+#include "minter/tx/tx_schema.h"
 
 namespace minter {
 
 static constexpr double FEE_BASE = 0.001;
+/// FEE_BASE as decimal string, for exact fees: bigdec18 made from double is not exact
+static constexpr const char *FEE_BASE_DEC = "0.001";
+/// Fee units of each multisend item after the first one
+static constexpr size_t MULTISEND_ITEM_FEE = 5;
+/// Fee units of each payload byte
+static constexpr size_t PAYLOAD_BYTE_FEE = 2;
 
 enum tx_type_val {
   send_coin = (uint8_t) 0x01,
@@ -39,52 +46,97 @@ enum tx_type_val {
   edit_candidate
 };
 
-extern const std::unordered_map<tx_type_val, std::string> tx_type_names;
-
 template<class ref_type>
 struct tx_type;
 
-#define create_tx_type(_T) \
+#define create_tx_type(_T, type_byte) \
 template<> struct tx_type<minter::_T> { \
   typedef minter::_T ref_type; \
 \
-  static const uint16_t type(); \
+  static constexpr uint16_t type() { return static_cast<uint16_t>(type_byte); } \
   static dev::bigdec18 get_fee(); \
   static dev::bigdec18 get_fee(const dev::bigint &gas); \
-  static std::shared_ptr<minter::_T> create(std::shared_ptr<minter::tx> ptr, const std::vector<uint8_t>& encodedData); \
+  static std::shared_ptr<minter::_T> create(std::shared_ptr<minter::tx> ptr, dev::bytesConstRef encodedData); \
 }; \
 using _T##_type = tx_type<minter::_T>
 
-#define define_tx_type_funcs(_T, type_byte, fee) \
-    std::shared_ptr<minter::_T> minter::tx_type<minter::_T>::create(std::shared_ptr<minter::tx> ptr, const std::vector<uint8_t> &encodedData) { \
+#define define_tx_type_funcs(_T, fee) \
+    std::shared_ptr<minter::_T> minter::tx_type<minter::_T>::create(std::shared_ptr<minter::tx> ptr, dev::bytesConstRef encodedData) { \
         auto data = std::make_shared<minter::_T>(ptr); \
         data->decode(encodedData); \
         return data; \
     } \
     dev::bigdec18 minter::tx_type<minter::_T>::get_fee() { \
-        return dev::bigdec18(#fee) * dev::bigdec18(minter::FEE_BASE); \
+        return dev::bigdec18(#fee) * dev::bigdec18(minter::FEE_BASE_DEC); \
     } \
     dev::bigdec18 minter::tx_type<minter::_T>::get_fee(const dev::bigint &gas) { \
         return dev::bigdec18(gas) * get_fee(); \
-    } \
-    const uint16_t minter::tx_type<minter::_T>::type() { \
-        return static_cast<uint16_t>(type_byte); \
     }
 
-create_tx_type(tx_send_coin);
-create_tx_type(tx_sell_coin);
-create_tx_type(tx_sell_all_coins);
-create_tx_type(tx_buy_coin);
-create_tx_type(tx_create_coin);
-create_tx_type(tx_declare_candidacy);
-create_tx_type(tx_delegate);
-create_tx_type(tx_unbond);
-create_tx_type(tx_redeem_check);
-create_tx_type(tx_set_candidate_on);
-create_tx_type(tx_set_candidate_off);
-create_tx_type(tx_create_multisig_address);
-create_tx_type(tx_multisend);
-create_tx_type(tx_edit_candidate);
+create_tx_type(tx_send_coin, tx_type_val::send_coin);
+create_tx_type(tx_sell_coin, tx_type_val::sell_coin);
+create_tx_type(tx_sell_all_coins, tx_type_val::sell_all_coins);
+create_tx_type(tx_buy_coin, tx_type_val::buy_coin);
+create_tx_type(tx_create_coin, tx_type_val::create_coin);
+create_tx_type(tx_declare_candidacy, tx_type_val::declare_candidacy);
+create_tx_type(tx_delegate, tx_type_val::delegate);
+create_tx_type(tx_unbond, tx_type_val::unbond);
+create_tx_type(tx_redeem_check, tx_type_val::redeem_check);
+create_tx_type(tx_set_candidate_on, tx_type_val::set_candidate_on);
+create_tx_type(tx_set_candidate_off, tx_type_val::set_candidate_off);
+create_tx_type(tx_create_multisig_address, tx_type_val::create_multisig);
+create_tx_type(tx_multisend, tx_type_val::multisend);
+create_tx_type(tx_edit_candidate, tx_type_val::edit_candidate);
+
+/// \brief Fee of payload: PAYLOAD_BYTE_FEE units per byte, multiplied by gas
+dev::bigdec18 get_payload_fee(size_t payload_size, const dev::bigint &gas);
+/// \brief Fee of multisend: tx_multisend type fee for the first item, MULTISEND_ITEM_FEE units for each next one
+/// and payload fee, multiplied by gas
+dev::bigdec18 get_multisend_fee(size_t items, size_t payload_size, const dev::bigint &gas);
+
+
+/// \brief Runtime description of transaction type
+struct tx_type_info {
+  const char *name = nullptr;
+  dev::bigdec18 (*get_fee)() = nullptr;
+  std::shared_ptr<minter::tx_data> (*create)(std::shared_ptr<minter::tx> ptr, dev::bytesConstRef encodedData) = nullptr;
+  /// \brief Optional check of encoded data, without decoding it. If null, only RLP structure is checked
+  minter::decode_status (*validate)(dev::bytesConstRef encodedData) = nullptr;
+};
+
+/// \brief Table of known transaction types, indexed by type byte, so lookup is a single array access.
+/// Built-in types are registered on first use. Custom types can be added by add(), before any decoding
+/// starts: registration is not synchronized with lookups.
+class tx_type_registry {
+public:
+    static constexpr size_t max_types = 256;
+
+    /// \return type info or nullptr if type is unknown
+    static const tx_type_info *find(uint16_t type);
+    /// \return type name or nullptr if type is unknown
+    static const char *name(uint16_t type);
+
+    /// \brief Registers or replaces transaction type
+    /// \throws std::runtime_error if type doesn't fit in a byte, or info has no name or create function
+    static void add(uint16_t type, const tx_type_info &info);
+
+    /// \brief Registers type T, which must have tx_type<T> specialization (see create_tx_type).
+    /// If T has tx_schema, its data is validated by schema before decoding
+    template<typename T>
+    static void add(const char *name) {
+        tx_type_info info;
+        info.name = name;
+        info.get_fee = &minter::tx_type<T>::get_fee;
+        info.create = &create_data<T>;
+        info.validate = minter::schema_detail::validator<T>::get();
+        add(minter::tx_type<T>::type(), info);
+    }
+
+    template<typename T>
+    static std::shared_ptr<minter::tx_data> create_data(std::shared_ptr<minter::tx> ptr, dev::bytesConstRef encodedData) {
+        return minter::tx_type<T>::create(std::move(ptr), encodedData);
+    }
+};
 
 }
 
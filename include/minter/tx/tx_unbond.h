@@ -10,35 +10,53 @@
 #ifndef MINTER_TX_UNBOND_H
 #define MINTER_TX_UNBOND_H
 #include "tx_data.h"
+#include "tx_schema.h"
 #include "minter/public_key.h"
 namespace minter {
 
 class tx_unbond: public virtual minter::tx_data {
+    template<typename T> friend struct tx_schema;
 public:
-    explicit tx_unbond(std::shared_ptr<minter::tx> tx);
+    explicit tx_unbond(std::shared_ptr<minter::tx> tx = nullptr);
     uint16_t type() const override;
     dev::bytes encode() override;
+    size_t encoded_size() const override;
 
     tx_unbond& set_pub_key(const minter::pubkey_t &pub_key);
     tx_unbond& set_pub_key(const dev::bytes &pub_key);
     tx_unbond& set_coin(const char* coin);
+    tx_unbond& set_coin(const minter::coin_symbol &coin);
     tx_unbond& set_coin(const std::string &coin);
     tx_unbond& set_value(const char* value);
     tx_unbond& set_value(const dev::bigdec18 &value);
 
-    const minter::pubkey_t& get_pub_key() const;
-    std::string get_coin() const;
+    minter::pubkey_t get_pub_key() const;
+    minter::coin_symbol get_coin() const;
     dev::bigdec18 get_value() const;
 
 protected:
     void decode_internal(dev::RLP rlp) override;
+    minter::decode_status try_decode_internal(const dev::RLP &rlp) override;
 
 private:
-    minter::pubkey_t m_pub_key;
-    std::string m_coin;
+    minter::small_bytes<32> m_pub_key;
+    minter::coin_symbol m_coin;
     dev::bigint m_value;
 };
 
+template<>
+struct tx_schema<minter::tx_unbond> {
+  using fields = tx_field_list<
+      tx_field<minter::tx_unbond, minter::small_bytes<32>, &minter::tx_unbond::m_pub_key>,
+      tx_field<minter::tx_unbond, minter::coin_symbol, &minter::tx_unbond::m_coin>,
+      tx_field<minter::tx_unbond, dev::bigint, &minter::tx_unbond::m_value>>;
+
+  static const char *const *names() {
+      static const char *const out[] = {"pub_key", "coin", "value"};
+      return out;
+  }
+};
+
 }
 
 #endif //MINTER_TX_UNBOND_H
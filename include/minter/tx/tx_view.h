@@ -0,0 +1,97 @@
+/*!
+ * minter_tx.
+ * tx_view.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TX_VIEW_H
+#define MINTER_TX_VIEW_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <minter/eth/RLP.h>
+#include "minter/coin_symbol.h"
+#include "minter/tx/tx_type.h"
+
+namespace minter {
+
+/// \brief Read-only decoded transaction, which doesn't copy anything: fields are references into encoded buffer,
+/// so buffer must outlive the view. Structure is validated once in constructor, typed data is decoded only on request.
+/// Use it to scan a lot of transactions (e.g. indexing blocks) without allocations per transaction.
+class tx_view {
+public:
+    static constexpr size_t fields_count = 10;
+
+    /// \throws std::runtime_error if encoded data is not a valid transaction structure
+    explicit tx_view(dev::bytesConstRef encoded);
+
+    /// \brief Whole encoded transaction
+    dev::bytesConstRef get_encoded() const;
+
+    /// \brief Big-endian nonce bytes
+    dev::bytesConstRef get_nonce_raw() const;
+    /// \throws std::runtime_error if nonce doesn't fit in 64 bits
+    uint64_t get_nonce() const;
+    uint8_t get_chain_id() const;
+    /// \brief Big-endian gas price bytes
+    dev::bytesConstRef get_gas_price_raw() const;
+    /// \throws std::runtime_error if gas price doesn't fit in 64 bits
+    uint64_t get_gas_price() const;
+    minter::coin_symbol get_gas_coin() const;
+    uint16_t get_type() const;
+    /// \brief Encoded data list, same as minter::tx::get_data_raw()
+    dev::bytesConstRef get_data_raw() const;
+    dev::bytesConstRef get_payload() const;
+    dev::bytesConstRef get_service_data() const;
+    uint8_t get_signature_type() const;
+    /// \brief Encoded signature data: list for single signature, address and list for multi signature
+    dev::bytesConstRef get_signature_raw() const;
+
+    /// \brief Decodes data of type T
+    /// \throws std::runtime_error if transaction has other type
+    template<typename T>
+    T get_data() const {
+        if (minter::tx_type<T>::type() != m_type) {
+            throw std::runtime_error("Transaction data has different type");
+        }
+        T out;
+        out.decode(get_data_raw());
+        return out;
+    }
+
+    /// \brief Decodes signature data of type T (signature_single_data or signature_multi_data)
+    template<typename T>
+    T get_signature_data() const {
+        T out;
+        out.decode(dev::RLP(get_signature_raw()));
+        return out;
+    }
+
+private:
+    enum field {
+      nonce = 0,
+      chain_id,
+      gas_price,
+      gas_coin,
+      type,
+      data,
+      payload,
+      service_data,
+      signature_type,
+      signature
+    };
+
+    dev::bytesConstRef m_encoded;
+    // payloads of transaction list items, in encoding order
+    dev::bytesConstRef m_fields[fields_count];
+    uint16_t m_type;
+    uint8_t m_chain_id;
+    uint8_t m_signature_type;
+};
+
+}
+
+#endif //MINTER_TX_VIEW_H
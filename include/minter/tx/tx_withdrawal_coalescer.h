@@ -0,0 +1,163 @@
+/*!
+ * minter_tx.
+ * tx_withdrawal_coalescer.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TX_WITHDRAWAL_COALESCER_H
+#define MINTER_TX_WITHDRAWAL_COALESCER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <minter/bip39/utils.h>
+#include "minter/private_key.h"
+#include "minter/tx/nonce_allocator.h"
+#include "minter/tx/tx_multisend.h"
+
+namespace minter {
+
+/// \brief Signed transaction with one or more withdrawals
+struct coalesced_tx {
+  uint64_t nonce = 0;
+  // tx_send_coin if there is one item, tx_multisend otherwise
+  std::vector<minter::send_target> items;
+  // in base coin pips: send coin fee for a single item, tx_multisend_planner::fee() otherwise
+  dev::bigint fee;
+  minter::Data data;
+};
+
+struct tx_coalescer_stats {
+  size_t items = 0;
+  size_t txs = 0;
+  // transactions with one item
+  size_t single_txs = 0;
+  dev::bigint fee;
+  // fee of a send coin transaction per item minus fee paid
+  dev::bigint saved_fee;
+  // latency from submit() to signed transaction, over the last latency_samples items, milliseconds
+  double latency_p50 = 0;
+  double latency_p90 = 0;
+  double latency_p99 = 0;
+  double latency_max = 0;
+};
+
+/// \brief Collects withdrawals into batches and signs each batch as one multisend transaction,
+/// so fee is paid once per batch. Batch is closed when it has max_items items, or when its first item
+/// waits for `window`. Batch of one item is signed as a send coin transaction.
+/// Nonces are reserved from allocator when batch is closed, so transactions get them in order of batches.
+/// Signing is done on a pool of worker threads, but transactions are passed to callback one at a time,
+/// in order of batches, so they can be sent right from it. Reservation is committed when callback returns.
+/// If signing or callback fails, batches already closed behind it fail too, as their nonces are higher;
+/// their nonces are released and batches closed after that take them again, in order.
+class tx_withdrawal_coalescer {
+public:
+    using tx_ptr = std::shared_ptr<const minter::coalesced_tx>;
+    using callback = std::function<void(const tx_ptr &tx)>;
+
+    struct options {
+      // max time the first item of batch waits for other ones
+      std::chrono::milliseconds window{200};
+      // network limit of items per multisend
+      size_t max_items = 100;
+      // signing threads
+      size_t threads = 1;
+      // items which latency percentiles are computed over
+      size_t latency_samples = 10000;
+
+      uint8_t chain_id = minter::mainnet;
+      dev::bigint gas_price = 1;
+      minter::coin_symbol gas_coin = "BIP";
+      dev::bytes payload;
+    };
+
+    /// \param nonces allocator of the sender address, must outlive coalescer
+    /// \param on_tx called on worker thread for each signed transaction (can be empty), before futures are ready.
+    /// Calls are not concurrent and go in order of batches; throw to mark transaction as not sent
+    tx_withdrawal_coalescer(const minter::data::private_key &pk,
+                            minter::nonce_allocator &nonces,
+                            const options &opts,
+                            callback on_tx = nullptr);
+    tx_withdrawal_coalescer(const tx_withdrawal_coalescer &other) = delete;
+    tx_withdrawal_coalescer &operator=(const tx_withdrawal_coalescer &other) = delete;
+    /// \brief Signs buffered withdrawals and waits for them
+    ~tx_withdrawal_coalescer();
+
+    /// \brief Adds withdrawal to the current batch
+    /// \return signed transaction which contains it; holds exception of signing or on_tx callback, if they failed
+    std::future<tx_ptr> submit(const minter::send_target &withdrawal);
+    /// \brief Closes current batch right away, without waiting for window
+    void flush();
+
+    minter::tx_coalescer_stats stats() const;
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct pending_item {
+      minter::send_target target;
+      clock::time_point submitted;
+      std::promise<tx_ptr> done;
+    };
+
+    struct batch {
+      // order of closing
+      size_t seq = 0;
+      minter::nonce_allocator::reservation nonce;
+      std::vector<pending_item> items;
+    };
+
+    void run_batcher();
+    void run_signer();
+    void sign_batch(batch &b);
+    // under lock
+    void close_batch();
+    void add_latency(std::chrono::nanoseconds latency);
+
+    const minter::data::private_key m_pk;
+    minter::nonce_allocator &m_nonces;
+    const options m_opts;
+    const callback m_on_tx;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_batch_cv;
+    std::condition_variable m_sign_cv;
+    std::condition_variable m_deliver_cv;
+    std::vector<pending_item> m_current;
+    clock::time_point m_current_start;
+    // number of closed batches
+    size_t m_batch_seq = 0;
+    std::deque<std::unique_ptr<batch>> m_closed;
+    // number of batches passed to callback
+    size_t m_delivered_seq = 0;
+    // seq after the last batch which reserved a nonce
+    size_t m_reserved_until = 0;
+    // batches with lower seq fail: they are behind a failed one
+    size_t m_fail_until = 0;
+    // closed while failed batches are not delivered, nonces are not reserved yet
+    std::deque<std::unique_ptr<batch>> m_deferred;
+    bool m_stop = false;
+
+    minter::tx_coalescer_stats m_stats;
+    // ring of last latencies, nanoseconds
+    std::vector<int64_t> m_latencies;
+    size_t m_latency_pos = 0;
+
+    std::thread m_batcher;
+    std::vector<std::thread> m_signers;
+};
+
+}
+
+#endif //MINTER_TX_WITHDRAWAL_COALESCER_H
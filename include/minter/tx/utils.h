@@ -12,6 +12,7 @@
 
 #include <stack>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <minter/eth/vector_ref.h>
 #include <toolboxpp.hpp>
@@ -36,6 +37,28 @@ dev::bigint to_bigint(const dev::bytes &bytes);
 dev::bigint to_bigint(const uint8_t *bytes, size_t len);
 dev::bytes sha3k(const dev::bytes &message);
 dev::bytes sha3k(const minter::Data &message);
+/// \brief Keccak-256 of message written to out (32 bytes), without allocations
+void sha3k_into(const uint8_t *data, size_t size, uint8_t *out);
+
+/// \brief Keccak-256 implementation hashing a fixed number of independent messages at once.
+/// AVX2 (4 messages) and AVX-512 (8 messages) kernels are compiled on x86 with GCC or Clang,
+/// the widest one supported by CPU is chosen at runtime; elsewhere scalar one is used.
+struct sha3k_kernel {
+  const char *name;
+  // messages hashed at once
+  size_t lanes;
+  /// \brief Hashes exactly `lanes` messages, writes lanes * 32 bytes to out
+  void (*hash)(const dev::bytesConstRef *messages, uint8_t *out);
+
+  /// \brief Widest kernel supported by CPU, chosen on first call
+  static const sha3k_kernel &get();
+  /// \brief All kernels supported by CPU, scalar first
+  static std::vector<const sha3k_kernel *> supported();
+};
+
+/// \brief Keccak-256 of each message, same as sha3k(), using widest kernel
+/// \param out count * 32 bytes, digests in the same order
+void sha3k_batch(const dev::bytesConstRef *messages, size_t count, uint8_t *out);
 std::string strip_null_bytes(const char* input);
 std::string to_string(const dev::bytes &src);
 std::string to_string(const std::vector<char> &src);
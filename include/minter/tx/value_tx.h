@@ -0,0 +1,160 @@
+/*!
+ * minter_tx.
+ * value_tx.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_VALUE_TX_H
+#define MINTER_VALUE_TX_H
+
+#include <stdexcept>
+#include <boost/variant.hpp>
+#include <minter/bip39/utils.h>
+#include "minter/arena.h"
+#include "minter/coin_symbol.h"
+#include "minter/private_key.h"
+#include "minter/small_bytes.h"
+#include "minter/tx/rlp_sink.h"
+#include "minter/tx/tx_send_coin.h"
+#include "minter/tx/tx_sell_coin.h"
+#include "minter/tx/tx_sell_all_coins.h"
+#include "minter/tx/tx_buy_coin.h"
+#include "minter/tx/tx_create_coin.h"
+#include "minter/tx/tx_declare_candidacy.h"
+#include "minter/tx/tx_delegate.h"
+#include "minter/tx/tx_unbond.h"
+#include "minter/tx/tx_redeem_check.h"
+#include "minter/tx/tx_set_candidate_on_off.h"
+#include "minter/tx/tx_create_multisig_address.h"
+#include "minter/tx/tx_multisend.h"
+#include "minter/tx/tx_edit_candidate.h"
+
+namespace minter {
+
+/// \brief Data of any transaction type, held by value
+using tx_payload = boost::variant<
+    minter::tx_send_coin,
+    minter::tx_sell_coin,
+    minter::tx_sell_all_coins,
+    minter::tx_buy_coin,
+    minter::tx_create_coin,
+    minter::tx_declare_candidacy,
+    minter::tx_delegate,
+    minter::tx_unbond,
+    minter::tx_redeem_check,
+    minter::tx_set_candidate_on,
+    minter::tx_set_candidate_off,
+    minter::tx_create_multisig_address,
+    minter::tx_multisend,
+    minter::tx_edit_candidate>;
+
+/// \brief Transaction with value semantics: it keeps its data inline instead of shared tx/tx_data pair,
+/// so it can live on a stack or contiguously in a vector. Encodes and signs exactly like minter::tx.
+/// Data objects stored here are not attached to any minter::tx, so don't call build() on them.
+/// Transaction made with arena keeps payload, service data, signature and multisend items there when they don't fit
+/// inline, so a batch is built in one arena and freed at once. Copies share the arena of source.
+class value_tx {
+public:
+    /// \brief Decodes signed transaction, it's validated first as minter::tx::decode() does
+    /// \throws std::runtime_error if data is not a valid transaction
+    static value_tx decode(dev::bytesConstRef encoded);
+    static value_tx decode(const char *hexEncoded);
+    /// \brief Same as decode(), but decoded transaction keeps its data in arena
+    static value_tx decode(dev::bytesConstRef encoded, minter::arena &arena);
+
+    value_tx();
+    /// \param arena keeps data of transaction, must outlive it. nullptr means global heap
+    explicit value_tx(minter::arena *arena);
+
+    /// \brief Setters drop signature, it doesn't match changed transaction. Sign it again before encoding signed
+    value_tx &set_nonce(const dev::bigint &nonce);
+    value_tx &set_chain_id(uint8_t id);
+    value_tx &set_gas_price(const dev::bigint &amount);
+    value_tx &set_gas_coin(const minter::coin_symbol &coin);
+    value_tx &set_payload(dev::bytesConstRef payload);
+    value_tx &set_service_data(dev::bytesConstRef service_data);
+    value_tx &set_data(const minter::tx_payload &data);
+    value_tx &set_data(minter::tx_payload &&data);
+
+    /// \brief Replaces data with empty data of type T
+    /// \return reference to new data, to fill it
+    template<typename T>
+    T &set_data() {
+        m_data = T();
+        m_signature.clear();
+        attach_arena();
+        return boost::get<T>(m_data);
+    }
+
+    dev::bigint get_nonce() const;
+    uint8_t get_chain_id() const;
+    dev::bigint get_gas_price() const;
+    minter::coin_symbol get_gas_coin() const;
+    uint16_t get_type() const;
+    const minter::small_bytes<64> &get_payload() const;
+    const minter::small_bytes<32> &get_service_data() const;
+    uint8_t get_signature_type() const;
+    const minter::tx_payload &get_data_variant() const;
+
+    /// \brief Changing data through this pointer doesn't drop signature, as setters do:
+    /// signature becomes invalid, so sign transaction again
+    /// \return data if transaction has type T, nullptr otherwise
+    template<typename T>
+    T *get_data() {
+        return boost::get<T>(&m_data);
+    }
+    template<typename T>
+    const T *get_data() const {
+        return boost::get<T>(&m_data);
+    }
+
+    /// \brief Decoded signature: signature_single_data or signature_multi_data, by signature type
+    /// \throws std::runtime_error if transaction is not signed
+    template<typename T>
+    T get_signature_data() const {
+        if (m_signature.empty()) {
+            throw std::runtime_error("Transaction is not signed");
+        }
+        T out;
+        out.decode(dev::RLP(m_signature.ref()));
+        return out;
+    }
+
+    /// \brief Same as minter::tx::encoded_size()
+    size_t encoded_size(minter::tx_encoding encoding = minter::tx_encoding::signed_tx) const;
+    /// \brief Same as minter::tx::encode_to()
+    void encode_to(minter::rlp_sink &out, minter::tx_encoding encoding = minter::tx_encoding::signed_tx) const;
+    /// \throws std::runtime_error if signed transaction is requested, but transaction is not signed
+    dev::bytes encode(minter::tx_encoding encoding = minter::tx_encoding::signed_tx);
+
+    minter::Data sign_single(const minter::data::private_key &pk);
+    /// \brief Signs transaction and writes signed transaction into arena, without intermediate buffers.
+    /// Signing doesn't use global allocator: hash and signature are kept on stack, secp256k1 context is per thread
+    /// \return signed transaction, valid until arena is released; empty if signing failed
+    dev::bytesConstRef sign_single(const minter::data::private_key &pk, minter::arena &out);
+
+private:
+    static void decode_into(dev::bytesConstRef encoded, value_tx &out);
+    size_t payload_size(minter::tx_encoding encoding) const;
+    /// \brief Moves data which has own storage (multisend items) into arena of transaction
+    void attach_arena();
+
+    dev::bigint m_nonce;
+    dev::bigint m_chain_id;
+    dev::bigint m_gas_price;
+    minter::coin_symbol m_gas_coin;
+    minter::tx_payload m_data;
+    minter::small_bytes<64> m_payload;
+    minter::small_bytes<32> m_service_data;
+    dev::bigint m_signature_type;
+    // encoded signature data, empty until signed
+    minter::small_bytes<72> m_signature;
+    minter::arena *m_arena;
+};
+
+}
+
+#endif //MINTER_VALUE_TX_H
@@ -0,0 +1,137 @@
+/*!
+ * minter_tx.
+ * arena.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <new>
+#include <utility>
+#include "minter/arena.h"
+
+constexpr size_t minter::arena::default_chunk_size;
+
+minter::arena::arena(size_t chunk_size) :
+    m_chunk_size(chunk_size) {
+}
+
+minter::arena::arena(minter::arena &&other) noexcept :
+    m_head(other.m_head),
+    m_cur(other.m_cur),
+    m_end(other.m_end),
+    m_chunk_size(other.m_chunk_size),
+    m_allocated(other.m_allocated),
+    m_capacity(other.m_capacity) {
+    other.m_head = nullptr;
+    other.m_cur = other.m_end = nullptr;
+    other.m_allocated = other.m_capacity = 0;
+}
+
+minter::arena &minter::arena::operator=(minter::arena &&other) noexcept {
+    if (this != &other) {
+        free_chunks(m_head);
+        m_head = other.m_head;
+        m_cur = other.m_cur;
+        m_end = other.m_end;
+        m_chunk_size = other.m_chunk_size;
+        m_allocated = other.m_allocated;
+        m_capacity = other.m_capacity;
+        other.m_head = nullptr;
+        other.m_cur = other.m_end = nullptr;
+        other.m_allocated = other.m_capacity = 0;
+    }
+    return *this;
+}
+
+minter::arena::~arena() {
+    free_chunks(m_head);
+}
+
+void *minter::arena::allocate(size_t size, size_t alignment) {
+    auto aligned = [alignment](uint8_t *p) {
+        return (uint8_t *) (((uintptr_t) p + alignment - 1) & ~(uintptr_t) (alignment - 1));
+    };
+
+    uint8_t *out = aligned(m_cur);
+    if (m_cur == nullptr || out + size > m_end) {
+        add_chunk(size + alignment);
+        out = aligned(m_cur);
+    }
+
+    m_cur = out + size;
+    m_allocated += size;
+    return out;
+}
+
+dev::bytesRef minter::arena::allocate_bytes(size_t size) {
+    return dev::bytesRef((uint8_t *) allocate(size, 1), size);
+}
+
+void minter::arena::release() noexcept {
+    if (m_head == nullptr) {
+        return;
+    }
+
+    // newest chunk is the head, keep the first one, which is the last in list
+    chunk *first = m_head;
+    while (first->next != nullptr) {
+        chunk *next = first->next;
+        m_capacity -= first->size;
+        ::operator delete(first);
+        first = next;
+    }
+
+    m_allocated = 0;
+    // oversized chunk was made for one big allocation, it's not kept
+    if (first->size != m_chunk_size) {
+        free_chunks(first);
+        m_head = nullptr;
+        m_cur = m_end = nullptr;
+        m_capacity = 0;
+        return;
+    }
+
+    m_head = first;
+    m_cur = (uint8_t *) (first + 1);
+    m_end = m_cur + first->size;
+}
+
+bool minter::arena::contains(const void *p) const noexcept {
+    const auto *ptr = (const uint8_t *) p;
+    for (const chunk *c = m_head; c != nullptr; c = c->next) {
+        const auto *begin = (const uint8_t *) (c + 1);
+        if (ptr >= begin && ptr < begin + c->size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t minter::arena::allocated() const noexcept {
+    return m_allocated;
+}
+
+size_t minter::arena::capacity() const noexcept {
+    return m_capacity;
+}
+
+void minter::arena::add_chunk(size_t min_size) {
+    const size_t size = min_size > m_chunk_size ? min_size : m_chunk_size;
+    auto *c = (chunk *) ::operator new(sizeof(chunk) + size);
+    c->next = m_head;
+    c->size = size;
+    m_head = c;
+    m_cur = (uint8_t *) (c + 1);
+    m_end = m_cur + size;
+    m_capacity += size;
+}
+
+void minter::arena::free_chunks(chunk *from) noexcept {
+    while (from != nullptr) {
+        chunk *next = from->next;
+        ::operator delete(from);
+        from = next;
+    }
+}
@@ -11,6 +11,7 @@
 #include <toolboxpp.hpp>
 #include <regex>
 #include "minter/address.h"
+#include "minter/hex.h"
 #include "minter/tx/utils.h"
 
 minter::data::address::address(const char *hex) {
@@ -25,7 +26,7 @@ minter::data::address::address(const char *hex) {
         hex
         );
 
-    m_data = address_data(address.c_str());
+    m_data = minter::from_hex(address);
 }
 
 minter::data::address::address(const std::string &hex): address(hex.c_str()) {
@@ -45,14 +46,9 @@ minter::data::address::address(const minter::pubkey_t &pub_key) {
     //                        .sha3Mutable()
     //                        .takeLastMutable(20)
 
-    minter::Data d = pub_key.get();
-    dev::bytes dropped_first(pub_key.get().size()-1);
-    std::copy(pub_key.get().begin()+1, pub_key.get().end(), dropped_first.begin());
-    dev::bytes hashed = minter::utils::sha3k(dropped_first);
-    dev::bytes last20(20);
-    std::copy(hashed.end()-20, hashed.end(), last20.begin());
-
-    m_data = std::move(last20);
+    uint8_t hashed[32];
+    minter::utils::sha3k_into(pub_key.get().data() + 1, pub_key.get().size() - 1, hashed);
+    std::copy(hashed + 12, hashed + 32, m_data.data());
 }
 
 minter::data::address::address(const minter::privkey_t &priv_key): address(priv_key.get_public_key()) {
@@ -76,11 +72,11 @@ std::vector<uint8_t> &minter::data::address::get() {
 }
 
 const std::string minter::data::address::to_string() const {
-    return "Mx" + m_data.toHex();
+    return "Mx" + minter::to_hex(dev::bytesConstRef(&m_data.get()));
 }
 
 const std::string minter::data::address::to_string_no_prefix() const {
-    return m_data.toHex();
+    return minter::to_hex(dev::bytesConstRef(&m_data.get()));
 }
 
 bool minter::data::address::operator==(const minter::data::address &other) const noexcept {
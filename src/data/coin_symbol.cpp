@@ -0,0 +1,98 @@
+/*!
+ * minter_tx.
+ * coin_symbol.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <stdexcept>
+#include "minter/coin_symbol.h"
+
+constexpr size_t minter::data::coin_symbol::max_length;
+
+minter::data::coin_symbol::coin_symbol() noexcept {
+    memset(m_data, 0, sizeof(m_data));
+}
+
+minter::data::coin_symbol::coin_symbol(const char *symbol) : coin_symbol() {
+    if (symbol != nullptr) {
+        assign(symbol, strlen(symbol));
+    }
+}
+
+minter::data::coin_symbol::coin_symbol(const std::string &symbol) : coin_symbol() {
+    assign(symbol.c_str(), symbol.size());
+}
+
+minter::data::coin_symbol::coin_symbol(dev::bytesConstRef encoded) : coin_symbol() {
+    size_t n = 0;
+    for (size_t i = 0; i < encoded.size(); i++) {
+        if (encoded[i] == 0x00) {
+            continue;
+        }
+        if (n == max_length) {
+            throw std::runtime_error("coin symbol length is not valid");
+        }
+        m_data[n++] = encoded[i];
+    }
+}
+
+void minter::data::coin_symbol::assign(const char *symbol, size_t len) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (symbol[i] == 0x00) {
+            continue;
+        }
+        if (n == max_length) {
+            throw std::runtime_error("coin symbol length is not valid");
+        }
+        m_data[n++] = (uint8_t) symbol[i];
+    }
+}
+
+const char *minter::data::coin_symbol::c_str() const noexcept {
+    return reinterpret_cast<const char *>(m_data);
+}
+
+size_t minter::data::coin_symbol::size() const noexcept {
+    return strlen(c_str());
+}
+
+bool minter::data::coin_symbol::empty() const noexcept {
+    return m_data[0] == 0x00;
+}
+
+bool minter::data::coin_symbol::is_valid() const noexcept {
+    const size_t len = size();
+    if (len < 3 || len > max_length) {
+        return false;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        const uint8_t c = m_data[i];
+        if ((c < 'A' || c > 'Z') && (c < '0' || c > '9')) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+dev::bytesConstRef minter::data::coin_symbol::encoded() const noexcept {
+    return dev::bytesConstRef(m_data, max_length);
+}
+
+std::string minter::data::coin_symbol::to_string() const {
+    return std::string(c_str());
+}
+
+minter::data::coin_symbol::operator std::string() const {
+    return to_string();
+}
+
+std::ostream &operator<<(std::ostream &out, const minter::coin_symbol &coin) {
+    out << coin.c_str();
+    return out;
+}
@@ -9,6 +9,7 @@
 
 #include <toolboxpp.hpp>
 #include "minter/hash.h"
+#include "minter/hex.h"
 
 minter::data::minter_hash::minter_hash(const char *hex) {
     std::string pk = toolboxpp::strings::substringReplaceAll(
@@ -17,7 +18,7 @@ minter::data::minter_hash::minter_hash(const char *hex) {
         hex
     );
 
-    m_data = data_t(pk.c_str());
+    m_data = minter::from_hex(pk);
 }
 minter::data::minter_hash::minter_hash(const std::string &hex): minter_hash(hex.c_str()) {
 
@@ -59,10 +60,10 @@ minter::data::minter_hash::operator std::string() const {
     return to_string();
 }
 std::string minter::data::minter_hash::to_string() const {
-    return "Mt" + m_data.toHex();
+    return "Mt" + minter::to_hex(dev::bytesConstRef(&m_data.get()));
 }
 std::string minter::data::minter_hash::to_string_no_prefix() const {
-    return m_data.toHex();
+    return minter::to_hex(dev::bytesConstRef(&m_data.get()));
 }
 
 std::ostream& operator << (std::ostream &os, const minter::hash_t &hash) {
@@ -9,6 +9,7 @@
 
 #include <sstream>
 #include "minter/private_key.h"
+#include "minter/hex.h"
 minter::data::private_key minter::data::private_key::from_mnemonic(const std::string &mnem, uint32_t derive_index) {
     return from_mnemonic(mnem.c_str(), derive_index);
 }
@@ -32,7 +33,7 @@ minter::data::private_key minter::data::private_key::from_mnemonic(const char *m
 minter::data::private_key::private_key() : FixedData() {
 }
 minter::data::private_key::private_key(const char *hexString) : FixedData() {
-    m_data = std::move(minter::hexToBytes(hexString));
+    m_data = minter::from_hex(hexString);
 }
 minter::data::private_key::private_key(const uint8_t *data) : FixedData(data) {
 
@@ -81,7 +82,7 @@ bool minter::data::private_key::operator!=(const minter::data::private_key &othe
 }
 
 std::string minter::data::private_key::to_string() const {
-    return toHex();
+    return minter::to_hex(dev::bytesConstRef(&get()));
 }
 minter::data::private_key::operator std::string() const {
     return to_string();
@@ -9,6 +9,7 @@
 
 #include <toolboxpp.hpp>
 #include "minter/public_key.h"
+#include "minter/hex.h"
 
 minter::data::public_key::public_key(const char *hex) {
     std::string pk = toolboxpp::strings::substringReplaceAll(
@@ -17,7 +18,7 @@ minter::data::public_key::public_key(const char *hex) {
         hex
     );
 
-    m_data = data_t(pk.c_str());
+    m_data = minter::from_hex(pk);
 }
 
 minter::data::public_key::public_key(const std::string &hex): public_key(hex.c_str()) {
@@ -72,9 +73,9 @@ uint8_t minter::data::public_key::at(size_t idx) const {
 }
 
 std::string minter::data::public_key::to_string() const {
-    return "Mp" + m_data.toHex();
+    return "Mp" + minter::to_hex(dev::bytesConstRef(&m_data.get()));
 }
 
 std::string minter::data::public_key::to_string_no_prefix() const {
-    return m_data.toHex();
+    return minter::to_hex(dev::bytesConstRef(&m_data.get()));
 }
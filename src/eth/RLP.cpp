@@ -346,6 +346,56 @@ void RLPStream::pushCount(size_t _count, byte _base)
     pushInt(_count, br);
 }
 
+size_t dev::rlpWriteHeader(byte* _out, size_t _payloadSize, bool _isList)
+{
+    if (_payloadSize < c_rlpDataImmLenCount)
+    {
+        _out[0] = (byte)((_isList ? c_rlpListStart : c_rlpDataImmLenStart) + _payloadSize);
+        return 1;
+    }
+
+    auto br = bytesRequired(_payloadSize);
+    _out[0] = (byte)((_isList ? c_rlpListIndLenZero : c_rlpDataIndLenZero) + br);
+    for (size_t i = br; i > 0; --i, _payloadSize >>= 8)
+        _out[i] = (byte)(_payloadSize & 0xff);
+    return 1 + br;
+}
+
+size_t dev::rlpWriteItem(byte* _out, bytesConstRef _s)
+{
+    if (_s.size() == 1 && _s[0] < c_rlpDataImmLenStart)
+    {
+        _out[0] = _s[0];
+        return 1;
+    }
+
+    size_t h = rlpWriteHeader(_out, _s.size(), false);
+    if (_s.size())
+        memcpy(_out + h, _s.data(), _s.size());
+    return h + _s.size();
+}
+
+size_t dev::rlpWriteItem(byte* _out, bigint const& _i)
+{
+    if (!_i)
+    {
+        _out[0] = c_rlpDataImmLenStart;
+        return 1;
+    }
+    if (_i < c_rlpDataImmLenStart)
+    {
+        _out[0] = (byte)_i;
+        return 1;
+    }
+
+    size_t br = boost::multiprecision::msb(_i) / 8 + 1;
+    size_t h = rlpWriteHeader(_out, br, false);
+    byte* b = _out + h + br - 1;
+    for (bigint i = _i; i; i >>= 8)
+        *(b--) = (byte)(i & 0xff);
+    return h + br;
+}
+
 static void streamOut(std::ostream& _out, dev::RLP const& _d, unsigned _depth = 0)
 {
     if (_depth > 64)
@@ -373,4 +423,99 @@ std::ostream& dev::operator<<(std::ostream& _out, RLP const& _d)
 {
     streamOut(_out, _d);
     return _out;
-}
\ No newline at end of file
+}
+
+RLPError dev::rlpTryParseHeader(bytesConstRef _d, bool& _isList, size_t& _headerSize, size_t& _payloadSize)
+{
+    if (_d.empty())
+        return RLPError::Truncated;
+
+    byte const n = _d[0];
+    _isList = n >= c_rlpListStart;
+    if (n < c_rlpDataImmLenStart)
+    {
+        _headerSize = 0;
+        _payloadSize = 1;
+        return RLPError::None;
+    }
+
+    byte const immLenZero = _isList ? c_rlpListStart : c_rlpDataImmLenStart;
+    byte const indLenZero = _isList ? c_rlpListIndLenZero : c_rlpDataIndLenZero;
+    if (n <= indLenZero)
+    {
+        _headerSize = 1;
+        _payloadSize = n - immLenZero;
+        // single byte below 0x80 must be encoded as is
+        if (!_isList && _payloadSize == 1 && _d.size() > 1 && _d[1] < c_rlpDataImmLenStart)
+            return RLPError::NonCanonical;
+    }
+    else
+    {
+        unsigned const lengthSize = n - indLenZero;
+        if (_d.size() <= lengthSize || lengthSize > sizeof(size_t))
+            return RLPError::Truncated;
+        if (!_d[1])
+            return RLPError::NonCanonical;
+
+        size_t length = 0;
+        for (unsigned i = 0; i < lengthSize; ++i)
+            length = (length << 8) | _d[i + 1];
+        if (length < c_rlpDataImmLenCount)
+            return RLPError::NonCanonical;
+
+        _headerSize = 1 + lengthSize;
+        _payloadSize = length;
+    }
+
+    // compared without overflow: hostile length prefix may be close to size_t max
+    if (_payloadSize > _d.size() - _headerSize)
+        return RLPError::Truncated;
+    return RLPError::None;
+}
+
+RLPError dev::rlpValidate(bytesConstRef _d, size_t& _errorOffset)
+{
+    // ends of currently open lists
+    size_t ends[c_rlpMaxDepth + 1];
+    size_t depth = 0;
+    ends[0] = _d.size();
+
+    size_t pos = 0;
+    bool isList;
+    size_t headerSize;
+    size_t payloadSize;
+
+    RLPError err = rlpTryParseHeader(_d, isList, headerSize, payloadSize);
+    if (err == RLPError::None && headerSize + payloadSize != _d.size())
+    {
+        _errorOffset = headerSize + payloadSize;
+        return RLPError::Oversize;
+    }
+
+    while (err == RLPError::None)
+    {
+        if (isList)
+        {
+            if (depth == c_rlpMaxDepth)
+            {
+                err = RLPError::TooDeep;
+                break;
+            }
+            ends[++depth] = pos + headerSize + payloadSize;
+            pos += headerSize;
+        }
+        else
+            pos += headerSize + payloadSize;
+
+        // close finished lists, items never cross list end as they are parsed within it
+        while (depth > 0 && pos == ends[depth])
+            --depth;
+        if (depth == 0)
+            break;
+
+        err = rlpTryParseHeader(_d.cropped(pos, ends[depth] - pos), isList, headerSize, payloadSize);
+    }
+
+    _errorOffset = err == RLPError::None ? 0 : pos;
+    return err;
+}
@@ -0,0 +1,272 @@
+/*!
+ * minter_tx.
+ * hex.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "minter/hex.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MINTER_HEX_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const char hex_chars[] = "0123456789abcdef";
+
+inline int nibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void encode_scalar(const uint8_t *data, size_t size, char *out) {
+    for (size_t i = 0; i < size; i++) {
+        out[i * 2] = hex_chars[data[i] >> 4];
+        out[i * 2 + 1] = hex_chars[data[i] & 0x0f];
+    }
+}
+
+bool decode_scalar(const char *hex, size_t size, uint8_t *out, size_t &error_pos) {
+    for (size_t i = 0; i + 1 < size; i += 2) {
+        const int hi = nibble(hex[i]);
+        const int lo = nibble(hex[i + 1]);
+        if (hi < 0 || lo < 0) {
+            error_pos = hi < 0 ? i : i + 1;
+            return false;
+        }
+        out[i / 2] = (uint8_t) ((hi << 4) | lo);
+    }
+    return true;
+}
+
+#ifdef MINTER_HEX_X86
+
+// Nibbles 0..15 to hex chars: '0' + n, plus gap between '9' and 'a' for n > 9
+__attribute__((target("sse2")))
+inline __m128i chars_sse2(__m128i n) {
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')), letters);
+}
+
+__attribute__((target("sse2")))
+void encode_sse2(const uint8_t *data, size_t size, char *out) {
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *) (data + i));
+        const __m128i hi = chars_sse2(_mm_and_si128(_mm_srli_epi16(v, 4), low_mask));
+        const __m128i lo = chars_sse2(_mm_and_si128(v, low_mask));
+        _mm_storeu_si128((__m128i *) (out + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *) (out + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    encode_scalar(data + i, size - i, out + i * 2);
+}
+
+// Hex chars to nibbles. Comparisons are signed, so chars >= 0x80 fail both ranges
+__attribute__((target("sse2")))
+inline __m128i nibbles_sse2(__m128i c, int &valid) {
+    const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                           _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+    const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    const __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                            _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    valid = _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter));
+
+    const __m128i digits = _mm_and_si128(is_digit, _mm_sub_epi8(c, _mm_set1_epi8('0')));
+    const __m128i letters = _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+    return _mm_or_si128(digits, letters);
+}
+
+// Pairs of nibbles (high first) to bytes in low half of each 16-bit lane
+__attribute__((target("sse2")))
+inline __m128i join_sse2(__m128i n) {
+    return _mm_or_si128(_mm_and_si128(_mm_slli_epi16(n, 4), _mm_set1_epi16(0x00f0)), _mm_srli_epi16(n, 8));
+}
+
+__attribute__((target("sse2")))
+bool decode_sse2(const char *hex, size_t size, uint8_t *out, size_t &error_pos) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        int valid0, valid1;
+        const __m128i n0 = nibbles_sse2(_mm_loadu_si128((const __m128i *) (hex + i)), valid0);
+        const __m128i n1 = nibbles_sse2(_mm_loadu_si128((const __m128i *) (hex + i + 16)), valid1);
+        if ((valid0 & valid1) != 0xffff) {
+            // scalar pass finds exact position
+            break;
+        }
+        _mm_storeu_si128((__m128i *) (out + i / 2), _mm_packus_epi16(join_sse2(n0), join_sse2(n1)));
+    }
+    if (!decode_scalar(hex + i, size - i, out + i / 2, error_pos)) {
+        error_pos += i;
+        return false;
+    }
+    return true;
+}
+
+__attribute__((target("avx2")))
+inline __m256i chars_avx2(__m256i n) {
+    const __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(n, _mm256_set1_epi8(9)),
+                                             _mm256_set1_epi8('a' - '0' - 10));
+    return _mm256_add_epi8(_mm256_add_epi8(n, _mm256_set1_epi8('0')), letters);
+}
+
+__attribute__((target("avx2")))
+void encode_avx2(const uint8_t *data, size_t size, char *out) {
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *) (data + i));
+        const __m256i hi = chars_avx2(_mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+        const __m256i lo = chars_avx2(_mm256_and_si256(v, low_mask));
+        // unpack works inside 128-bit lanes: lanes hold bytes 0-7 | 16-23 and 8-15 | 24-31
+        const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i *) (out + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *) (out + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    encode_sse2(data + i, size - i, out + i * 2);
+}
+
+__attribute__((target("avx2")))
+inline __m256i nibbles_avx2(__m256i c, int &valid) {
+    const __m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                                              _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    const __m256i is_letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                               _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+    valid = _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter));
+
+    const __m256i digits = _mm256_and_si256(is_digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0')));
+    const __m256i letters = _mm256_and_si256(is_letter, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)));
+    return _mm256_or_si256(digits, letters);
+}
+
+__attribute__((target("avx2")))
+inline __m256i join_avx2(__m256i n) {
+    return _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(n, 4), _mm256_set1_epi16(0x00f0)),
+                           _mm256_srli_epi16(n, 8));
+}
+
+__attribute__((target("avx2")))
+bool decode_avx2(const char *hex, size_t size, uint8_t *out, size_t &error_pos) {
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        int valid0, valid1;
+        const __m256i n0 = nibbles_avx2(_mm256_loadu_si256((const __m256i *) (hex + i)), valid0);
+        const __m256i n1 = nibbles_avx2(_mm256_loadu_si256((const __m256i *) (hex + i + 32)), valid1);
+        if ((valid0 & valid1) != -1) {
+            break;
+        }
+        // pack works inside 128-bit lanes too: restore order of 64-bit quarters
+        const __m256i packed = _mm256_packus_epi16(join_avx2(n0), join_avx2(n1));
+        _mm256_storeu_si256((__m256i *) (out + i / 2), _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+    if (!decode_sse2(hex + i, size - i, out + i / 2, error_pos)) {
+        error_pos += i;
+        return false;
+    }
+    return true;
+}
+
+#endif // MINTER_HEX_X86
+
+const minter::hex_codec scalar_codec{"scalar", &encode_scalar, &decode_scalar};
+#ifdef MINTER_HEX_X86
+const minter::hex_codec sse2_codec{"sse2", &encode_sse2, &decode_sse2};
+const minter::hex_codec avx2_codec{"avx2", &encode_avx2, &decode_avx2};
+#endif
+
+const char *skip_prefix(const char *hex, size_t &size) {
+    if (size >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        size -= 2;
+        return hex + 2;
+    }
+    return hex;
+}
+
+}
+
+std::vector<const minter::hex_codec *> minter::hex_codec::supported() {
+    std::vector<const minter::hex_codec *> out{&scalar_codec};
+#ifdef MINTER_HEX_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        out.push_back(&sse2_codec);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        out.push_back(&avx2_codec);
+    }
+#endif
+    return out;
+}
+
+const minter::hex_codec &minter::hex_codec::get() {
+    static const minter::hex_codec &codec = *supported().back();
+    return codec;
+}
+
+void minter::hex_encode(const uint8_t *data, size_t size, char *out) {
+    minter::hex_codec::get().encode(data, size, out);
+}
+
+bool minter::hex_decode(const char *hex, size_t size, uint8_t *out, size_t &error_pos) {
+    if (size % 2 != 0) {
+        error_pos = size;
+        return false;
+    }
+    return minter::hex_codec::get().decode(hex, size, out, error_pos);
+}
+
+std::string minter::to_hex(dev::bytesConstRef data) {
+    std::string out(data.size() * 2, '\0');
+    minter::hex_encode(data.data(), data.size(), &out[0]);
+    return out;
+}
+
+std::vector<uint8_t> minter::from_hex(const char *hex, size_t size) {
+    const char *begin = skip_prefix(hex, size);
+    std::vector<uint8_t> out((size + 1) / 2);
+
+    size_t error_pos = 0;
+    size_t skipped = 0;
+    if (size % 2 != 0) {
+        const int n = nibble(begin[0]);
+        if (n < 0) {
+            throw std::runtime_error("Invalid hex string: bad char at position " +
+                std::to_string(begin - hex));
+        }
+        out[0] = (uint8_t) n;
+        skipped = 1;
+    }
+    if (!minter::hex_decode(begin + skipped, size - skipped, out.data() + skipped, error_pos)) {
+        throw std::runtime_error("Invalid hex string: bad char at position " +
+            std::to_string(begin - hex + skipped + error_pos));
+    }
+    return out;
+}
+
+std::vector<uint8_t> minter::from_hex(const char *hex) {
+    return minter::from_hex(hex, strlen(hex));
+}
+
+std::vector<uint8_t> minter::from_hex(const std::string &hex) {
+    return minter::from_hex(hex.data(), hex.size());
+}
+
+void minter::write_hex(std::ostream &out, dev::bytesConstRef data) {
+    char buf[512];
+    for (size_t i = 0; i < data.size(); i += sizeof(buf) / 2) {
+        const size_t n = std::min(sizeof(buf) / 2, data.size() - i);
+        minter::hex_encode(data.data() + i, n, buf);
+        out.write(buf, n * 2);
+    }
+}
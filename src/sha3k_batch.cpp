@@ -0,0 +1,327 @@
+/*!
+ * minter_tx.
+ * sha3k_batch.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <minter/crypto/sha3.h>
+#include "minter/tx/utils.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MINTER_SHA3K_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+void hash_scalar(const dev::bytesConstRef *messages, uint8_t *out) {
+    minter::utils::sha3k_into(messages[0].data(), messages[0].size(), out);
+}
+
+#ifdef MINTER_SHA3K_X86
+
+// Keccak-256: 136 bytes rate (17 lanes of state), 32 bytes digest
+const size_t rate = 136;
+const size_t rate_words = rate / 8;
+
+const uint64_t round_constants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+// rotation of lane x + 5y
+const int rotations[25] = {
+    0, 1, 62, 28, 27,
+    36, 44, 6, 55, 20,
+    3, 10, 43, 25, 39,
+    41, 45, 15, 21, 8,
+    18, 2, 61, 56, 14,
+};
+
+/// Blocks of one message: whole blocks are read in place, last one (with padding) is copied
+struct message_blocks {
+  const uint8_t *data = nullptr;
+  // whole blocks count; padded block goes after them
+  size_t full = 0;
+  uint8_t last[rate];
+
+  void init(dev::bytesConstRef message) {
+      data = message.data();
+      full = message.size() / rate;
+      const size_t tail = message.size() % rate;
+      memset(last, 0, rate);
+      if (tail > 0) {
+          memcpy(last, data + full * rate, tail);
+      }
+      last[tail] ^= 0x01;
+      last[rate - 1] ^= 0x80;
+  }
+
+  size_t count() const {
+      return full + 1;
+  }
+
+  // block i, nullptr after last one
+  const uint8_t *block(size_t i) const {
+      if (i < full) {
+          return data + i * rate;
+      }
+      return i == full ? last : nullptr;
+  }
+};
+
+inline uint64_t load_word(const uint8_t *block, size_t word) {
+    uint64_t out = 0;
+    if (block != nullptr) {
+        memcpy(&out, block + word * 8, 8);
+    }
+    return out;
+}
+
+// Messages are absorbed in lockstep, as many blocks as the longest one has. Digest of each message is taken
+// right after its last block, permutations of finished lanes afterwards are just wasted work.
+template<typename State>
+void hash_lanes(const dev::bytesConstRef *messages, uint8_t *out) {
+    message_blocks blocks[State::lanes];
+    size_t max_blocks = 0;
+    for (size_t l = 0; l < State::lanes; l++) {
+        blocks[l].init(messages[l]);
+        max_blocks = std::max(max_blocks, blocks[l].count());
+    }
+
+    State state;
+    for (size_t b = 0; b < max_blocks; b++) {
+        const uint8_t *block[State::lanes];
+        for (size_t l = 0; l < State::lanes; l++) {
+            block[l] = blocks[l].block(b);
+        }
+        state.absorb(block);
+        state.permute();
+
+        for (size_t l = 0; l < State::lanes; l++) {
+            if (blocks[l].count() == b + 1) {
+                state.store(l, out + l * 32);
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+inline __m256i rol_avx2(__m256i v, int n) {
+    if (n == 0) {
+        return v;
+    }
+    return _mm256_or_si256(_mm256_sll_epi64(v, _mm_cvtsi32_si128(n)), _mm256_srl_epi64(v, _mm_cvtsi32_si128(64 - n)));
+}
+
+// 4 states, one per 64-bit element of a vector
+struct avx2_state {
+  enum { lanes = 4 };
+  __m256i a[25];
+
+  __attribute__((target("avx2")))
+  avx2_state() {
+      for (auto &lane: a) {
+          lane = _mm256_setzero_si256();
+      }
+  }
+
+  __attribute__((target("avx2")))
+  void absorb(const uint8_t *const *block) {
+      for (size_t w = 0; w < rate_words; w++) {
+          const __m256i v = _mm256_set_epi64x(
+              (long long) load_word(block[3], w), (long long) load_word(block[2], w),
+              (long long) load_word(block[1], w), (long long) load_word(block[0], w));
+          a[w] = _mm256_xor_si256(a[w], v);
+      }
+  }
+
+  // loops are unrolled, so lane indexes and rotations are constants and state stays in registers
+  __attribute__((target("avx2")))
+  void permute() {
+      __m256i c[5], b[25];
+      for (int round = 0; round < 24; round++) {
+          // theta
+          #pragma GCC unroll 5
+          for (int x = 0; x < 5; x++) {
+              c[x] = _mm256_xor_si256(_mm256_xor_si256(a[x], a[x + 5]),
+                                      _mm256_xor_si256(_mm256_xor_si256(a[x + 10], a[x + 15]), a[x + 20]));
+          }
+          #pragma GCC unroll 5
+          for (int x = 0; x < 5; x++) {
+              const __m256i d = _mm256_xor_si256(c[(x + 4) % 5], rol_avx2(c[(x + 1) % 5], 1));
+              #pragma GCC unroll 5
+              for (int y = 0; y < 25; y += 5) {
+                  a[y + x] = _mm256_xor_si256(a[y + x], d);
+              }
+          }
+          // rho and pi
+          #pragma GCC unroll 5
+          for (int x = 0; x < 5; x++) {
+              #pragma GCC unroll 5
+              for (int y = 0; y < 5; y++) {
+                  b[y + 5 * ((2 * x + 3 * y) % 5)] = rol_avx2(a[x + 5 * y], rotations[x + 5 * y]);
+              }
+          }
+          // chi
+          #pragma GCC unroll 5
+          for (int y = 0; y < 25; y += 5) {
+              #pragma GCC unroll 5
+              for (int x = 0; x < 5; x++) {
+                  a[y + x] = _mm256_xor_si256(b[y + x],
+                                              _mm256_andnot_si256(b[y + (x + 1) % 5], b[y + (x + 2) % 5]));
+              }
+          }
+          // iota
+          a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x((long long) round_constants[round]));
+      }
+  }
+
+  __attribute__((target("avx2")))
+  void store(size_t lane, uint8_t *digest) const {
+      uint64_t words[4];
+      for (size_t w = 0; w < 4; w++) {
+          _mm256_storeu_si256((__m256i *) words, a[w]);
+          memcpy(digest + w * 8, &words[lane], 8);
+      }
+  }
+};
+
+// 8 states, one per 64-bit element of a vector
+struct avx512_state {
+  enum { lanes = 8 };
+  __m512i a[25];
+
+  __attribute__((target("avx512f")))
+  avx512_state() {
+      for (auto &lane: a) {
+          lane = _mm512_setzero_si512();
+      }
+  }
+
+  __attribute__((target("avx512f")))
+  void absorb(const uint8_t *const *block) {
+      for (size_t w = 0; w < rate_words; w++) {
+          const __m512i v = _mm512_set_epi64(
+              (long long) load_word(block[7], w), (long long) load_word(block[6], w),
+              (long long) load_word(block[5], w), (long long) load_word(block[4], w),
+              (long long) load_word(block[3], w), (long long) load_word(block[2], w),
+              (long long) load_word(block[1], w), (long long) load_word(block[0], w));
+          a[w] = _mm512_xor_si512(a[w], v);
+      }
+  }
+
+  __attribute__((target("avx512f")))
+  void permute() {
+      __m512i c[5], b[25];
+      for (int round = 0; round < 24; round++) {
+          #pragma GCC unroll 5
+          for (int x = 0; x < 5; x++) {
+              c[x] = _mm512_xor_si512(_mm512_xor_si512(a[x], a[x + 5]),
+                                      _mm512_xor_si512(_mm512_xor_si512(a[x + 10], a[x + 15]), a[x + 20]));
+          }
+          #pragma GCC unroll 5
+          for (int x = 0; x < 5; x++) {
+              const __m512i d = _mm512_xor_si512(c[(x + 4) % 5], _mm512_rol_epi64(c[(x + 1) % 5], 1));
+              #pragma GCC unroll 5
+              for (int y = 0; y < 25; y += 5) {
+                  a[y + x] = _mm512_xor_si512(a[y + x], d);
+              }
+          }
+          #pragma GCC unroll 5
+          for (int x = 0; x < 5; x++) {
+              #pragma GCC unroll 5
+              for (int y = 0; y < 5; y++) {
+                  b[y + 5 * ((2 * x + 3 * y) % 5)] =
+                      _mm512_rolv_epi64(a[x + 5 * y], _mm512_set1_epi64(rotations[x + 5 * y]));
+              }
+          }
+          #pragma GCC unroll 5
+          for (int y = 0; y < 25; y += 5) {
+              #pragma GCC unroll 5
+              for (int x = 0; x < 5; x++) {
+                  a[y + x] = _mm512_xor_si512(b[y + x],
+                                              _mm512_andnot_si512(b[y + (x + 1) % 5], b[y + (x + 2) % 5]));
+              }
+          }
+          a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64((long long) round_constants[round]));
+      }
+  }
+
+  __attribute__((target("avx512f")))
+  void store(size_t lane, uint8_t *digest) const {
+      uint64_t words[8];
+      for (size_t w = 0; w < 4; w++) {
+          _mm512_storeu_si512(words, a[w]);
+          memcpy(digest + w * 8, &words[lane], 8);
+      }
+  }
+};
+
+void hash_avx2(const dev::bytesConstRef *messages, uint8_t *out) {
+    hash_lanes<avx2_state>(messages, out);
+}
+
+void hash_avx512(const dev::bytesConstRef *messages, uint8_t *out) {
+    hash_lanes<avx512_state>(messages, out);
+}
+
+#endif // MINTER_SHA3K_X86
+
+const minter::utils::sha3k_kernel scalar_kernel{"scalar", 1, &hash_scalar};
+#ifdef MINTER_SHA3K_X86
+const minter::utils::sha3k_kernel avx2_kernel{"avx2", 4, &hash_avx2};
+const minter::utils::sha3k_kernel avx512_kernel{"avx512", 8, &hash_avx512};
+#endif
+
+}
+
+std::vector<const minter::utils::sha3k_kernel *> minter::utils::sha3k_kernel::supported() {
+    std::vector<const minter::utils::sha3k_kernel *> out{&scalar_kernel};
+#ifdef MINTER_SHA3K_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        out.push_back(&avx2_kernel);
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        out.push_back(&avx512_kernel);
+    }
+#endif
+    return out;
+}
+
+const minter::utils::sha3k_kernel &minter::utils::sha3k_kernel::get() {
+    static const minter::utils::sha3k_kernel &kernel = *supported().back();
+    return kernel;
+}
+
+void minter::utils::sha3k_batch(const dev::bytesConstRef *messages, size_t count, uint8_t *out) {
+    const minter::utils::sha3k_kernel &kernel = minter::utils::sha3k_kernel::get();
+    size_t i = 0;
+    for (; i + kernel.lanes <= count; i += kernel.lanes) {
+        kernel.hash(messages + i, out + i * 32);
+    }
+    if (i == count) {
+        return;
+    }
+
+    if (count - i == 1) {
+        sha3k_into(messages[i].data(), messages[i].size(), out + i * 32);
+        return;
+    }
+    // rest of messages with empty ones in place of missing lanes
+    dev::bytesConstRef rest[8];
+    uint8_t rest_out[8 * 32];
+    std::copy(messages + i, messages + count, rest);
+    kernel.hash(rest, rest_out);
+    memcpy(out + i * 32, rest_out, (count - i) * 32);
+}
@@ -0,0 +1,46 @@
+/*!
+ * minter_tx.
+ * decode_status.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "minter/tx/decode_status.h"
+
+const char *minter::decode_status::message() const {
+    switch (error) {
+        case decode_error::none: return "ok";
+        case decode_error::truncated: return "RLP item is truncated";
+        case decode_error::non_canonical_rlp: return "RLP item length is not canonical";
+        case decode_error::oversize: return "Unexpected data after RLP item";
+        case decode_error::too_deep: return "RLP lists are nested too deep";
+        case decode_error::list_expected: return "RLP list expected";
+        case decode_error::string_expected: return "RLP string expected";
+        case decode_error::invalid_field_count: return "Invalid fields count";
+        case decode_error::non_canonical_int: return "Integer has leading zeroes";
+        case decode_error::int_too_big: return "Integer is too big";
+        case decode_error::invalid_length: return "Field has invalid length";
+        case decode_error::unknown_type: return "Unknown transaction type";
+        case decode_error::invalid_data: return "Invalid transaction data";
+    }
+    return "unknown error";
+}
+
+minter::decode_error minter::to_decode_error(dev::RLPError error) {
+    switch (error) {
+        case dev::RLPError::None: return decode_error::none;
+        case dev::RLPError::Truncated: return decode_error::truncated;
+        case dev::RLPError::NonCanonical: return decode_error::non_canonical_rlp;
+        case dev::RLPError::Oversize: return decode_error::oversize;
+        case dev::RLPError::TooDeep: return decode_error::too_deep;
+    }
+    return decode_error::invalid_data;
+}
+
+minter::decode_status minter::validate_rlp(dev::bytesConstRef data) {
+    size_t offset = 0;
+    const dev::RLPError error = dev::rlpValidate(data, offset);
+    return minter::decode_status(to_decode_error(error), offset);
+}
@@ -0,0 +1,197 @@
+/*!
+ * minter_tx.
+ * nonce_allocator.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <stdexcept>
+#include "minter/tx/nonce_allocator.h"
+
+namespace {
+
+inline bool same_epoch(uint64_t a, uint64_t b, unsigned nonce_bits) {
+    return (a >> nonce_bits) == (b >> nonce_bits);
+}
+
+}
+
+// reservation
+minter::nonce_allocator::reservation::reservation(minter::nonce_allocator *owner, uint64_t ticket) :
+    m_owner(owner),
+    m_ticket(ticket) {
+}
+
+minter::nonce_allocator::reservation::reservation(minter::nonce_allocator::reservation &&other) noexcept :
+    m_owner(other.m_owner),
+    m_ticket(other.m_ticket) {
+    other.m_owner = nullptr;
+}
+
+minter::nonce_allocator::reservation &minter::nonce_allocator::reservation::operator=(
+    minter::nonce_allocator::reservation &&other) noexcept {
+    if (this != &other) {
+        release();
+        m_owner = other.m_owner;
+        m_ticket = other.m_ticket;
+        other.m_owner = nullptr;
+    }
+    return *this;
+}
+
+minter::nonce_allocator::reservation::~reservation() {
+    release();
+}
+
+bool minter::nonce_allocator::reservation::valid() const noexcept {
+    return m_owner != nullptr;
+}
+
+uint64_t minter::nonce_allocator::reservation::nonce() const noexcept {
+    return m_ticket & minter::nonce_allocator::nonce_mask;
+}
+
+void minter::nonce_allocator::reservation::commit() noexcept {
+    m_owner = nullptr;
+}
+
+bool minter::nonce_allocator::reservation::release() noexcept {
+    if (m_owner == nullptr) {
+        return false;
+    }
+    minter::nonce_allocator *owner = m_owner;
+    m_owner = nullptr;
+    return owner->release(m_ticket);
+}
+
+// allocator
+minter::nonce_allocator::nonce_allocator(uint64_t next_nonce, size_t release_slots) :
+    m_next(next_nonce),
+    m_slots(new std::atomic<uint64_t>[release_slots]),
+    m_slots_count(release_slots),
+    m_released(0) {
+    if (next_nonce > nonce_mask) {
+        throw std::runtime_error("Nonce is too big");
+    }
+    for (size_t i = 0; i < m_slots_count; i++) {
+        m_slots[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+minter::nonce_allocator::reservation minter::nonce_allocator::reserve() {
+    uint64_t ticket;
+    if (!take_released(ticket)) {
+        ticket = m_next.fetch_add(1, std::memory_order_acq_rel);
+    }
+    return reservation(this, ticket);
+}
+
+void minter::nonce_allocator::resync(uint64_t next_nonce) {
+    if (next_nonce > nonce_mask) {
+        throw std::runtime_error("Nonce is too big");
+    }
+    uint64_t current = m_next.load(std::memory_order_acquire);
+    uint64_t updated;
+    do {
+        updated = (((current >> nonce_bits) + 1) << nonce_bits) | next_nonce;
+    } while (!m_next.compare_exchange_weak(current, updated, std::memory_order_acq_rel));
+
+    for (size_t i = 0; i < m_slots_count; i++) {
+        if (m_slots[i].exchange(0, std::memory_order_acq_rel) != 0) {
+            m_released.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t minter::nonce_allocator::next() const noexcept {
+    return m_next.load(std::memory_order_acquire) & nonce_mask;
+}
+
+size_t minter::nonce_allocator::released() const noexcept {
+    return m_released.load(std::memory_order_acquire);
+}
+
+bool minter::nonce_allocator::release(uint64_t ticket) noexcept {
+    uint64_t current = m_next.load(std::memory_order_acquire);
+    if (!same_epoch(ticket, current, nonce_bits)) {
+        return false;
+    }
+    // last handed out nonce: just step back
+    uint64_t expected = ticket + 1;
+    if (m_next.compare_exchange_strong(expected, ticket, std::memory_order_acq_rel)) {
+        return true;
+    }
+
+    // counted before it's published, so take_released() never decrements counter below zero
+    m_released.fetch_add(1, std::memory_order_acq_rel);
+    for (size_t i = 0; i < m_slots_count; i++) {
+        uint64_t empty = 0;
+        if (m_slots[i].compare_exchange_strong(empty, ticket + 1, std::memory_order_acq_rel)) {
+            return true;
+        }
+    }
+    m_released.fetch_sub(1, std::memory_order_acq_rel);
+    // nonce is lost until resync()
+    return false;
+}
+
+bool minter::nonce_allocator::take_released(uint64_t &ticket) noexcept {
+    while (m_released.load(std::memory_order_acquire) > 0) {
+        const uint64_t current = m_next.load(std::memory_order_acquire);
+        size_t lowest = m_slots_count;
+        uint64_t lowest_value = 0;
+        for (size_t i = 0; i < m_slots_count; i++) {
+            uint64_t value = m_slots[i].load(std::memory_order_acquire);
+            if (value == 0) {
+                continue;
+            }
+            if (!same_epoch(value - 1, current, nonce_bits)) {
+                // released before resync()
+                if (m_slots[i].compare_exchange_strong(value, 0, std::memory_order_acq_rel)) {
+                    m_released.fetch_sub(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+            if (lowest == m_slots_count || value < lowest_value) {
+                lowest = i;
+                lowest_value = value;
+            }
+        }
+        if (lowest == m_slots_count) {
+            return false;
+        }
+        // somebody took it first: look again
+        if (!m_slots[lowest].compare_exchange_strong(lowest_value, 0, std::memory_order_acq_rel)) {
+            continue;
+        }
+        m_released.fetch_sub(1, std::memory_order_relaxed);
+        if (!same_epoch(lowest_value - 1, m_next.load(std::memory_order_acquire), nonce_bits)) {
+            // resync() happened meanwhile
+            continue;
+        }
+        ticket = lowest_value - 1;
+        return true;
+    }
+    return false;
+}
+
+// registry
+minter::nonce_allocator &minter::nonce_registry::get(const minter::address_t &address, uint64_t next_nonce) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto &allocator = m_allocators[address];
+    if (!allocator) {
+        allocator.reset(new minter::nonce_allocator(next_nonce));
+    }
+    return *allocator;
+}
+
+minter::nonce_allocator *minter::nonce_registry::find(const minter::address_t &address) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_allocators.find(address);
+    if (it == m_allocators.end()) {
+        return nullptr;
+    }
+    return it->second.get();
+}
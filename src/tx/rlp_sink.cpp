@@ -0,0 +1,85 @@
+/*!
+ * minter_tx.
+ * rlp_sink.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <stdexcept>
+#include "minter/tx/rlp_sink.h"
+
+// header: prefix byte + up to 8 bytes of length
+static const size_t max_header_size = 1 + sizeof(size_t);
+
+minter::rlp_sink &minter::rlp_sink::append_list(size_t payload_size) {
+    uint8_t header[max_header_size];
+    write(header, dev::rlpWriteHeader(header, payload_size, true));
+    return *this;
+}
+
+minter::rlp_sink &minter::rlp_sink::append(dev::bytesConstRef data) {
+    if (data.size() == 1 && data[0] < dev::c_rlpDataImmLenStart) {
+        write(data.data(), 1);
+        return *this;
+    }
+
+    uint8_t header[max_header_size];
+    write(header, dev::rlpWriteHeader(header, data.size(), false));
+    if (!data.empty()) {
+        write(data.data(), data.size());
+    }
+    return *this;
+}
+
+minter::rlp_sink &minter::rlp_sink::append(const dev::bigint &value) {
+    // enough for u256 values, which all transaction integers are
+    uint8_t buf[max_header_size + 32];
+    const size_t size = dev::rlpItemSize(value);
+    if (size <= sizeof(buf)) {
+        write(buf, dev::rlpWriteItem(buf, value));
+        return *this;
+    }
+
+    dev::bytes tmp(size);
+    write(tmp.data(), dev::rlpWriteItem(tmp.data(), value));
+    return *this;
+}
+
+minter::rlp_sink &minter::rlp_sink::append_raw(dev::bytesConstRef encoded) {
+    write(encoded.data(), encoded.size());
+    return *this;
+}
+
+minter::rlp_buffer_sink::rlp_buffer_sink(dev::bytes &out) :
+    m_out(out) {
+}
+
+void minter::rlp_buffer_sink::write(const uint8_t *data, size_t size) {
+    m_out.insert(m_out.end(), data, data + size);
+}
+
+minter::rlp_hash_sink::rlp_hash_sink() {
+    keccak_256_Init(&m_ctx);
+}
+
+void minter::rlp_hash_sink::write(const uint8_t *data, size_t size) {
+    keccak_Update(&m_ctx, data, size);
+}
+
+void minter::rlp_hash_sink::finish(uint8_t *out) {
+    keccak_Final(&m_ctx, out);
+    keccak_256_Init(&m_ctx);
+}
+
+minter::rlp_stream_sink::rlp_stream_sink(std::ostream &out) :
+    m_out(out) {
+}
+
+void minter::rlp_stream_sink::write(const uint8_t *data, size_t size) {
+    m_out.write((const char *) data, size);
+    if (!m_out) {
+        throw std::runtime_error("Can't write RLP to stream");
+    }
+}
@@ -26,6 +26,10 @@ dev::bytes minter::signature_single_data::encode() {
     return out.out();
 }
 
+size_t minter::signature_single_data::encoded_size() const {
+    return dev::rlpListSize(dev::rlpItemSize(m_v) + dev::rlpItemSize(m_r) + dev::rlpItemSize(m_s));
+}
+
 void minter::signature_single_data::decode(const dev::RLP &data) {
     m_v = (dev::bytes)data[0];
     m_r = (dev::bytes)data[1];
@@ -121,12 +125,22 @@ dev::bytes minter::signature_multi_data::encode() {
     }
 
     dev::RLPStream out;
+    out.appendList(2);
     out.append(m_address.get());
     out.appendList(signList);
 
     return out.out();
 }
 
+size_t minter::signature_multi_data::encoded_size() const {
+    size_t signs_size = 0;
+    for (const auto &item: m_signs) {
+        signs_size += item.encoded_size();
+    }
+
+    return dev::rlpListSize(dev::rlpItemSize(m_address.get()) + dev::rlpListSize(signs_size));
+}
+
 minter::signature_multi_data &minter::signature_multi_data::set_signatures(const minter::data::address &address,
                                                                            std::vector<minter::signature_single_data> &&signs) {
     m_address = address;
@@ -135,7 +149,23 @@ minter::signature_multi_data &minter::signature_multi_data::set_signatures(const
     return *this;
 }
 
+const minter::data::address &minter::signature_multi_data::get_address() const {
+    return m_address;
+}
+
+const std::vector<minter::signature_single_data> &minter::signature_multi_data::get_signs() const {
+    return m_signs;
+}
+
 void minter::signature_multi_data::decode(const dev::RLP &data) {
-    dev::RLPStream out;
-//    m_address = (dev::b)
+    m_address = minter::data::address(data[0].toBytes());
+
+    const dev::RLP signs = data[1];
+    m_signs.clear();
+    m_signs.reserve(signs.itemCount());
+    for (const auto &item: signs) {
+        minter::signature_single_data sign;
+        sign.decode(item);
+        m_signs.push_back(std::move(sign));
+    }
 }
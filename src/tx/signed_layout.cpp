@@ -0,0 +1,50 @@
+/*!
+ * minter_tx.
+ * signed_layout.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "minter/tx/signed_layout.h"
+
+// v (1 byte) + r (32 bytes) + s (32 bytes)
+static const size_t signature_payload_size = 1 + dev::rlpDataSize(32) * 2;
+
+const size_t minter::single_signed_layout::signature_size = dev::rlpListSize(signature_payload_size);
+
+minter::single_signed_layout::single_signed_layout(size_t fields) :
+    m_fields(fields),
+    m_payload_size(fields + dev::rlpDataSize(signature_size)) {
+}
+
+size_t minter::single_signed_layout::size() const {
+    return dev::rlpListSize(m_payload_size);
+}
+
+size_t minter::single_signed_layout::fields_offset() const {
+    return size() - m_payload_size;
+}
+
+dev::bytesConstRef minter::single_signed_layout::write_unsigned_header(dev::bytesRef out) const {
+    const size_t header_size = dev::rlpListSize(m_fields) - m_fields;
+    uint8_t *begin = out.data() + fields_offset() - header_size;
+    dev::rlpWriteHeader(begin, m_fields, true);
+    return dev::bytesConstRef(begin, header_size + m_fields);
+}
+
+dev::bytesConstRef minter::single_signed_layout::write_signature(dev::bytesRef out,
+                                                                 const minter::fixed_signature &sig) const {
+    // overwrites unsigned list header
+    dev::rlpWriteHeader(out.data(), m_payload_size, true);
+
+    uint8_t *p = out.data() + fields_offset() + m_fields;
+    p += dev::rlpWriteHeader(p, signature_size, false);
+    uint8_t *signature_begin = p;
+    p += dev::rlpWriteHeader(p, signature_payload_size, true);
+    p += dev::rlpWriteItem(p, dev::bytesConstRef(sig.v, sizeof(sig.v)));
+    p += dev::rlpWriteItem(p, dev::bytesConstRef(sig.r, sizeof(sig.r)));
+    dev::rlpWriteItem(p, dev::bytesConstRef(sig.s, sizeof(sig.s)));
+    return dev::bytesConstRef(signature_begin, signature_size);
+}
@@ -10,13 +10,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <thread>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <secp256k1/include/secp256k1.h>
 #include <secp256k1/include/secp256k1_recovery.h>
 #include <secp256k1/include/secp256k1_ecdh.h>
 #include <minter/tx/secp256k1_raii.h>
+#include <minter/crypto/sha2.h>
 
 #include "minter/tx/tx.h"
+#include "minter/hex.h"
 #include "minter/tx/utils.h"
 #include "minter/tx/tx_send_coin.h"
 #include "minter/tx/tx_sell_coin.h"
@@ -42,8 +46,8 @@ minter::tx::tx() :
     m_chain_id(dev::bigint(chain_id::testnet)),
     m_gas_price(dev::bigint("1")),
     m_gas_coin("MNT"),
-    m_payload(dev::bytes(0)),
-    m_service_data(dev::bytes(0)) {
+    m_data_pending(false),
+    m_hash_ready(false) {
 
 }
 
@@ -52,92 +56,322 @@ std::shared_ptr<minter::tx> minter::tx::create() {
 }
 
 std::shared_ptr<minter::tx> minter::tx::decode(const dev::bytes &tx) {
-    dev::RLP s(tx);
+    const dev::bytesConstRef data(&tx);
+    const minter::decode_status status = validate(data);
+    if (!status) {
+        throw std::runtime_error(
+            std::string("Invalid transaction: ") + status.message() + " at offset " + std::to_string(status.offset));
+    }
+
+    return decode_validated(data);
+}
+
+minter::decode_status minter::tx::try_decode(dev::bytesConstRef data, std::shared_ptr<minter::tx> &out) {
+    const minter::decode_status status = validate(data);
+    if (!status) {
+        return status;
+    }
+
+    out = decode_validated(data);
+    return status;
+}
+
+namespace {
+
+bool check_uint(const dev::RLP &rlp, size_t max_bytes, minter::decode_context &ctx) {
+    if (!minter::rlp_codec<dev::bigint>::check(rlp, ctx)) {
+        return false;
+    }
+    return rlp.size() <= max_bytes || ctx.fail(minter::decode_error::int_too_big, rlp);
+}
+
+// list of exactly 3 items: v, r, s
+bool check_single_signature(const dev::RLP &rlp, minter::decode_context &ctx) {
+    if (!rlp.isList()) {
+        return ctx.fail(minter::decode_error::list_expected, rlp);
+    }
+
+    size_t n = 0;
+    for (const auto &item: rlp) {
+        if (n == 3) {
+            return ctx.fail(minter::decode_error::invalid_field_count, rlp);
+        }
+        if (!item.isData()) {
+            return ctx.fail(minter::decode_error::string_expected, item);
+        }
+        // v is one byte at most, r and s are always 32 bytes wide
+        const bool valid_size = n == 0 ? item.size() <= 1 : item.size() == 32;
+        if (!valid_size) {
+            return ctx.fail(minter::decode_error::invalid_length, item);
+        }
+        n++;
+    }
+    return n == 3 || ctx.fail(minter::decode_error::invalid_field_count, rlp);
+}
+
+minter::decode_status validate_single_signature(dev::bytesConstRef data) {
+    minter::decode_status status = minter::validate_rlp(data);
+    if (!status) {
+        return status;
+    }
+
+    const dev::RLP rlp(data);
+    minter::decode_context ctx(rlp);
+    check_single_signature(rlp, ctx);
+    return ctx.status;
+}
+
+// list of multisig address and list of single signatures: [address, [[v, r, s], ...]]
+bool check_multi_signature(const dev::RLP &rlp, minter::decode_context &ctx) {
+    if (!rlp.isList()) {
+        return ctx.fail(minter::decode_error::list_expected, rlp);
+    }
+
+    dev::RLP fields[2];
+    size_t n = 0;
+    for (const auto &item: rlp) {
+        if (n == 2) {
+            return ctx.fail(minter::decode_error::invalid_field_count, rlp);
+        }
+        fields[n++] = item;
+    }
+    if (n != 2) {
+        return ctx.fail(minter::decode_error::invalid_field_count, rlp);
+    }
+    if (!minter::rlp_codec<minter::data::address>::check(fields[0], ctx)) {
+        return false;
+    }
+    if (!fields[1].isList()) {
+        return ctx.fail(minter::decode_error::list_expected, fields[1]);
+    }
+    for (const auto &item: fields[1]) {
+        if (!check_single_signature(item, ctx)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+minter::decode_status validate_multi_signature(dev::bytesConstRef data) {
+    minter::decode_status status = minter::validate_rlp(data);
+    if (!status) {
+        return status;
+    }
+
+    const dev::RLP rlp(data);
+    minter::decode_context ctx(rlp);
+    check_multi_signature(rlp, ctx);
+    return ctx.status;
+}
+
+}
+
+minter::decode_status minter::tx::validate(dev::bytesConstRef data) {
+    // whole structure is checked at once, so no item below can point outside of data
+    minter::decode_status status = minter::validate_rlp(data);
+    if (!status) {
+        return status;
+    }
+
+    const dev::RLP s(data);
+    minter::decode_context ctx(s);
+    if (!s.isList()) {
+        ctx.fail(minter::decode_error::list_expected, s);
+        return ctx.status;
+    }
+
+    dev::RLP fields[10];
+    size_t n = 0;
+    for (const auto &item: s) {
+        if (n == 10) {
+            ctx.fail(minter::decode_error::invalid_field_count, s);
+            return ctx.status;
+        }
+        if (!item.isData()) {
+            ctx.fail(minter::decode_error::string_expected, item);
+            return ctx.status;
+        }
+        fields[n++] = item;
+    }
+    if (n != 10) {
+        ctx.fail(minter::decode_error::invalid_field_count, s);
+        return ctx.status;
+    }
 
-    if (s.itemCount() != 10) {
-        throw std::runtime_error("Invalid RLP length: required 10 elements");
+    const bool ok = minter::rlp_codec<dev::bigint>::check(fields[0], ctx) &&
+        check_uint(fields[1], 1, ctx) &&
+        minter::rlp_codec<dev::bigint>::check(fields[2], ctx) &&
+        minter::rlp_codec<minter::coin_symbol>::check(fields[3], ctx) &&
+        check_uint(fields[4], 2, ctx) &&
+        check_uint(fields[8], 1, ctx);
+    if (!ok) {
+        return ctx.status;
+    }
+
+    const minter::tx_type_info *info = minter::tx_type_registry::find(fields[4].toInt<uint16_t>());
+    if (info == nullptr) {
+        ctx.fail(minter::decode_error::unknown_type, fields[4]);
+        return ctx.status;
+    }
+
+    // data and signature are nested RLP, stored as strings
+    const dev::bytesConstRef encoded_data = fields[5].payload();
+    if (info->validate != nullptr) {
+        status = info->validate(encoded_data);
+    } else {
+        status = minter::validate_rlp(encoded_data);
+    }
+    if (!status) {
+        return status.shifted((size_t) (encoded_data.data() - data.data()));
     }
 
+    const dev::bytesConstRef encoded_signature = fields[9].payload();
+    status = validate_signature(fields[8].toInt<uint8_t>(), encoded_signature);
+    return status.shifted((size_t) (encoded_signature.data() - data.data()));
+}
+
+minter::decode_status minter::tx::validate_signature(uint8_t signature_type, dev::bytesConstRef data) {
+    if (signature_type == minter::signature_type::single) {
+        return validate_single_signature(data);
+    } else if (signature_type == minter::signature_type::multi) {
+        return validate_multi_signature(data);
+    }
+    return minter::decode_status();
+}
+
+std::shared_ptr<minter::tx> minter::tx::decode_validated(dev::bytesConstRef data) {
+    dev::RLP s(data);
     auto out = create();
 
     out->m_nonce = (dev::bigint) s[0];
     out->m_chain_id = (dev::bigint) s[1];
     out->m_gas_price = (dev::bigint) s[2];
-    out->m_gas_coin = minter::utils::to_string_clear((dev::bytes) s[3]);
+    out->m_gas_coin = minter::coin_symbol(s[3].toBytesConstRef());
     out->m_type = (dev::bigint) s[4];
 
-    out->m_data = (dev::bytes) s[5];
-    out->create_data_from_type();
+    // typed data is created on first get_data()
+    out->m_data = s[5].toBytesConstRef();
+    out->m_data_pending.store(true, std::memory_order_release);
 
-    out->m_payload = (dev::bytes) s[6];
-    out->m_service_data = (dev::bytes) s[7];
+    out->m_payload = s[6].toBytesConstRef();
+    out->m_service_data = s[7].toBytesConstRef();
     out->m_signature_type = (dev::bigint) s[8];
 
     if (out->m_signature_type == minter::signature_type::single) {
         out->m_signature = std::make_shared<minter::signature_single_data>();
-        const dev::bytes b = (dev::bytes) s[9];
-        dev::RLP inn(b);
-        dev::RLP sdata = s[9];
-        out->m_signature->decode(inn);
+        out->m_signature->decode(dev::RLP(s[9].toBytesConstRef()));
     } else if (out->m_signature_type == minter::signature_type::multi) {
         out->m_signature = std::make_shared<minter::signature_multi_data>();
-        const dev::bytes b = (dev::bytes) s[9];
-        dev::RLP inn(b);
-        dev::RLP sdata = s[9];
-        out->m_signature->decode(inn);
+        out->m_signature->decode(dev::RLP(s[9].toBytesConstRef()));
     }
 
     return out;
 }
 
 std::shared_ptr<minter::tx> minter::tx::decode(const char *hexEncoded) {
-    return decode(minter::Data(hexEncoded).get());
+    return decode(minter::from_hex(hexEncoded));
 }
 
-/// \todo make static map, remove switch-case
 void minter::tx::create_data_from_type() {
+    const minter::tx_type_info *info = minter::tx_type_registry::find(get_type());
+    if (info != nullptr) {
+        m_data_raw = info->create(shared_from_this(), get_data_raw());
+    }
+
+    if (m_data_raw) {
+        // data is attached, transaction owns it now
+        m_data_raw->m_tx_owner.reset();
+    }
+
+}
+
+minter::hash_t minter::tx::hash(dev::bytesConstRef encoded) {
+    dev::bytes out(SHA256_DIGEST_LENGTH);
+    sha256_Raw(encoded.data(), encoded.size(), out.data());
+    return minter::hash_t(std::move(out));
+}
 
-    // sadly, can't use switch-case on non constexpr type() function, and type can't be constexpr
-    if (get_type() == minter::tx_send_coin_type::type()) {
-        m_data_raw = minter::tx_send_coin_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_sell_coin_type::type()) {
-        m_data_raw = minter::tx_sell_coin_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_sell_all_coins_type::type()) {
-        m_data_raw = minter::tx_sell_all_coins_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_buy_coin_type::type()) {
-        m_data_raw = minter::tx_buy_coin_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_create_coin_type::type()) {
-        m_data_raw = minter::tx_create_coin_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_declare_candidacy_type::type()) {
-        m_data_raw = minter::tx_declare_candidacy_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_delegate_type::type()) {
-        m_data_raw = minter::tx_delegate_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_unbond_type::type()) {
-        m_data_raw = minter::tx_unbond_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_redeem_check_type::type()) {
-        m_data_raw = minter::tx_redeem_check_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_set_candidate_on_type::type()) {
-        m_data_raw = minter::tx_set_candidate_on_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_set_candidate_off_type::type()) {
-        m_data_raw = minter::tx_set_candidate_off_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_create_multisig_address_type::type()) {
-        m_data_raw = minter::tx_create_multisig_address_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_multisend_type::type()) {
-        m_data_raw = minter::tx_multisend_type::create(shared_from_this(), get_data_raw());
-    } else if (get_type() == minter::tx_edit_candidate_type::type()) {
-        m_data_raw = minter::tx_edit_candidate_type::create(shared_from_this(), get_data_raw());
+std::vector<minter::hash_t> minter::tx::hash_batch(const std::vector<dev::bytesConstRef> &encoded, size_t threads) {
+    // thread start costs more than hashing of a few hundreds of transactions
+    const size_t min_per_thread = 256;
+
+    std::vector<minter::hash_t> out(encoded.size());
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min(threads, encoded.size() / min_per_thread));
+
+    auto hash_range = [&encoded, &out](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            out[i] = hash(encoded[i]);
+        }
+    };
+
+    const size_t per_thread = (encoded.size() + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; t++) {
+        workers.emplace_back(hash_range, std::min(t * per_thread, encoded.size()),
+                             std::min((t + 1) * per_thread, encoded.size()));
+    }
+    // first range on calling thread
+    hash_range(0, std::min(per_thread, encoded.size()));
+    for (auto &w: workers) {
+        w.join();
+    }
+    return out;
+}
+
+std::vector<minter::hash_t> minter::tx::hash_batch(const std::vector<dev::bytes> &encoded, size_t threads) {
+    std::vector<dev::bytesConstRef> refs;
+    refs.reserve(encoded.size());
+    for (const auto &item: encoded) {
+        refs.emplace_back(&item);
+    }
+    return hash_batch(refs, threads);
+}
+
+minter::hash_t minter::tx::get_hash() const {
+    if (!m_hash_ready.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_data_lock);
+        if (!m_hash_ready.load(std::memory_order_relaxed)) {
+            if (!m_signature) {
+                throw std::runtime_error("Transaction is not signed");
+            }
+            const dev::bytes encoded = const_cast<minter::tx *>(this)->encode(false);
+            sha256_Raw(encoded.data(), encoded.size(), m_hash.data());
+            m_hash_ready.store(true, std::memory_order_release);
+        }
     }
+    return minter::hash_t(dev::bytes(m_hash.begin(), m_hash.end()));
+}
 
+void minter::tx::reset_hash() {
+    m_hash_ready.store(false, std::memory_order_release);
+}
+
+const std::shared_ptr<minter::tx_data> &minter::tx::get_data_object() const {
+    if (m_data_pending.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_data_lock);
+        if (m_data_pending.load(std::memory_order_relaxed)) {
+            const_cast<minter::tx *>(this)->create_data_from_type();
+            m_data_pending.store(false, std::memory_order_release);
+        }
+    }
+    return m_data_raw;
 }
 
 minter::Data minter::tx::sign_single(const minter::data::private_key &pk) {
     m_signature_type = minter::signature_type::single;
 
-    minter::Data raw_tx_data = minter::Data(encode(true));
-    minter::Data32 hash(minter::utils::sha3k(raw_tx_data));
+    // unsigned transaction is hashed as it is encoded, without building it
+    dev::bytes hash(32);
+    minter::rlp_hash_sink hasher;
+    encode_to(hasher, minter::tx_encoding::unsigned_data);
+    hasher.finish(hash.data());
 
     minter::secp256k1_raii secp;
-    auto sig = sign_with_private(secp, hash.get(), pk.get());
+    auto sig = sign_with_private(secp, hash, pk.get());
 
     if (!sig.success) {
         return minter::Data("0x0");
@@ -146,6 +380,7 @@ minter::Data minter::tx::sign_single(const minter::data::private_key &pk) {
     std::shared_ptr<minter::signature_single_data> sig_data = std::make_shared<minter::signature_single_data>();
     sig_data->set_signature(sig);
     m_signature = std::move(sig_data);
+    reset_hash();
 
     return minter::Data(encode(false));
 }
@@ -153,12 +388,29 @@ minter::Data minter::tx::sign_single(const minter::data::private_key &pk) {
 minter::signature minter::tx::sign_with_private(const minter::secp256k1_raii &ctx,
                                                 const dev::bytes &hash,
                                                 const dev::bytes &pk) {
+    minter::signature outSig;
+    const minter::fixed_signature sig = sign_with_private(ctx, hash.data(), pk.data());
+    if (!sig.success) {
+        return outSig;
+    }
+
+    outSig.r = dev::bytes(sig.r, sig.r + 32);
+    outSig.s = dev::bytes(sig.s, sig.s + 32);
+    outSig.v = dev::bytes(sig.v, sig.v + 1);
+    outSig.success = true;
+
+    return outSig;
+}
+
+minter::fixed_signature minter::tx::sign_with_private(const minter::secp256k1_raii &ctx,
+                                                      const uint8_t *hash,
+                                                      const uint8_t *pk) {
     secp256k1_ecdsa_recoverable_signature sig;
 
-    int ret = secp256k1_ecdsa_sign_recoverable(ctx.get(), &sig, &hash[0], &pk[0], NULL, NULL);
+    int ret = secp256k1_ecdsa_sign_recoverable(ctx.get(), &sig, hash, pk, NULL, NULL);
 
     uint8_t outputSer[65];
-    minter::signature outSig;
+    minter::fixed_signature outSig;
     int recoveryId = 0;
 
     if (ret) {
@@ -172,46 +424,81 @@ minter::signature minter::tx::sign_with_private(const minter::secp256k1_raii &ct
         return outSig;
     }
 
-    uint8_t r[32], s[32], v[1];
-    memcpy(r, outputSer + 0, 32);
-    memcpy(s, outputSer + 32, 32);
-    v[0] = outputSer[64];
+    memcpy(outSig.r, outputSer + 0, 32);
+    memcpy(outSig.s, outputSer + 32, 32);
+    outSig.v[0] = outputSer[64];
     memset(outputSer, 0, 65);
-
-    outSig.r = dev::bytes(r, r + 32);
-    outSig.s = dev::bytes(s, s + 32);
-    outSig.v = dev::bytes(v, v + 1);
     outSig.success = true;
 
     return outSig;
 }
 
 dev::bytes minter::tx::encode(bool include_signature) {
-    dev::RLPStream output;
-    dev::RLPStream list;
-    list.append(m_nonce);
-    list.append(m_chain_id);
-    list.append(m_gas_price);
-    list.append(minter::utils::to_bytes_fixed(m_gas_coin, 10));
-    list.append(m_type);
-    list.append(m_data);
-    list.append(m_payload);
-    list.append(m_service_data);
-    list.append(m_signature_type);
+    // include_signature == true means data for signing, without signature
+    const minter::tx_encoding encoding = include_signature
+                                         ? minter::tx_encoding::unsigned_data
+                                         : minter::tx_encoding::signed_tx;
+    dev::bytes out;
+    out.reserve(encoded_size(encoding));
+    minter::rlp_buffer_sink sink(out);
+    encode_to(sink, encoding);
+    return out;
+}
+
+void minter::tx::encode_to(minter::rlp_sink &out, minter::tx_encoding encoding) const {
+    const bool is_signed = encoding == minter::tx_encoding::signed_tx;
+    if (is_signed && !m_signature) {
+        throw std::runtime_error("Transaction is not signed");
+    }
+
+    out.append_list(payload_size(encoding));
+    out.append(m_nonce)
+        .append(m_chain_id)
+        .append(m_gas_price)
+        .append(m_gas_coin.encoded())
+        .append(m_type)
+        .append(m_data.ref())
+        .append(m_payload.ref())
+        .append(m_service_data.ref())
+        .append(m_signature_type);
+
+    if (is_signed) {
+        const dev::bytes signature = m_signature->encode();
+        out.append(dev::bytesConstRef(&signature));
+    }
+}
+
+size_t minter::tx::encoded_size(minter::tx_encoding encoding) const {
+    return dev::rlpListSize(payload_size(encoding));
+}
 
-    if (include_signature) {
-        output.appendList(list);
-        return output.out();
+size_t minter::tx::payload_size(minter::tx_encoding encoding) const {
+    size_t payload_size = 0;
+    payload_size += dev::rlpItemSize(m_nonce);
+    payload_size += dev::rlpItemSize(m_chain_id);
+    payload_size += dev::rlpItemSize(m_gas_price);
+    payload_size += dev::rlpDataSize(10);
+    payload_size += dev::rlpItemSize(m_type);
+    payload_size += dev::rlpItemSize(m_data);
+    payload_size += dev::rlpItemSize(m_payload);
+    payload_size += dev::rlpItemSize(m_service_data);
+    payload_size += dev::rlpItemSize(m_signature_type);
+
+    if (encoding == minter::tx_encoding::signed_tx) {
+        // v (1 byte) + r (32 bytes) + s (32 bytes)
+        const size_t signature_size = m_signature
+                                      ? m_signature->encoded_size()
+                                      : dev::rlpListSize(1 + dev::rlpDataSize(32) * 2);
+        payload_size += dev::rlpDataSize(signature_size);
     }
 
-    list.append(m_signature->encode());
-    output.appendList(list);
-    return output.out();
+    return payload_size;
 }
 
 minter::Data minter::tx::sign_multiple(const minter::data::address &address,
                                        const minter::data::private_key &pk) {
     m_signature_type = minter::signature_type::multi;
+    reset_hash();
     return minter::Data("0x0");
 }
 
@@ -228,7 +515,7 @@ dev::bigint minter::tx::get_gas_price() const {
     return m_gas_price;
 }
 
-std::string minter::tx::get_gas_coin() const {
+minter::coin_symbol minter::tx::get_gas_coin() const {
     return m_gas_coin;
 }
 
@@ -236,15 +523,15 @@ uint16_t minter::tx::get_type() const {
     return static_cast<uint16_t>(m_type);
 }
 
-const dev::bytes &minter::tx::get_data_raw() const {
+const minter::small_bytes<128> &minter::tx::get_data_raw() const {
     return m_data;
 }
 
-const dev::bytes &minter::tx::get_payload() const {
+const minter::small_bytes<64> &minter::tx::get_payload() const {
     return m_payload;
 }
 
-const dev::bytes &minter::tx::get_service_data() const {
+const minter::small_bytes<32> &minter::tx::get_service_data() const {
     return m_service_data;
 }
 
@@ -8,6 +8,7 @@
  */
 
 #include <memory>
+#include <stdexcept>
 
 #include "minter/tx/tx_builder.h"
 #include "minter/tx/tx_send_coin.h"
@@ -34,6 +35,7 @@ std::shared_ptr<minter::tx_builder> minter::new_tx() {
 // setters
 minter::tx_builder &minter::tx_builder::set_nonce(const dev::bigint &nonce) {
     m_tx->m_nonce = nonce;
+    m_tx->reset_hash();
     return *this;
 }
 
@@ -41,53 +43,76 @@ minter::tx_builder &minter::tx_builder::set_nonce(const char *num) {
     return set_nonce(dev::bigint(num));
 }
 
+minter::tx_builder &minter::tx_builder::set_nonce(const minter::nonce_allocator::reservation &nonce) {
+    if (!nonce.valid()) {
+        throw std::runtime_error("Nonce reservation is not valid");
+    }
+    return set_nonce(dev::bigint(nonce.nonce()));
+}
+
 minter::tx_builder &minter::tx_builder::set_chain_id(uint8_t id) {
     m_tx->m_chain_id = id;
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_gas_price(const std::string &amount) {
     m_tx->m_gas_price = dev::bigint(amount);
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_gas_price(const dev::bigdec18 &amount) {
     m_tx->m_gas_price = dev::bigint(amount);
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_gas_price(const dev::bigint &amount) {
     m_tx->m_gas_price = amount;
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_gas_coin(const std::string &coin) {
     m_tx->m_gas_coin = coin;
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_gas_coin(const char *coin) {
-    m_tx->m_gas_coin = std::string(coin);
+    m_tx->m_gas_coin = coin;
+    m_tx->reset_hash();
+    return *this;
+}
+
+minter::tx_builder &minter::tx_builder::set_gas_coin(const minter::coin_symbol &coin) {
+    m_tx->m_gas_coin = coin;
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_payload(const dev::bytes &payload) {
-    std::copy(payload.begin(), payload.end(), m_tx->m_payload.begin());
+    m_tx->m_payload = payload;
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_payload(dev::bytes &&payload) {
     m_tx->m_payload = std::move(payload);
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_payload(const std::string &payload) {
-    m_tx->m_payload = minter::utils::to_bytes(payload);
+    m_tx->m_payload.assign((const uint8_t *) payload.data(), payload.size());
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_payload(std::string &&payload) {
-    m_tx->m_payload = minter::utils::to_bytes(std::move(payload));
+    m_tx->m_payload.assign((const uint8_t *) payload.data(), payload.size());
+    m_tx->reset_hash();
     return *this;
 }
 
@@ -96,22 +121,26 @@ minter::tx_builder &minter::tx_builder::set_payload(const char *payload) {
 }
 
 minter::tx_builder &minter::tx_builder::set_service_data(const dev::bytes &payload) {
-    std::copy(payload.begin(), payload.end(), m_tx->m_service_data.begin());
+    m_tx->m_service_data = payload;
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_service_data(dev::bytes &&payload) {
     m_tx->m_service_data = std::move(payload);
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_service_data(const std::string &payload) {
-    m_tx->m_service_data = std::move(minter::utils::to_bytes(payload));
+    m_tx->m_service_data.assign((const uint8_t *) payload.data(), payload.size());
+    m_tx->reset_hash();
     return *this;
 }
 
 minter::tx_builder &minter::tx_builder::set_service_data(std::string &&payload) {
-    m_tx->m_service_data = minter::utils::to_bytes(std::move(payload));
+    m_tx->m_service_data.assign((const uint8_t *) payload.data(), payload.size());
+    m_tx->reset_hash();
     return *this;
 }
 
@@ -18,30 +18,25 @@ uint16_t minter::tx_buy_coin::type() const {
     return minter::tx_buy_coin_type::type();
 }
 dev::bytes minter::tx_buy_coin::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append(minter::utils::to_bytes_fixed(m_coin_to_buy));
-        lst.append(m_value_to_buy);
-        lst.append(minter::utils::to_bytes_fixed(m_coin_to_sell));
-        lst.append(m_max_value_to_sell);
-        out.appendList(lst);
-    }
-
-    return out.out();
+    return minter::schema_encode(*this);
+}
+
+size_t minter::tx_buy_coin::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 void minter::tx_buy_coin::decode_internal(dev::RLP rlp) {
-    m_coin_to_buy = minter::utils::to_string_clear((dev::bytes)rlp[0]);
-    m_value_to_buy = minter::utils::to_bigint((dev::bytes)rlp[1]);
-    m_coin_to_sell = minter::utils::to_string_clear((dev::bytes)rlp[2]);
-    m_max_value_to_sell = minter::utils::to_bigint((dev::bytes)rlp[3]);
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_buy_coin::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
-std::string minter::tx_buy_coin::get_coin_to_buy() const {
+minter::coin_symbol minter::tx_buy_coin::get_coin_to_buy() const {
     return m_coin_to_buy;
 }
 
-std::string minter::tx_buy_coin::get_coin_to_sell() const {
+minter::coin_symbol minter::tx_buy_coin::get_coin_to_sell() const {
     return m_coin_to_sell;
 }
 
@@ -54,7 +49,12 @@ dev::bigdec18 minter::tx_buy_coin::get_max_value_to_sell() const {
 }
 
 minter::tx_buy_coin& minter::tx_buy_coin::set_coin_to_buy(const char *coin) {
-    m_coin_to_buy = std::string(coin);
+    m_coin_to_buy = coin;
+    return *this;
+}
+
+minter::tx_buy_coin& minter::tx_buy_coin::set_coin_to_buy(const minter::coin_symbol &coin) {
+    m_coin_to_buy = coin;
     return *this;
 }
 
@@ -79,12 +79,17 @@ minter::tx_buy_coin& minter::tx_buy_coin::set_value_to_buy(const dev::bigint &va
 }
 
 minter::tx_buy_coin& minter::tx_buy_coin::set_coin_to_sell(const char *coin) {
-    m_coin_to_sell = std::string(coin);
+    m_coin_to_sell = coin;
+    return *this;
+}
+
+minter::tx_buy_coin& minter::tx_buy_coin::set_coin_to_sell(const minter::coin_symbol &coin) {
+    m_coin_to_sell = coin;
     return *this;
 }
 
 minter::tx_buy_coin& minter::tx_buy_coin::set_coin_to_sell(const std::string &coin) {
-    m_coin_to_sell = std::string(coin);
+    m_coin_to_sell = coin;
     return *this;
 }
 
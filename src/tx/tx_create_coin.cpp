@@ -17,27 +17,19 @@ uint16_t minter::tx_create_coin::type() const {
     return minter::tx_create_coin_type::type();
 }
 dev::bytes minter::tx_create_coin::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append(minter::utils::to_bytes(m_name));
-        lst.append(minter::utils::to_bytes_fixed(m_ticker));
-        lst.append(m_initial_amount);
-        lst.append(m_initial_reserve);
-        lst.append(m_crr);
-
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_create_coin::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_create_coin::decode_internal(dev::RLP rlp) {
-    m_name = minter::utils::to_string((dev::bytes)rlp[0]);
-    m_ticker = minter::utils::to_string_clear((dev::bytes)rlp[1]);
-    m_initial_amount = (dev::bigint)rlp[2];
-    m_initial_reserve = (dev::bigint)rlp[3];
-    m_crr = (dev::bigint)rlp[4];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_create_coin::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 minter::tx_create_coin& minter::tx_create_coin::set_name(const char* name) {
@@ -46,7 +38,12 @@ minter::tx_create_coin& minter::tx_create_coin::set_name(const char* name) {
 }
 
 minter::tx_create_coin& minter::tx_create_coin::set_ticker(const char *coin_symbol) {
-    m_ticker = std::string(coin_symbol);
+    m_ticker = coin_symbol;
+    return *this;
+}
+
+minter::tx_create_coin& minter::tx_create_coin::set_ticker(const minter::coin_symbol &coin) {
+    m_ticker = coin;
     return *this;
 }
 
@@ -89,7 +86,7 @@ std::string minter::tx_create_coin::get_name() const {
     return m_name;
 }
 
-std::string minter::tx_create_coin::get_ticker() const {
+minter::coin_symbol minter::tx_create_coin::get_ticker() const {
     return m_ticker;
 }
 
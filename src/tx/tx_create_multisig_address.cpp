@@ -19,31 +19,19 @@ uint16_t minter::tx_create_multisig_address::type() const {
     return minter::tx_create_multisig_address_type::type();
 }
 dev::bytes minter::tx_create_multisig_address::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append(m_threshold);
-        lst.append(m_weights);
-        std::vector<dev::bytes> addresses(m_addresses.size());
-        std::for_each(m_addresses.begin(), m_addresses.end(), [&addresses](const minter::data::address& add) {
-            addresses.push_back(add.get());
-        });
-        lst.append(addresses);
-        
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_create_multisig_address::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_create_multisig_address::decode_internal(dev::RLP rlp) {
-    m_threshold = (dev::bigint)rlp[0];
-    m_weights = rlp[1].toVector<dev::bigint>();
+    minter::schema_decode(*this, rlp);
+}
 
-    std::vector<dev::bytes> addresses = rlp[2].toVector<dev::bytes>();
-    std::for_each(addresses.begin(), addresses.end(), [this](const dev::bytes& add){
-        m_addresses.push_back(minter::data::address(std::move(add)));
-    });
+minter::decode_status minter::tx_create_multisig_address::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 unsigned minter::tx_create_multisig_address::get_threshold() const {
@@ -17,27 +17,19 @@ uint16_t minter::tx_declare_candidacy::type() const {
     return minter::tx_declare_candidacy_type::type();
 }
 dev::bytes minter::tx_declare_candidacy::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append(m_address.get());
-        lst.append((dev::bytes)m_pub_key);
-        lst.append(m_commission);
-        lst.append(minter::utils::to_bytes_fixed(m_coin, 10));
-        lst.append(m_stake);
-
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_declare_candidacy::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_declare_candidacy::decode_internal(dev::RLP rlp) {
-    m_address = (dev::bytes)rlp[0];
-    m_pub_key = (dev::bytes)rlp[1];
-    m_commission = (dev::bigint)rlp[2];
-    m_coin = minter::utils::to_string_clear((dev::bytes)rlp[3]);
-    m_stake = (dev::bigint)rlp[4];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_declare_candidacy::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 minter::tx_declare_candidacy &minter::tx_declare_candidacy::set_address(const minter::data::address &address) {
@@ -46,7 +38,7 @@ minter::tx_declare_candidacy &minter::tx_declare_candidacy::set_address(const mi
 }
 
 minter::tx_declare_candidacy &minter::tx_declare_candidacy::set_pub_key(const minter::pubkey_t &pub_key) {
-    m_pub_key = pub_key;
+    m_pub_key = pub_key.get();
     return *this;
 }
 
@@ -61,7 +53,12 @@ minter::tx_declare_candidacy &minter::tx_declare_candidacy::set_commission(unsig
 }
 
 minter::tx_declare_candidacy &minter::tx_declare_candidacy::set_coin(const char *coin) {
-    m_coin = std::string(coin);
+    m_coin = coin;
+    return *this;
+}
+
+minter::tx_declare_candidacy &minter::tx_declare_candidacy::set_coin(const minter::coin_symbol &coin) {
+    m_coin = coin;
     return *this;
 }
 
@@ -79,15 +76,15 @@ const minter::data::address &minter::tx_declare_candidacy::get_address() const {
     return m_address;
 }
 
-const minter::pubkey_t& minter::tx_declare_candidacy::get_pub_key() const {
-    return m_pub_key;
+minter::pubkey_t minter::tx_declare_candidacy::get_pub_key() const {
+    return minter::pubkey_t(m_pub_key.to_bytes());
 }
 
 unsigned minter::tx_declare_candidacy::get_commission() const {
     return static_cast<unsigned>(m_commission);
 }
 
-std::string minter::tx_declare_candidacy::get_coin() const {
+minter::coin_symbol minter::tx_declare_candidacy::get_coin() const {
     return m_coin;
 }
 
@@ -17,23 +17,19 @@ uint16_t minter::tx_delegate::type() const {
     return minter::tx_delegate_type::type();
 }
 dev::bytes minter::tx_delegate::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append((dev::bytes)m_pub_key);
-        lst.append(minter::utils::to_bytes_fixed(m_coin));
-        lst.append(m_stake);
-
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_delegate::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_delegate::decode_internal(dev::RLP rlp) {
-    m_pub_key = (dev::bytes)rlp[0];
-    m_coin = minter::utils::to_string_clear((dev::bytes)rlp[1]);
-    m_stake = (dev::bigint)rlp[2];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_delegate::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 minter::tx_delegate &minter::tx_delegate::set_pub_key(const dev::bytes &pub_key) {
@@ -42,12 +38,17 @@ minter::tx_delegate &minter::tx_delegate::set_pub_key(const dev::bytes &pub_key)
 }
 
 minter::tx_delegate &minter::tx_delegate::set_pub_key(const minter::pubkey_t &pub_key) {
-    m_pub_key = pub_key;
+    m_pub_key = pub_key.get();
     return *this;
 }
 
 minter::tx_delegate &minter::tx_delegate::set_coin(const char *coin) {
-    m_coin = std::string(coin);
+    m_coin = coin;
+    return *this;
+}
+
+minter::tx_delegate &minter::tx_delegate::set_coin(const minter::coin_symbol &coin) {
+    m_coin = coin;
     return *this;
 }
 
@@ -66,11 +67,11 @@ minter::tx_delegate &minter::tx_delegate::set_stake(const dev::bigdec18 &amount)
     return *this;
 }
 
-const minter::pubkey_t& minter::tx_delegate::get_pub_key() const {
-    return m_pub_key;
+minter::pubkey_t minter::tx_delegate::get_pub_key() const {
+    return minter::pubkey_t(m_pub_key.to_bytes());
 }
 
-std::string minter::tx_delegate::get_coin() const {
+minter::coin_symbol minter::tx_delegate::get_coin() const {
     return m_coin;
 }
 
@@ -18,27 +18,23 @@ uint16_t minter::tx_edit_candidate::type() const {
 }
 
 dev::bytes minter::tx_edit_candidate::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append((dev::bytes)m_pub_key);
-        lst.append(m_reward_address.get());
-        lst.append(m_owner_address.get());
-
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_edit_candidate::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_edit_candidate::decode_internal(dev::RLP rlp) {
-    m_pub_key = (dev::bytes)rlp[0];
-    m_reward_address = (dev::bytes)rlp[1];
-    m_owner_address = (dev::bytes)rlp[2];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_edit_candidate::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 minter::tx_edit_candidate &minter::tx_edit_candidate::set_pub_key(const minter::pubkey_t &pub_key) {
-    m_pub_key = pub_key;
+    m_pub_key = pub_key.get();
     return *this;
 }
 
@@ -57,8 +53,8 @@ minter::tx_edit_candidate &minter::tx_edit_candidate::set_owner_address(const mi
     return *this;
 }
 
-const minter::pubkey_t& minter::tx_edit_candidate::get_pub_key() const {
-    return m_pub_key;
+minter::pubkey_t minter::tx_edit_candidate::get_pub_key() const {
+    return minter::pubkey_t(m_pub_key.to_bytes());
 }
 
 const minter::data::address minter::tx_edit_candidate::get_reward_address() const {
@@ -7,68 +7,369 @@
  * \link   https://github.com/edwardstock
  */
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 #include "minter/tx/tx_multisend.h"
 #include "minter/tx/tx_type.h"
 #include "minter/tx/utils.h"
-minter::tx_multisend::tx_multisend(std::shared_ptr<minter::tx> tx) : tx_data(std::move(tx)) {
 
+constexpr size_t minter::send_target_list::coin_size;
+constexpr size_t minter::send_target_list::address_size;
+constexpr size_t minter::send_target_list::amount_size;
+
+// send_target_list
+minter::send_target_list::send_target_list(minter::arena *arena) :
+    m_coins(minter::arena_allocator<uint8_t>(arena)),
+    m_addresses(minter::arena_allocator<uint8_t>(arena)),
+    m_amounts(minter::arena_allocator<uint8_t>(arena)),
+    m_amount_sizes(minter::arena_allocator<uint8_t>(arena)) {
 }
-uint16_t minter::tx_multisend::type() const {
-    return minter::tx_multisend_type::type();
+
+minter::send_target_list::send_target_list(const minter::send_target_list &other, minter::arena *arena) :
+    m_coins(other.m_coins, minter::arena_allocator<uint8_t>(arena)),
+    m_addresses(other.m_addresses, minter::arena_allocator<uint8_t>(arena)),
+    m_amounts(other.m_amounts, minter::arena_allocator<uint8_t>(arena)),
+    m_amount_sizes(other.m_amount_sizes, minter::arena_allocator<uint8_t>(arena)) {
 }
 
-#include <iostream>
-dev::bytes minter::tx_multisend::encode() {
-    dev::RLPStream out;
-    dev::RLPStream items_out;
-    dev::RLPStream items;
-    {
-        for(const auto& item: m_items) {
-            dev::RLPStream elements;
-            elements.append(minter::utils::to_bytes_fixed(item.coin, 10));
-            elements.append(item.to.get());
-            elements.append(item.amount);
-            items.appendList(elements);
+minter::arena *minter::send_target_list::get_arena() const noexcept {
+    return m_coins.get_allocator().get_arena();
+}
+
+size_t minter::send_target_list::size() const noexcept {
+    return m_amount_sizes.size();
+}
+
+bool minter::send_target_list::empty() const noexcept {
+    return m_amount_sizes.empty();
+}
+
+void minter::send_target_list::reserve(size_t count) {
+    m_coins.reserve(count * coin_size);
+    m_addresses.reserve(count * address_size);
+    m_amounts.reserve(count * amount_size);
+    m_amount_sizes.reserve(count);
+}
+
+void minter::send_target_list::clear() noexcept {
+    m_coins.clear();
+    m_addresses.clear();
+    m_amounts.clear();
+    m_amount_sizes.clear();
+}
+
+void minter::send_target_list::push_back(const minter::coin_symbol &coin,
+                                         const minter::data::address &to,
+                                         const dev::bigint &amount) {
+    if (amount < 0 || (amount != 0 && boost::multiprecision::msb(amount) >= amount_size * 8)) {
+        throw std::runtime_error("amount must be a non-negative 256-bit value");
+    }
+    if (to.get().size() != address_size) {
+        throw std::runtime_error("address length is not valid");
+    }
+    uint8_t amount_bytes[amount_size];
+    dev::bytesRef amount_ref(amount_bytes, amount_size);
+    dev::toBigEndian(dev::u256(amount), amount_ref);
+    push_encoded(coin.encoded(), dev::bytesConstRef(to.data(), address_size),
+                 dev::bytesConstRef(amount_bytes, amount_size));
+}
+
+void minter::send_target_list::push_encoded(dev::bytesConstRef coin,
+                                            dev::bytesConstRef to,
+                                            dev::bytesConstRef amount) {
+    // leading zeros are not stored, so amount_bytes() is canonical
+    size_t skip = 0;
+    while (skip < amount.size() && amount[skip] == 0) {
+        skip++;
+    }
+    const size_t significant = amount.size() - skip;
+
+    m_coins.resize(m_coins.size() + coin_size, 0);
+    std::copy(coin.begin(), coin.begin() + std::min(coin.size(), coin_size), m_coins.end() - coin_size);
+    m_addresses.insert(m_addresses.end(), to.begin(), to.end());
+    m_amounts.resize(m_amounts.size() + amount_size, 0);
+    std::copy(amount.begin() + skip, amount.end(), m_amounts.end() - significant);
+    m_amount_sizes.push_back((uint8_t) significant);
+}
+
+minter::send_target minter::send_target_list::operator[](size_t i) const {
+    return minter::send_target{coin(i), minter::data::address(to(i).toBytes()), amount(i)};
+}
+
+minter::send_target minter::send_target_list::front() const {
+    return (*this)[0];
+}
+
+minter::send_target minter::send_target_list::back() const {
+    return (*this)[size() - 1];
+}
+
+minter::send_target_list::const_iterator minter::send_target_list::begin() const {
+    return const_iterator(this, 0);
+}
+
+minter::send_target_list::const_iterator minter::send_target_list::end() const {
+    return const_iterator(this, size());
+}
+
+std::vector<minter::send_target> minter::send_target_list::to_vector() const {
+    return std::vector<minter::send_target>(begin(), end());
+}
+
+minter::coin_symbol minter::send_target_list::coin(size_t i) const {
+    return minter::coin_symbol(coin_bytes(i));
+}
+
+dev::bytesConstRef minter::send_target_list::coin_bytes(size_t i) const {
+    return dev::bytesConstRef(m_coins.data() + i * coin_size, coin_size);
+}
+
+dev::bytesConstRef minter::send_target_list::to(size_t i) const {
+    return dev::bytesConstRef(m_addresses.data() + i * address_size, address_size);
+}
+
+dev::bigint minter::send_target_list::amount(size_t i) const {
+    return dev::fromBigEndian<dev::bigint>(amount_bytes(i));
+}
+
+dev::bytesConstRef minter::send_target_list::amount_bytes(size_t i) const {
+    const size_t significant = m_amount_sizes[i];
+    return dev::bytesConstRef(m_amounts.data() + (i + 1) * amount_size - significant, significant);
+}
+
+// items codec
+namespace {
+
+/// Header of RLP item in encoded data
+struct rlp_item {
+  const uint8_t *begin = nullptr;
+  const uint8_t *payload = nullptr;
+  size_t size = 0;
+  bool list = false;
+
+  const uint8_t *end() const {
+      return payload + size;
+  }
+  dev::bytesConstRef bytes() const {
+      return dev::bytesConstRef(payload, size);
+  }
+  dev::RLP rlp() const {
+      return dev::RLP(dev::bytesConstRef(begin, (size_t) (end() - begin)), dev::RLP::LaissezFaire);
+  }
+};
+
+// Reads header of item at p, with the same length rules as RLP validation
+// \return error if item doesn't fit before end, or its length is not canonical
+dev::RLPError read_item(const uint8_t *p, const uint8_t *end, rlp_item &out) {
+    size_t header_size = 0;
+    const dev::RLPError error = dev::rlpTryParseHeader(dev::bytesConstRef(p, (size_t) (end - p)),
+                                                       out.list, header_size, out.size);
+    if (error != dev::RLPError::None) {
+        return error;
+    }
+    out.begin = p;
+    out.payload = p + header_size;
+    return dev::RLPError::None;
+}
+
+// Items before end, or before first malformed one
+size_t count_items(const uint8_t *p, const uint8_t *end) {
+    size_t count = 0;
+    rlp_item item;
+    while (read_item(p, end, item) == dev::RLPError::None) {
+        p = item.end();
+        count++;
+    }
+    return count;
+}
+
+// Fields of item, as rlp_codec<send_target>::check() checks them
+bool check_item(const rlp_item &item, dev::bytesConstRef *fields, minter::decode_context &ctx) {
+    if (!item.list) {
+        return ctx.fail(minter::decode_error::list_expected, item.rlp());
+    }
+    rlp_item field[3];
+    size_t count = 0;
+    for (const uint8_t *p = item.payload; p < item.end(); count++) {
+        if (count == 3) {
+            return ctx.fail(minter::decode_error::invalid_field_count, item.rlp());
+        }
+        rlp_item next;
+        const dev::RLPError error = read_item(p, item.end(), next);
+        if (error != dev::RLPError::None) {
+            return ctx.fail(minter::to_decode_error(error), item.rlp());
+        }
+        field[count] = next;
+        p = next.end();
+    }
+    if (count != 3) {
+        return ctx.fail(minter::decode_error::invalid_field_count, item.rlp());
+    }
+
+    // in order of schema fields, so the same error is reported
+    if (field[0].list) {
+        return ctx.fail(minter::decode_error::string_expected, field[0].rlp());
+    }
+    if (field[0].size > minter::send_target_list::coin_size) {
+        return ctx.fail(minter::decode_error::invalid_length, field[0].rlp());
+    }
+    if (field[1].list) {
+        return ctx.fail(minter::decode_error::string_expected, field[1].rlp());
+    }
+    if (field[1].size != minter::send_target_list::address_size) {
+        return ctx.fail(minter::decode_error::invalid_length, field[1].rlp());
+    }
+    if (field[2].list) {
+        return ctx.fail(minter::decode_error::string_expected, field[2].rlp());
+    }
+    if (field[2].size > 0 && field[2].payload[0] == 0) {
+        return ctx.fail(minter::decode_error::non_canonical_int, field[2].rlp());
+    }
+    if (field[2].size > minter::send_target_list::amount_size) {
+        return ctx.fail(minter::decode_error::int_too_big, field[2].rlp());
+    }
+    for (size_t i = 0; i < 3; i++) {
+        fields[i] = field[i].bytes();
+    }
+    return true;
+}
+
+// Checks items and passes encoded fields of each one to on_item
+template<typename OnItem>
+bool check_items(const dev::RLP &rlp, minter::decode_context &ctx, OnItem on_item) {
+    if (!rlp.isList()) {
+        return ctx.fail(minter::decode_error::list_expected, rlp);
+    }
+
+    const dev::bytesConstRef payload = rlp.payload();
+    const uint8_t *end = payload.data() + payload.size();
+    for (const uint8_t *p = payload.data(); p < end;) {
+        rlp_item item;
+        const dev::RLPError error = read_item(p, end, item);
+        if (error != dev::RLPError::None) {
+            return ctx.fail(minter::to_decode_error(error), rlp);
         }
+        p = item.end();
 
-        items_out.appendList(items);
+        dev::bytesConstRef fields[3];
+        if (!check_item(item, fields, ctx)) {
+            return false;
+        }
+        on_item(fields);
     }
-    out.appendList(items_out);
+    return true;
+}
 
-    return out.out();
 }
 
-void minter::tx_multisend::decode_internal(dev::RLP rlp) {
-    if(rlp.itemCount() == 0) {
+void minter::rlp_codec<minter::send_target_list>::read(const dev::RLP &rlp, minter::send_target_list &value) {
+    value.clear();
+    if (rlp.isNull() || (rlp.isData() && rlp.size() == 0)) {
         return;
     }
+    if (!rlp.isList()) {
+        throw std::runtime_error("multisend items must be a list");
+    }
 
-    m_items.reserve(rlp[0].itemCount());
+    const dev::bytesConstRef payload = rlp.payload();
+    const uint8_t *end = payload.data() + payload.size();
+    value.reserve(count_items(payload.data(), end));
+    for (const uint8_t *p = payload.data(); p < end;) {
+        rlp_item item;
+        if (read_item(p, end, item) != dev::RLPError::None || !item.list) {
+            throw std::runtime_error("multisend item must be a list");
+        }
+        p = item.end();
 
-    for(size_t i = 0; i < rlp[0].itemCount(); i++) {
-        dev::RLP els = rlp[0][i];
-        send_target t{
-            minter::utils::to_string_clear((dev::bytes)els[0]),
-            (dev::bytes)els[1],
-            (dev::bigint)els[2]
-        };
+        // missing trailing fields are read as empty ones
+        dev::bytesConstRef fields[3];
+        const uint8_t *f = item.payload;
+        for (size_t i = 0; i < 3 && f < item.end(); i++) {
+            rlp_item field;
+            if (read_item(f, item.end(), field) != dev::RLPError::None || field.list) {
+                throw std::runtime_error("multisend item field must be a string");
+            }
+            fields[i] = field.bytes();
+            f = field.end();
+        }
+        if (fields[0].size() > minter::send_target_list::coin_size) {
+            throw std::runtime_error("coin symbol length is not valid");
+        }
+        if (fields[1].size() != minter::send_target_list::address_size) {
+            throw std::runtime_error("address length is not valid");
+        }
+        if (fields[2].size() > minter::send_target_list::amount_size) {
+            throw std::runtime_error("amount is too big");
+        }
+        value.push_encoded(fields[0], fields[1], fields[2]);
+    }
+}
+
+bool minter::rlp_codec<minter::send_target_list>::check(const dev::RLP &rlp, minter::decode_context &ctx) {
+    return check_items(rlp, ctx, [](const dev::bytesConstRef *) { });
+}
 
-        m_items.push_back(std::move(t));
+bool minter::rlp_codec<minter::send_target_list>::try_read(const dev::RLP &rlp,
+                                                           minter::send_target_list &value,
+                                                           minter::decode_context &ctx) {
+    value.clear();
+    if (rlp.isList()) {
+        const dev::bytesConstRef payload = rlp.payload();
+        value.reserve(count_items(payload.data(), payload.data() + payload.size()));
     }
+    return check_items(rlp, ctx, [&value](const dev::bytesConstRef *fields) {
+        value.push_encoded(fields[0], fields[1], fields[2]);
+    });
+}
+
+minter::tx_multisend::tx_multisend(std::shared_ptr<minter::tx> tx) : tx_data(std::move(tx)) {
+
+}
+uint16_t minter::tx_multisend::type() const {
+    return minter::tx_multisend_type::type();
+}
+
+dev::bytes minter::tx_multisend::encode() {
+    return minter::schema_encode(*this);
+}
+
+size_t minter::tx_multisend::encoded_size() const {
+    return minter::schema_encoded_size(*this);
+}
+
+void minter::tx_multisend::decode_internal(dev::RLP rlp) {
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_multisend::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 minter::tx_multisend &
 minter::tx_multisend::add_item(const char *coin, const minter::data::address &to, const char *amount) {
-    m_items.push_back(minter::send_target{std::string(coin), to, minter::utils::normalize_value(amount)});
+    m_items.push_back(minter::coin_symbol(coin), to, minter::utils::normalize_value(amount));
     return *this;
 }
 
 minter::tx_multisend &
 minter::tx_multisend::add_item(const char *coin, const minter::data::address &to, const dev::bigdec18 &amount) {
-    m_items.push_back(minter::send_target{std::string(coin), to, minter::utils::normalize_value(amount)});
+    m_items.push_back(minter::coin_symbol(coin), to, minter::utils::normalize_value(amount));
     return *this;
 }
 
-const std::vector<minter::send_target> &minter::tx_multisend::get_items() const {
+minter::tx_multisend &
+minter::tx_multisend::add_item(const minter::coin_symbol &coin, const minter::data::address &to, const dev::bigint &amount) {
+    m_items.push_back(coin, to, amount);
+    return *this;
+}
+
+const minter::send_target_list &minter::tx_multisend::get_items() const {
     return m_items;
 }
+
+void minter::tx_multisend::set_arena(minter::arena *arena) {
+    if (arena != m_items.get_arena()) {
+        m_items = minter::send_target_list(m_items, arena);
+    }
+}
@@ -0,0 +1,278 @@
+/*!
+ * minter_tx.
+ * tx_multisend_planner.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "minter/hex.h"
+#include "minter/tx/ordered_batches.h"
+#include "minter/tx/tx_builder.h"
+#include "minter/tx/tx_multisend_planner.h"
+#include "minter/tx/tx_type.h"
+#include "minter/tx/utils.h"
+
+namespace {
+
+/// Rows of consecutive transactions, planned by one worker
+struct batch {
+  size_t first_row = 0;
+  uint64_t first_nonce = 0;
+  // rows text, without line ends
+  std::string text;
+  // offset and size of each row in text
+  std::vector<std::pair<size_t, size_t>> rows;
+  std::vector<minter::planned_multisend> txs;
+};
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+void trim(const char *&begin, const char *&end) {
+    while (begin < end && is_space(*begin)) {
+        begin++;
+    }
+    while (end > begin && is_space(*(end - 1))) {
+        end--;
+    }
+}
+
+// next comma separated field of row, pos is nullptr after last one
+bool next_field(const char *&pos, const char *end, const char *&field_begin, const char *&field_end) {
+    if (pos == nullptr) {
+        return false;
+    }
+    field_begin = pos;
+    field_end = std::find(pos, end, ',');
+    pos = field_end == end ? nullptr : field_end + 1;
+    trim(field_begin, field_end);
+    return true;
+}
+
+minter::data::address parse_address(const char *begin, const char *end) {
+    if (end - begin == 42 && (begin[0] == 'M' || begin[0] == 'm') && begin[1] == 'x') {
+        begin += 2;
+    }
+    if (end - begin != 40) {
+        throw std::runtime_error("address length is not valid");
+    }
+    std::vector<uint8_t> out(20);
+    size_t error_pos = 0;
+    if (!minter::hex_decode(begin, 40, out.data(), error_pos)) {
+        throw std::runtime_error("address is not valid hex");
+    }
+    return minter::data::address(std::move(out));
+}
+
+// decimal amount in coins to pips, without going through decimal type
+dev::bigint parse_amount(const char *begin, const char *end) {
+    const char *dot = std::find(begin, end, '.');
+    const size_t fraction = dot == end ? 0 : (size_t) (end - dot - 1);
+    if (begin == end || (dot == begin && fraction == 0) || fraction > 18) {
+        throw std::runtime_error("amount is not valid");
+    }
+
+    std::string digits;
+    digits.reserve((size_t) (end - begin) + 18);
+    for (const char *p = begin; p < end; p++) {
+        if (p == dot) {
+            continue;
+        }
+        if (*p < '0' || *p > '9') {
+            throw std::runtime_error("amount is not valid");
+        }
+        digits.push_back(*p);
+    }
+    digits.append(18 - fraction, '0');
+
+    // up to 19 digits fit into 64 bits
+    const size_t first = std::min(digits.find_first_not_of('0'), digits.size());
+    if (digits.size() - first <= 19) {
+        uint64_t value = 0;
+        for (size_t i = first; i < digits.size(); i++) {
+            value = value * 10 + (uint64_t) (digits[i] - '0');
+        }
+        return dev::bigint(value);
+    }
+    return dev::bigint(digits.substr(first));
+}
+
+void plan_batch(batch &b, const minter::data::private_key &pk, const minter::tx_multisend_planner::options &opts) {
+    const size_t tx_count = (b.rows.size() + opts.max_items - 1) / opts.max_items;
+    b.txs.resize(tx_count);
+    for (size_t t = 0; t < tx_count; t++) {
+        const size_t begin = t * opts.max_items;
+        const size_t end = std::min(begin + opts.max_items, b.rows.size());
+
+        auto builder = minter::new_tx();
+        builder->set_nonce(dev::bigint(b.first_nonce + t))
+            .set_chain_id(opts.chain_id)
+            .set_gas_price(opts.gas_price)
+            .set_gas_coin(opts.gas_coin)
+            .set_payload(opts.payload);
+        auto data = builder->tx_multisend();
+        for (size_t r = begin; r < end; r++) {
+            const auto &row = b.rows[r];
+            try {
+                minter::send_target target = minter::tx_multisend_planner::parse_row(b.text.data() + row.first,
+                                                                                     row.second);
+                data->add_item(target.coin, target.to, target.amount);
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Invalid row " + std::to_string(b.first_row + r) + ": " + e.what());
+            }
+        }
+
+        minter::planned_multisend &out = b.txs[t];
+        out.nonce = b.first_nonce + t;
+        out.first_row = b.first_row + begin;
+        out.items = end - begin;
+        out.fee = minter::tx_multisend_planner::fee(out.items, opts.payload.size(), opts.gas_price);
+        out.data = data->build()->sign_single(pk);
+        if (out.data == minter::Data("0x0")) {
+            throw std::runtime_error("Unable to sign rows " + std::to_string(out.first_row) + "-"
+                                         + std::to_string(out.first_row + out.items - 1));
+        }
+    }
+}
+
+// \return false if stream has no more rows
+bool fill(std::istream &in, batch &b, size_t max_rows, std::string &line) {
+    while (b.rows.size() < max_rows && std::getline(in, line)) {
+        const char *begin = line.data();
+        const char *end = begin + line.size();
+        trim(begin, end);
+        if (begin == end || *begin == '#') {
+            continue;
+        }
+        b.rows.emplace_back(b.text.size(), (size_t) (end - begin));
+        b.text.append(begin, end);
+    }
+    return !b.rows.empty();
+}
+
+}
+
+minter::tx_multisend_planner::tx_multisend_planner(const minter::data::private_key &pk,
+                                                   uint64_t first_nonce,
+                                                   const minter::tx_multisend_planner::options &opts) :
+    m_pk(pk),
+    m_first_nonce(first_nonce),
+    m_opts(opts) {
+    if (m_opts.max_items == 0) {
+        throw std::runtime_error("Max items per transaction must be greater than 0");
+    }
+    if (m_opts.threads == 0) {
+        m_opts.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (m_opts.max_batches == 0) {
+        m_opts.max_batches = m_opts.threads * 2;
+    }
+    if (m_opts.batch_txs == 0) {
+        m_opts.batch_txs = 1;
+    }
+}
+
+minter::tx_multisend_planner::tx_multisend_planner(const minter::data::private_key &pk, uint64_t first_nonce) :
+    tx_multisend_planner(pk, first_nonce, options()) {
+}
+
+minter::tx_multisend_plan_stats minter::tx_multisend_planner::plan(std::istream &rows, const callback &on_tx) {
+    const auto start = std::chrono::steady_clock::now();
+    minter::tx_multisend_plan_stats stats;
+
+    minter::ordered_batches<batch> pipeline(
+        m_opts.threads,
+        m_opts.max_batches,
+        [this](batch &b) { plan_batch(b, m_pk, m_opts); },
+        [&stats, &on_tx](const batch &b) {
+            for (const auto &tx: b.txs) {
+                stats.rows += tx.items;
+                stats.txs++;
+                stats.fee += tx.fee;
+                on_tx(tx);
+            }
+        });
+
+    const size_t batch_rows = m_opts.batch_txs * m_opts.max_items;
+    std::string line;
+    size_t next_row = 0;
+    uint64_t next_nonce = m_first_nonce;
+    for (;;) {
+        std::unique_ptr<batch> b(new batch());
+        b->first_row = next_row;
+        b->first_nonce = next_nonce;
+        if (!fill(rows, *b, batch_rows, line)) {
+            break;
+        }
+        next_row += b->rows.size();
+        next_nonce += (b->rows.size() + m_opts.max_items - 1) / m_opts.max_items;
+
+        pipeline.push(std::move(b));
+    }
+    pipeline.finish();
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+minter::tx_multisend_plan_stats minter::tx_multisend_planner::plan_file(const std::string &rows_path,
+                                                                        const std::string &out_path) {
+    std::ifstream in(rows_path);
+    if (!in) {
+        throw std::runtime_error("Can't open file: " + rows_path);
+    }
+    std::ofstream out(out_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Can't open file: " + out_path);
+    }
+
+    size_t bytes = 0;
+    minter::tx_multisend_plan_stats stats = plan(in, [&out, &bytes](const minter::planned_multisend &tx) {
+        minter::write_hex(out, dev::bytesConstRef(&tx.data.get()));
+        out.put('\n');
+        bytes += tx.data.get().size() * 2 + 1;
+    });
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Can't write file: " + out_path);
+    }
+    stats.bytes = bytes;
+    return stats;
+}
+
+dev::bigint minter::tx_multisend_planner::fee(size_t items, size_t payload_size, const dev::bigint &gas_price) {
+    return minter::utils::normalize_value(minter::get_multisend_fee(items, payload_size, gas_price));
+}
+
+minter::send_target minter::tx_multisend_planner::parse_row(const char *row, size_t size) {
+    const char *pos = row;
+    const char *end = row + size;
+    const char *field[3][2];
+    for (auto &f: field) {
+        if (!next_field(pos, end, f[0], f[1])) {
+            throw std::runtime_error("row must have 3 fields: coin,address,amount");
+        }
+    }
+    if (pos != nullptr) {
+        throw std::runtime_error("row must have 3 fields: coin,address,amount");
+    }
+    if (field[0][0] == field[0][1]) {
+        throw std::runtime_error("coin is empty");
+    }
+
+    minter::send_target out;
+    out.coin = minter::coin_symbol(std::string(field[0][0], field[0][1]));
+    out.to = parse_address(field[1][0], field[1][1]);
+    out.amount = parse_amount(field[2][0], field[2][1]);
+    return out;
+}
@@ -0,0 +1,231 @@
+/*!
+ * minter_tx.
+ * tx_presign_pool.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "minter/tx/tx_presign_pool.h"
+
+minter::tx_presign_pool::tx_presign_pool(const minter::data::private_key &pk,
+                                         uint64_t next_nonce,
+                                         const minter::tx_presign_pool::options &opts) :
+    m_pk(pk),
+    m_opts(opts),
+    m_next(next_nonce) {
+    const size_t threads = std::max<size_t>(1, m_opts.threads);
+    for (size_t i = 0; i < threads; i++) {
+        m_threads.emplace_back([this] { run(); });
+    }
+}
+
+minter::tx_presign_pool::tx_presign_pool(const minter::data::private_key &pk, uint64_t next_nonce) :
+    tx_presign_pool(pk, next_nonce, options()) {
+}
+
+minter::tx_presign_pool::~tx_presign_pool() {
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_work_cv.notify_all();
+    for (auto &t: m_threads) {
+        t.join();
+    }
+}
+
+size_t minter::tx_presign_pool::add_template(minter::tx_presign_pool::tx_factory factory) {
+    if (!factory) {
+        throw std::runtime_error("Template function is empty");
+    }
+    size_t id;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        std::unique_ptr<entry> e(new entry());
+        e->factory = std::move(factory);
+        m_templates.push_back(std::move(e));
+        id = m_templates.size() - 1;
+    }
+    m_work_cv.notify_all();
+    return id;
+}
+
+bool minter::tx_presign_pool::try_take(size_t template_id, minter::tx_presign_pool::signed_tx &out) {
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        entry &e = get_entry(template_id);
+        if (e.error) {
+            std::exception_ptr error = e.error;
+            e.error = nullptr;
+            m_work_cv.notify_all();
+            std::rethrow_exception(error);
+        }
+
+        auto it = e.ready.find(m_next);
+        if (it == e.ready.end()) {
+            return false;
+        }
+        out.nonce = it->first;
+        out.data = std::move(it->second);
+        e.ready.erase(it);
+        consume(out.nonce);
+    }
+    m_work_cv.notify_all();
+    return true;
+}
+
+minter::tx_presign_pool::signed_tx minter::tx_presign_pool::take(size_t template_id) {
+    signed_tx out;
+    if (try_take(template_id, out)) {
+        return out;
+    }
+
+    tx_factory factory;
+    uint64_t nonce;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        factory = get_entry(template_id).factory;
+        nonce = m_next;
+        consume(nonce);
+    }
+    m_work_cv.notify_all();
+
+    try {
+        return sign(factory, nonce);
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            // nonce is handed out again, unless next ones were taken meanwhile
+            if (m_next == nonce + 1) {
+                m_next = nonce;
+                for (auto &e: m_templates) {
+                    e->ready.erase(e->ready.lower_bound(m_next + m_opts.depth), e->ready.end());
+                }
+            }
+        }
+        m_work_cv.notify_all();
+        throw;
+    }
+}
+
+void minter::tx_presign_pool::invalidate(uint64_t next_nonce) {
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_next = next_nonce;
+        for (auto &e: m_templates) {
+            auto &ready = e->ready;
+            ready.erase(ready.begin(), ready.lower_bound(m_next));
+            ready.erase(ready.lower_bound(m_next + m_opts.depth), ready.end());
+        }
+    }
+    m_work_cv.notify_all();
+}
+
+bool minter::tx_presign_pool::wait_ready(size_t template_id, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    get_entry(template_id);
+    return m_ready_cv.wait_for(lock, timeout, [this, template_id] {
+        return m_templates[template_id]->ready.size() >= m_opts.depth;
+    });
+}
+
+uint64_t minter::tx_presign_pool::next_nonce() const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_next;
+}
+
+size_t minter::tx_presign_pool::ready(size_t template_id) const {
+    std::lock_guard<std::mutex> lock(m_lock);
+    return get_entry(template_id).ready.size();
+}
+
+void minter::tx_presign_pool::run() {
+    for (;;) {
+        size_t template_id;
+        uint64_t nonce;
+        tx_factory factory;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_work_cv.wait(lock, [this, &template_id, &nonce] {
+                return m_stop || next_job(template_id, nonce);
+            });
+            if (m_stop) {
+                return;
+            }
+            m_in_progress.emplace(template_id, nonce);
+            factory = m_templates[template_id]->factory;
+        }
+
+        signed_tx result;
+        std::exception_ptr error;
+        try {
+            result = sign(factory, nonce);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_in_progress.erase(std::make_pair(template_id, nonce));
+        entry &e = *m_templates[template_id];
+        if (error) {
+            e.error = error;
+        } else if (nonce >= m_next && nonce < m_next + m_opts.depth) {
+            // nonce could be consumed or invalidated while signing
+            e.ready.emplace(nonce, std::move(result.data));
+        }
+        m_ready_cv.notify_all();
+    }
+}
+
+bool minter::tx_presign_pool::next_job(size_t &template_id, uint64_t &nonce) {
+    // nearest nonces first: they will be taken first
+    for (uint64_t n = m_next; n < m_next + m_opts.depth; n++) {
+        for (size_t id = 0; id < m_templates.size(); id++) {
+            const entry &e = *m_templates[id];
+            if (e.error || e.ready.count(n) != 0 || m_in_progress.count(std::make_pair(id, n)) != 0) {
+                continue;
+            }
+            template_id = id;
+            nonce = n;
+            return true;
+        }
+    }
+    return false;
+}
+
+minter::tx_presign_pool::entry &minter::tx_presign_pool::get_entry(size_t template_id) const {
+    if (template_id >= m_templates.size()) {
+        throw std::runtime_error("Unknown template id: " + std::to_string(template_id));
+    }
+    return *m_templates[template_id];
+}
+
+void minter::tx_presign_pool::consume(uint64_t nonce) {
+    m_next = nonce + 1;
+    for (auto &e: m_templates) {
+        auto &ready = e->ready;
+        ready.erase(ready.begin(), ready.lower_bound(m_next));
+    }
+}
+
+minter::tx_presign_pool::signed_tx minter::tx_presign_pool::sign(const minter::tx_presign_pool::tx_factory &factory,
+                                                                 uint64_t nonce) const {
+    std::shared_ptr<minter::tx> tx = factory(dev::bigint(nonce));
+    if (!tx) {
+        throw std::runtime_error("Template function returned no transaction");
+    }
+    if (tx->get_nonce() != dev::bigint(nonce)) {
+        throw std::runtime_error("Template function must use given nonce");
+    }
+    signed_tx out;
+    out.nonce = nonce;
+    out.data = tx->sign_single(m_pk);
+    if (out.data == minter::Data("0x0")) {
+        throw std::runtime_error("Unable to sign transaction with nonce " + std::to_string(nonce));
+    }
+    return out;
+}
@@ -0,0 +1,169 @@
+/*!
+ * minter_tx.
+ * tx_projection.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "minter/tx/tx_projection.h"
+#include "minter/tx/tx_type.h"
+
+namespace {
+
+const size_t fields_count = 10;
+
+// item header and payload, found without decoding payload
+struct raw_item {
+  bool is_list;
+  size_t offset;
+  dev::bytesConstRef payload;
+};
+
+// reads item header at pos of parent payload and moves pos past the item
+minter::decode_error next_item(dev::bytesConstRef parent, size_t &pos, raw_item &out) {
+    size_t header_size, payload_size;
+    const dev::RLPError error = dev::rlpTryParseHeader(parent.cropped(pos), out.is_list, header_size, payload_size);
+    out.offset = pos;
+    if (error != dev::RLPError::None) {
+        return minter::to_decode_error(error);
+    }
+
+    out.payload = parent.cropped(pos + header_size, payload_size);
+    pos += header_size + payload_size;
+    return minter::decode_error::none;
+}
+
+// reads canonical big-endian unsigned integer, as RLP stores it
+template<typename T>
+minter::decode_error read_uint(dev::bytesConstRef data, T &out) {
+    if (!data.empty() && data[0] == 0) {
+        return minter::decode_error::non_canonical_int;
+    }
+    if (data.size() > sizeof(T)) {
+        return minter::decode_error::int_too_big;
+    }
+
+    out = 0;
+    for (size_t i = 0; i < data.size(); i++) {
+        out = (T) ((out << 8) | data[i]);
+    }
+    return minter::decode_error::none;
+}
+
+minter::decode_error set_field(size_t index, dev::bytesConstRef value, minter::tx_projection &out) {
+    switch (index) {
+        case 0: return read_uint(value, out.nonce);
+        case 1: return read_uint(value, out.chain_id);
+        case 2:
+            out.gas_price = value;
+            return minter::decode_error::none;
+        case 3:
+            if (value.size() > minter::coin_symbol::max_length) {
+                return minter::decode_error::invalid_length;
+            }
+            out.gas_coin = minter::coin_symbol(value);
+            return minter::decode_error::none;
+        case 4: return read_uint(value, out.type);
+        case 5:
+            out.data = value;
+            return minter::decode_error::none;
+        case 6:
+            out.payload = value;
+            return minter::decode_error::none;
+        case 7:
+            out.service_data = value;
+            return minter::decode_error::none;
+        case 8: return read_uint(value, out.signature_type);
+        case 9:
+            out.signature = value;
+            return minter::decode_error::none;
+        default: return minter::decode_error::invalid_field_count;
+    }
+}
+
+// send data is [coin, to, value]
+minter::decode_status read_recipient(dev::bytesConstRef data, minter::tx_projection &out) {
+    size_t pos = 0;
+    raw_item list;
+    minter::decode_error error = next_item(data, pos, list);
+    if (error != minter::decode_error::none) {
+        return minter::decode_status(error, list.offset);
+    }
+    if (!list.is_list) {
+        return minter::decode_status(minter::decode_error::list_expected, list.offset);
+    }
+
+    const size_t base = (size_t) (list.payload.data() - data.data());
+    raw_item item;
+    pos = 0;
+    for (size_t i = 0; i < 2; i++) {
+        if (pos == list.payload.size()) {
+            return minter::decode_status(minter::decode_error::invalid_field_count, list.offset);
+        }
+        error = next_item(list.payload, pos, item);
+        if (error != minter::decode_error::none) {
+            return minter::decode_status(error, base + item.offset);
+        }
+    }
+    if (item.is_list) {
+        return minter::decode_status(minter::decode_error::string_expected, base + item.offset);
+    }
+    if (item.payload.size() != 20) {
+        return minter::decode_status(minter::decode_error::invalid_length, base + item.offset);
+    }
+
+    out.recipient = item.payload;
+    out.fields |= minter::tx_field_mask::recipient;
+    return minter::decode_status();
+}
+
+}
+
+minter::decode_status minter::tx_projection::decode(dev::bytesConstRef encoded, uint32_t mask, tx_projection &out) {
+    out = tx_projection();
+
+    uint32_t need = mask;
+    if (mask & tx_field_mask::recipient) {
+        need |= tx_field_mask::type | tx_field_mask::data;
+    }
+    need &= (1u << fields_count) - 1;
+
+    size_t pos = 0;
+    raw_item tx;
+    minter::decode_error error = next_item(encoded, pos, tx);
+    if (error != minter::decode_error::none) {
+        return minter::decode_status(error, 0);
+    }
+    if (!tx.is_list) {
+        return minter::decode_status(minter::decode_error::list_expected, 0);
+    }
+
+    const size_t base = (size_t) (tx.payload.data() - encoded.data());
+    pos = 0;
+    // fields after the last needed one are not even walked
+    for (size_t i = 0; (need >> i) != 0; i++) {
+        if (pos == tx.payload.size()) {
+            return minter::decode_status(minter::decode_error::invalid_field_count, 0);
+        }
+
+        raw_item item;
+        error = next_item(tx.payload, pos, item);
+        if (error == minter::decode_error::none && item.is_list) {
+            error = minter::decode_error::string_expected;
+        }
+        if (error == minter::decode_error::none && (need & (1u << i))) {
+            error = set_field(i, item.payload, out);
+        }
+        if (error != minter::decode_error::none) {
+            return minter::decode_status(error, base + item.offset);
+        }
+    }
+    out.fields |= need;
+
+    if ((mask & tx_field_mask::recipient) && out.type == minter::tx_type_val::send_coin) {
+        return read_recipient(out.data, out).shifted((size_t) (out.data.data() - encoded.data()));
+    }
+    return minter::decode_status();
+}
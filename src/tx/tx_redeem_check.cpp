@@ -18,20 +18,19 @@ uint16_t minter::tx_redeem_check::type() const {
     return minter::tx_redeem_check_type::type();
 }
 dev::bytes minter::tx_redeem_check::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append(m_check);
-        lst.append(m_proof);
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_redeem_check::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_redeem_check::decode_internal(dev::RLP rlp) {
-    m_check = (dev::bytes)rlp[0];
-    m_proof = (dev::bytes)rlp[1];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_redeem_check::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 minter::tx_redeem_check& minter::tx_redeem_check::set_check(const dev::bytes& data) {
@@ -42,10 +41,10 @@ minter::tx_redeem_check& minter::tx_redeem_check::set_proof(const dev::bytes& da
     m_proof = data;
     return *this;
 }
-const dev::bytes minter::tx_redeem_check::get_check() const {
+const minter::small_bytes<256> &minter::tx_redeem_check::get_check() const {
     return m_check;
 }
-const dev::bytes minter::tx_redeem_check::get_proof() const {
+const minter::small_bytes<minter::PROOF_LEN> &minter::tx_redeem_check::get_proof() const {
     return m_proof;
 }
 
@@ -17,28 +17,28 @@ uint16_t minter::tx_sell_coin::type() const {
     return minter::tx_sell_coin_type::type();
 }
 dev::bytes minter::tx_sell_coin::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append(minter::utils::to_bytes_fixed(m_coin_to_sell));
-        lst.append(m_value_to_sell);
-        lst.append(minter::utils::to_bytes_fixed(m_coin_to_buy));
-        lst.append(m_min_value_to_buy);
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_sell_coin::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_sell_coin::decode_internal(dev::RLP rlp) {
-    m_coin_to_sell = minter::utils::to_string_clear((dev::bytes)rlp[0]);
-    m_value_to_sell = (dev::bigint)rlp[1];
-    m_coin_to_buy = minter::utils::to_string_clear((dev::bytes)rlp[2]);
-    m_min_value_to_buy = (dev::bigint)rlp[3];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_sell_coin::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 minter::tx_sell_coin& minter::tx_sell_coin::set_coin_to_sell(const char* coin) {
-    m_coin_to_sell = std::string(coin);
+    m_coin_to_sell = coin;
+    return *this;
+}
+
+minter::tx_sell_coin& minter::tx_sell_coin::set_coin_to_sell(const minter::coin_symbol &coin) {
+    m_coin_to_sell = coin;
     return *this;
 }
 minter::tx_sell_coin &minter::tx_sell_coin::set_coin_to_sell(const std::string &coin) {
@@ -54,7 +54,12 @@ minter::tx_sell_coin& minter::tx_sell_coin::set_value_to_sell(const dev::bigdec1
     return *this;
 }
 minter::tx_sell_coin& minter::tx_sell_coin::set_coin_to_buy(const char* coin) {
-    m_coin_to_buy = std::string(coin);
+    m_coin_to_buy = coin;
+    return *this;
+}
+
+minter::tx_sell_coin& minter::tx_sell_coin::set_coin_to_buy(const minter::coin_symbol &coin) {
+    m_coin_to_buy = coin;
     return *this;
 }
 minter::tx_sell_coin &minter::tx_sell_coin::set_coin_to_buy(const std::string &coin) {
@@ -73,10 +78,10 @@ minter::tx_sell_coin& minter::tx_sell_coin::set_min_value_to_buy(const dev::bigd
     m_min_value_to_buy = minter::utils::normalize_value(amount);
     return *this;
 }
-std::string minter::tx_sell_coin::get_coin_to_sell() const {
+minter::coin_symbol minter::tx_sell_coin::get_coin_to_sell() const {
     return m_coin_to_sell;
 }
-std::string minter::tx_sell_coin::get_coin_to_buy() const {
+minter::coin_symbol minter::tx_sell_coin::get_coin_to_buy() const {
     return m_coin_to_buy;
 }
 dev::bigdec18 minter::tx_sell_coin::get_value_to_sell() const {
@@ -20,11 +20,16 @@ minter::tx_send_coin &minter::tx_send_coin::set_coin(const std::string &coin) {
     return *this;
 }
 minter::tx_send_coin &minter::tx_send_coin::set_coin(std::string &&coin) {
-    m_coin = std::move(coin);
+    m_coin = coin;
     return *this;
 }
 minter::tx_send_coin &minter::tx_send_coin::set_coin(const char *coin) {
-    m_coin = std::string(coin);
+    m_coin = coin;
+    return *this;
+}
+
+minter::tx_send_coin &minter::tx_send_coin::set_coin(const minter::coin_symbol &coin) {
+    m_coin = coin;
     return *this;
 }
 
@@ -60,8 +65,8 @@ uint16_t minter::tx_send_coin::type() const {
     return minter::tx_send_coin_type::type();
 }
 
-std::string minter::tx_send_coin::get_coin() const {
-    return minter::utils::strip_null_bytes(m_coin.c_str());
+minter::coin_symbol minter::tx_send_coin::get_coin() const {
+    return m_coin;
 }
 
 minter::data::address minter::tx_send_coin::get_to() const {
@@ -73,21 +78,18 @@ dev::bigdec18 minter::tx_send_coin::get_value() const {
 }
 
 dev::bytes minter::tx_send_coin::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append(minter::utils::to_bytes_fixed(m_coin));
-        lst.append(m_to.get());
-        lst.append(m_value);
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_send_coin::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_send_coin::decode_internal(dev::RLP rlp) {
-    m_coin = (std::string)rlp[0];
-    m_to = minter::data::address((dev::bytes)rlp[1]);
-    m_value = (dev::bigint)rlp[2];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_send_coin::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
@@ -0,0 +1,111 @@
+/*!
+ * minter_tx.
+ * tx_send_coin_template.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <algorithm>
+#include "minter/tx/tx_send_coin_template.h"
+#include "minter/tx/signed_layout.h"
+#include "minter/tx/tx_send_coin.h"
+#include "minter/tx/tx_type.h"
+#include "minter/tx/utils.h"
+
+// address is always 20 bytes long
+static const size_t address_item_size = dev::rlpDataSize(20);
+
+minter::tx_send_coin_template::tx_send_coin_template(const std::shared_ptr<minter::tx> &prototype) {
+    if (!prototype || prototype->get_type() != minter::tx_send_coin_type::type()) {
+        throw std::runtime_error("Template prototype must be a send coin transaction");
+    }
+
+    dev::RLPStream head;
+    head.append(prototype->m_chain_id);
+    head.append(prototype->m_gas_price);
+    head.append(prototype->m_gas_coin.encoded());
+    head.append(prototype->m_type);
+    m_head = head.out();
+
+    m_coin = dev::rlp(prototype->get_data<minter::tx_send_coin>()->get_coin().encoded());
+
+    dev::RLPStream tail;
+    tail.append(prototype->m_payload.ref());
+    tail.append(prototype->m_service_data.ref());
+    tail.append(dev::bigint(minter::signature_type::single));
+    m_tail = tail.out();
+}
+
+size_t minter::tx_send_coin_template::fields_size(const dev::bigint &nonce, const dev::bigint &value) const {
+    const size_t data_size = dev::rlpListSize(m_coin.size() + address_item_size + dev::rlpItemSize(value));
+    return dev::rlpItemSize(nonce) + m_head.size() + dev::rlpDataSize(data_size) + m_tail.size();
+}
+
+size_t minter::tx_send_coin_template::encoded_size(const dev::bigint &nonce, const dev::bigint &value) const {
+    return minter::single_signed_layout(fields_size(nonce, value)).size();
+}
+
+dev::bytesConstRef minter::tx_send_coin_template::write_unsigned(const dev::bigint &nonce,
+                                                                 const minter::data::address &to,
+                                                                 const dev::bigint &value,
+                                                                 dev::bytes &out) const {
+    const minter::single_signed_layout layout(fields_size(nonce, value));
+    const size_t data_payload_size = m_coin.size() + address_item_size + dev::rlpItemSize(value);
+
+    out.resize(layout.size());
+    uint8_t *p = out.data() + layout.fields_offset();
+    p += dev::rlpWriteItem(p, nonce);
+    p = std::copy(m_head.begin(), m_head.end(), p);
+    p += dev::rlpWriteHeader(p, dev::rlpListSize(data_payload_size), false);
+    p += dev::rlpWriteHeader(p, data_payload_size, true);
+    p = std::copy(m_coin.begin(), m_coin.end(), p);
+    p += dev::rlpWriteItem(p, dev::bytesConstRef(to.data(), 20));
+    p += dev::rlpWriteItem(p, value);
+    std::copy(m_tail.begin(), m_tail.end(), p);
+
+    return layout.write_unsigned_header(dev::bytesRef(&out));
+}
+
+minter::Data minter::tx_send_coin_template::sign_single(const dev::bigint &nonce,
+                                                        const minter::data::address &to,
+                                                        const dev::bigint &value,
+                                                        const minter::data::private_key &pk) const {
+    dev::bytes out;
+    const dev::bytesConstRef unsigned_data = write_unsigned(nonce, to, value, out);
+
+    uint8_t hash[32];
+    minter::utils::sha3k_into(unsigned_data.data(), unsigned_data.size(), hash);
+
+    auto sig = minter::tx::sign_with_private(m_secp, hash, pk.get().data());
+    if (!sig.success) {
+        return minter::Data("0x0");
+    }
+    minter::single_signed_layout(fields_size(nonce, value)).write_signature(dev::bytesRef(&out), sig);
+
+    return minter::Data(std::move(out));
+}
+
+std::vector<minter::Data> minter::tx_send_coin_template::sign_batch(const std::vector<transfer> &transfers,
+                                                                    const minter::data::private_key &pk) const {
+    std::vector<minter::Data> out(transfers.size());
+    std::vector<dev::bytesConstRef> unsigned_data(transfers.size());
+    for (size_t i = 0; i < transfers.size(); i++) {
+        unsigned_data[i] = write_unsigned(transfers[i].nonce, transfers[i].to, transfers[i].value, out[i].get());
+    }
+
+    std::vector<uint8_t> hashes(transfers.size() * 32);
+    minter::utils::sha3k_batch(unsigned_data.data(), unsigned_data.size(), hashes.data());
+
+    for (size_t i = 0; i < transfers.size(); i++) {
+        auto sig = minter::tx::sign_with_private(m_secp, hashes.data() + i * 32, pk.get().data());
+        if (!sig.success) {
+            out[i] = minter::Data("0x0");
+            continue;
+        }
+        minter::single_signed_layout(fields_size(transfers[i].nonce, transfers[i].value))
+            .write_signature(dev::bytesRef(&out[i].get()), sig);
+    }
+    return out;
+}
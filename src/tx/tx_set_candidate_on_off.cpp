@@ -17,18 +17,19 @@ minter::tx_set_candidate_on_off::tx_set_candidate_on_off(std::shared_ptr<minter:
 }
 
 dev::bytes minter::tx_set_candidate_on_off::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append((dev::bytes)m_pub_key);
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_set_candidate_on_off::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 void minter::tx_set_candidate_on_off::decode_internal(dev::RLP rlp) {
-    m_pub_key = (dev::bytes)rlp[0];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_set_candidate_on_off::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 minter::tx_set_candidate_on_off& minter::tx_set_candidate_on_off::set_pub_key(const dev::bytes& pub_key) {
@@ -37,12 +38,12 @@ minter::tx_set_candidate_on_off& minter::tx_set_candidate_on_off::set_pub_key(co
 }
 
 minter::tx_set_candidate_on_off& minter::tx_set_candidate_on_off::set_pub_key(const minter::pubkey_t &pub_key) {
-    m_pub_key = pub_key;
+    m_pub_key = pub_key.get();
     return *this;
 }
 
-const minter::pubkey_t& minter::tx_set_candidate_on_off::get_pub_key() const {
-    return m_pub_key;
+minter::pubkey_t minter::tx_set_candidate_on_off::get_pub_key() const {
+    return minter::pubkey_t(m_pub_key.to_bytes());
 }
 
 // ON
@@ -0,0 +1,291 @@
+/*!
+ * minter_tx.
+ * tx_stream_decoder.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "minter/tx/ordered_batches.h"
+#include "minter/tx/tx_stream_decoder.h"
+#include "minter/hex.h"
+
+namespace {
+
+const size_t oversize_record = (size_t) -1;
+
+// records of the stream, decoded by one worker at once
+struct batch {
+  size_t first_index = 0;
+  std::vector<uint8_t> data;
+  // offset and size of records in data, size is oversize_record if record is too long to decode
+  std::vector<std::pair<size_t, size_t>> records;
+  std::vector<minter::tx_stream_record> results;
+};
+
+// error offset is position in hex line
+minter::decode_status decode_hex(dev::bytesConstRef line, dev::bytes &out) {
+    size_t start = 0;
+    if (line.size() >= 2 && line[0] == '0' && (line[1] == 'x' || line[1] == 'X')) {
+        start = 2;
+    }
+    if ((line.size() - start) % 2 != 0) {
+        return minter::decode_status(minter::decode_error::truncated, line.size());
+    }
+
+    out.resize((line.size() - start) / 2);
+    size_t error_pos = 0;
+    if (!minter::hex_decode((const char *) line.data() + start, line.size() - start, out.data(), error_pos)) {
+        return minter::decode_status(minter::decode_error::invalid_data, start + error_pos);
+    }
+    return minter::decode_status();
+}
+
+void decode_batch(batch &b, minter::tx_stream_format format) {
+    b.results.resize(b.records.size());
+    dev::bytes buffer;
+    for (size_t i = 0; i < b.records.size(); i++) {
+        minter::tx_stream_record &record = b.results[i];
+        record.index = b.first_index + i;
+
+        const size_t size = b.records[i].second;
+        if (size == oversize_record) {
+            record.status = minter::decode_status(minter::decode_error::oversize, 0);
+            continue;
+        }
+
+        dev::bytesConstRef encoded(b.data.data() + b.records[i].first, size);
+        if (format == minter::tx_stream_format::hex_lines) {
+            record.status = decode_hex(encoded, buffer);
+            if (!record.status) {
+                continue;
+            }
+            encoded = dev::bytesConstRef(&buffer);
+        }
+        record.status = minter::tx::try_decode(encoded, record.tx);
+    }
+}
+
+/// Reads input by chunks and splits it into records
+class record_splitter {
+public:
+    record_splitter(std::istream &in, const minter::tx_stream_decoder::options &opts) :
+        m_in(in),
+        m_format(opts.format),
+        m_max_record_size(opts.max_record_size),
+        // hex, optional prefix and line end
+        m_max_line_size(opts.max_record_size * 2 + 4),
+        m_buf(opts.chunk_size + m_max_line_size + 4) {
+    }
+
+    /// \return false if stream has no more records
+    bool fill(batch &b, size_t max_records) {
+        while (b.records.size() < max_records) {
+            const bool has_record = m_format == minter::tx_stream_format::hex_lines ? next_line(b) : next_prefixed(b);
+            if (!has_record) {
+                break;
+            }
+        }
+        return !b.records.empty();
+    }
+
+    size_t bytes_read() const {
+        return m_bytes_read;
+    }
+
+private:
+    size_t available() const {
+        return m_end - m_pos;
+    }
+
+    // moves unread bytes to buffer start and reads next chunk after them
+    bool refill() {
+        if (m_eof) {
+            return false;
+        }
+        if (m_pos > 0) {
+            memmove(m_buf.data(), m_buf.data() + m_pos, available());
+            m_end -= m_pos;
+            m_pos = 0;
+        }
+
+        m_in.read((char *) m_buf.data() + m_end, m_buf.size() - m_end);
+        const size_t n = (size_t) m_in.gcount();
+        m_end += n;
+        m_bytes_read += n;
+        if (n == 0) {
+            m_eof = true;
+        }
+        return n != 0;
+    }
+
+    void add_record(batch &b, const uint8_t *data, size_t size) {
+        b.records.emplace_back(b.data.size(), size);
+        b.data.insert(b.data.end(), data, data + size);
+    }
+
+    // \return false if line is empty
+    bool add_line(batch &b, const uint8_t *line, size_t size) {
+        while (size > 0 && (line[size - 1] == '\r' || line[size - 1] == ' ' || line[size - 1] == '\t')) {
+            size--;
+        }
+        if (size == 0) {
+            return false;
+        }
+        if (size > m_max_line_size) {
+            b.records.emplace_back(b.data.size(), oversize_record);
+            return true;
+        }
+        add_record(b, line, size);
+        return true;
+    }
+
+    bool next_line(batch &b) {
+        for (;;) {
+            const uint8_t *begin = m_buf.data() + m_pos;
+            const auto *nl = (const uint8_t *) memchr(begin, '\n', available());
+            if (nl != nullptr) {
+                const size_t size = (size_t) (nl - begin);
+                m_pos += size + 1;
+                if (m_skip_line) {
+                    // tail of too long line
+                    m_skip_line = false;
+                    continue;
+                }
+                if (add_line(b, begin, size)) {
+                    return true;
+                }
+                continue;
+            }
+
+            if (m_skip_line) {
+                m_pos = m_end;
+            } else if (available() > m_max_line_size) {
+                // no need to keep it, it won't be decoded anyway
+                b.records.emplace_back(b.data.size(), oversize_record);
+                m_skip_line = true;
+                m_pos = m_end;
+                return true;
+            }
+
+            if (!refill()) {
+                // last line without line end
+                const size_t size = available();
+                m_pos = m_end;
+                return size > 0 && !m_skip_line && add_line(b, m_buf.data() + m_end - size, size);
+            }
+        }
+    }
+
+    bool next_prefixed(batch &b) {
+        while (available() < 4) {
+            if (!refill()) {
+                if (available() == 0) {
+                    return false;
+                }
+                throw std::runtime_error("Transactions stream is broken: truncated record length");
+            }
+        }
+
+        const uint8_t *p = m_buf.data() + m_pos;
+        const size_t size = ((size_t) p[0] << 24) | ((size_t) p[1] << 16) | ((size_t) p[2] << 8) | (size_t) p[3];
+        if (size > m_max_record_size) {
+            throw std::runtime_error("Transactions stream is broken: record is too big");
+        }
+
+        while (available() < 4 + size) {
+            if (!refill()) {
+                throw std::runtime_error("Transactions stream is broken: truncated record");
+            }
+        }
+
+        add_record(b, m_buf.data() + m_pos + 4, size);
+        m_pos += 4 + size;
+        return true;
+    }
+
+    std::istream &m_in;
+    minter::tx_stream_format m_format;
+    size_t m_max_record_size;
+    size_t m_max_line_size;
+    std::vector<uint8_t> m_buf;
+    size_t m_pos = 0;
+    size_t m_end = 0;
+    size_t m_bytes_read = 0;
+    bool m_eof = false;
+    bool m_skip_line = false;
+};
+
+}
+
+minter::tx_stream_decoder::tx_stream_decoder(const minter::tx_stream_decoder::options &opts) :
+    m_opts(opts) {
+    if (m_opts.threads == 0) {
+        m_opts.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (m_opts.max_batches == 0) {
+        m_opts.max_batches = m_opts.threads * 2;
+    }
+    if (m_opts.batch_size == 0) {
+        m_opts.batch_size = 1;
+    }
+}
+
+minter::tx_stream_decoder::tx_stream_decoder() :
+    tx_stream_decoder(options()) {
+}
+
+minter::tx_stream_stats minter::tx_stream_decoder::decode(std::istream &in, const callback &on_record) {
+    const auto start = std::chrono::steady_clock::now();
+    minter::tx_stream_stats stats;
+
+    record_splitter splitter(in, m_opts);
+    minter::ordered_batches<batch> pipeline(
+        m_opts.threads,
+        m_opts.max_batches,
+        [this](batch &b) { decode_batch(b, m_opts.format); },
+        [&stats, &on_record](const batch &b) {
+            for (const auto &record: b.results) {
+                stats.records++;
+                if (!record.status) {
+                    stats.failed++;
+                }
+                on_record(record);
+            }
+        });
+
+    size_t next_index = 0;
+    for (;;) {
+        std::unique_ptr<batch> b(new batch());
+        b->first_index = next_index;
+        if (!splitter.fill(*b, m_opts.batch_size)) {
+            break;
+        }
+        next_index += b->records.size();
+
+        pipeline.push(std::move(b));
+    }
+    pipeline.finish();
+
+    stats.bytes = splitter.bytes_read();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+minter::tx_stream_stats minter::tx_stream_decoder::decode_file(const std::string &path, const callback &on_record) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Can't open file: " + path);
+    }
+    return decode(in, on_record);
+}
@@ -7,6 +7,8 @@
  * \link   https://github.com/edwardstock
  */
 
+#include <array>
+#include <stdexcept>
 #include "minter/tx/tx_type.h"
 #include "minter/tx/tx_send_coin.h"
 #include "minter/tx/tx_sell_coin.h"
@@ -22,35 +24,94 @@
 #include "minter/tx/tx_multisend.h"
 #include "minter/tx/tx_edit_candidate.h"
 
-const std::unordered_map<minter::tx_type_val, std::string> minter::tx_type_names = {
-    {minter::tx_type_val::send_coin,         "send"},
-    {minter::tx_type_val::sell_coin,         "sell"},
-    {minter::tx_type_val::sell_all_coins,    "sell all"},
-    {minter::tx_type_val::buy_coin,          "buy"},
-    {minter::tx_type_val::create_coin,       "create coin"},
-    {minter::tx_type_val::declare_candidacy, "declare candidacy"},
-    {minter::tx_type_val::delegate,          "delegate"},
-    {minter::tx_type_val::unbond,            "unbond"},
-    {minter::tx_type_val::redeem_check,      "redeem check"},
-    {minter::tx_type_val::set_candidate_on,  "set candidate on"},
-    {minter::tx_type_val::set_candidate_off, "set candidate off"},
-    {minter::tx_type_val::create_multisig,   "create multisig address"},
-    {minter::tx_type_val::multisend,         "multisend"},
-    {minter::tx_type_val::edit_candidate,    "edit candidate"},
-};
-
-
-define_tx_type_funcs(tx_send_coin, tx_type_val::send_coin, 10u)
-define_tx_type_funcs(tx_sell_coin, tx_type_val::sell_coin, 100)
-define_tx_type_funcs(tx_sell_all_coins, tx_type_val::sell_all_coins, 100)
-define_tx_type_funcs(tx_buy_coin, tx_type_val::buy_coin, 100)
-define_tx_type_funcs(tx_create_coin, tx_type_val::create_coin, 1000)
-define_tx_type_funcs(tx_declare_candidacy, tx_type_val::declare_candidacy, 10000)
-define_tx_type_funcs(tx_delegate, tx_type_val::delegate, 200)
-define_tx_type_funcs(tx_unbond, tx_type_val::unbond, 200)
-define_tx_type_funcs(tx_redeem_check, tx_type_val::redeem_check, 30)
-define_tx_type_funcs(tx_set_candidate_on, tx_type_val::set_candidate_on, 100)
-define_tx_type_funcs(tx_set_candidate_off, tx_type_val::set_candidate_off, 100)
-define_tx_type_funcs(tx_create_multisig_address, tx_type_val::create_multisig, 100)
-define_tx_type_funcs(tx_multisend, tx_type_val::multisend, 100)
-define_tx_type_funcs(tx_edit_candidate, tx_type_val::edit_candidate, 10000)
\ No newline at end of file
+namespace {
+
+using registry_table = std::array<minter::tx_type_info, minter::tx_type_registry::max_types>;
+
+template<typename T>
+void put_builtin(registry_table &table, const char *name) {
+    minter::tx_type_info &info = table[minter::tx_type<T>::type()];
+    info.name = name;
+    info.get_fee = &minter::tx_type<T>::get_fee;
+    info.create = &minter::tx_type_registry::create_data<T>;
+    info.validate = &minter::schema_validate<T>;
+}
+
+registry_table &get_registry() {
+    static registry_table table = [] {
+        registry_table out;
+        put_builtin<minter::tx_send_coin>(out, "send");
+        put_builtin<minter::tx_sell_coin>(out, "sell");
+        put_builtin<minter::tx_sell_all_coins>(out, "sell all");
+        put_builtin<minter::tx_buy_coin>(out, "buy");
+        put_builtin<minter::tx_create_coin>(out, "create coin");
+        put_builtin<minter::tx_declare_candidacy>(out, "declare candidacy");
+        put_builtin<minter::tx_delegate>(out, "delegate");
+        put_builtin<minter::tx_unbond>(out, "unbond");
+        put_builtin<minter::tx_redeem_check>(out, "redeem check");
+        put_builtin<minter::tx_set_candidate_on>(out, "set candidate on");
+        put_builtin<minter::tx_set_candidate_off>(out, "set candidate off");
+        put_builtin<minter::tx_create_multisig_address>(out, "create multisig address");
+        put_builtin<minter::tx_multisend>(out, "multisend");
+        put_builtin<minter::tx_edit_candidate>(out, "edit candidate");
+        return out;
+    }();
+    return table;
+}
+
+}
+
+constexpr size_t minter::tx_type_registry::max_types;
+
+const minter::tx_type_info *minter::tx_type_registry::find(uint16_t type) {
+    if (type >= max_types) {
+        return nullptr;
+    }
+
+    const minter::tx_type_info &info = get_registry()[type];
+    return info.create != nullptr ? &info : nullptr;
+}
+
+const char *minter::tx_type_registry::name(uint16_t type) {
+    const minter::tx_type_info *info = find(type);
+    return info != nullptr ? info->name : nullptr;
+}
+
+void minter::tx_type_registry::add(uint16_t type, const minter::tx_type_info &info) {
+    if (type >= max_types) {
+        throw std::runtime_error("Transaction type must fit in one byte");
+    }
+    if (info.name == nullptr || info.create == nullptr) {
+        throw std::runtime_error("Transaction type must have name and create function");
+    }
+
+    get_registry()[type] = info;
+}
+
+define_tx_type_funcs(tx_send_coin, 10)
+define_tx_type_funcs(tx_sell_coin, 100)
+define_tx_type_funcs(tx_sell_all_coins, 100)
+define_tx_type_funcs(tx_buy_coin, 100)
+define_tx_type_funcs(tx_create_coin, 1000)
+define_tx_type_funcs(tx_declare_candidacy, 10000)
+define_tx_type_funcs(tx_delegate, 200)
+define_tx_type_funcs(tx_unbond, 200)
+define_tx_type_funcs(tx_redeem_check, 30)
+define_tx_type_funcs(tx_set_candidate_on, 100)
+define_tx_type_funcs(tx_set_candidate_off, 100)
+define_tx_type_funcs(tx_create_multisig_address, 100)
+define_tx_type_funcs(tx_multisend, 10)
+define_tx_type_funcs(tx_edit_candidate, 10000)
+
+dev::bigdec18 minter::get_payload_fee(size_t payload_size, const dev::bigint &gas) {
+    return dev::bigdec18(gas) * dev::bigdec18(payload_size * minter::PAYLOAD_BYTE_FEE)
+        * dev::bigdec18(minter::FEE_BASE_DEC);
+}
+
+dev::bigdec18 minter::get_multisend_fee(size_t items, size_t payload_size, const dev::bigint &gas) {
+    const size_t next_items = items > 1 ? items - 1 : 0;
+    return minter::tx_multisend_type::get_fee(gas)
+        + dev::bigdec18(gas) * dev::bigdec18(next_items * minter::MULTISEND_ITEM_FEE)
+            * dev::bigdec18(minter::FEE_BASE_DEC)
+        + get_payload_fee(payload_size, gas);
+}
@@ -16,9 +16,11 @@ minter::tx_unbond::tx_unbond(std::shared_ptr<minter::tx> tx)
 }
 
 void minter::tx_unbond::decode_internal(dev::RLP rlp) {
-    m_pub_key = (dev::bytes)rlp[0];
-    m_coin = minter::utils::to_string_clear((dev::bytes)rlp[1]);
-    m_value = (dev::bigint) rlp[2];
+    minter::schema_decode(*this, rlp);
+}
+
+minter::decode_status minter::tx_unbond::try_decode_internal(const dev::RLP &rlp) {
+    return minter::schema_try_decode(*this, rlp);
 }
 
 uint16_t minter::tx_unbond::type() const {
@@ -27,16 +29,11 @@ uint16_t minter::tx_unbond::type() const {
 
 #include <iostream>
 dev::bytes minter::tx_unbond::encode() {
-    dev::RLPStream out;
-    dev::RLPStream lst;
-    {
-        lst.append((dev::bytes)m_pub_key);
-        lst.append(minter::utils::to_bytes_fixed(m_coin, 10));
-        lst.append(m_value);
-        out.appendList(lst);
-    }
+    return minter::schema_encode(*this);
+}
 
-    return out.out();
+size_t minter::tx_unbond::encoded_size() const {
+    return minter::schema_encoded_size(*this);
 }
 
 minter::tx_unbond &minter::tx_unbond::set_pub_key(const dev::bytes &pub_key) {
@@ -44,11 +41,16 @@ minter::tx_unbond &minter::tx_unbond::set_pub_key(const dev::bytes &pub_key) {
     return *this;
 }
 minter::tx_unbond &minter::tx_unbond::set_pub_key(const minter::pubkey_t &pub_key) {
-    m_pub_key = pub_key;
+    m_pub_key = pub_key.get();
     return *this;
 }
 minter::tx_unbond &minter::tx_unbond::set_coin(const char* coin) {
-    m_coin = std::string(coin);
+    m_coin = coin;
+    return *this;
+}
+
+minter::tx_unbond &minter::tx_unbond::set_coin(const minter::coin_symbol &coin) {
+    m_coin = coin;
     return *this;
 }
 minter::tx_unbond &minter::tx_unbond::set_coin(const std::string &coin) {
@@ -63,10 +65,10 @@ minter::tx_unbond &minter::tx_unbond::set_value(const dev::bigdec18 &value) {
     m_value = minter::utils::normalize_value(value);
     return *this;
 }
-const minter::pubkey_t &minter::tx_unbond::get_pub_key() const {
-    return m_pub_key;
+minter::pubkey_t minter::tx_unbond::get_pub_key() const {
+    return minter::pubkey_t(m_pub_key.to_bytes());
 }
-std::string minter::tx_unbond::get_coin() const {
+minter::coin_symbol minter::tx_unbond::get_coin() const {
     return m_coin;
 }
 dev::bigdec18 minter::tx_unbond::get_value() const {
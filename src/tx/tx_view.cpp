@@ -0,0 +1,127 @@
+/*!
+ * minter_tx.
+ * tx_view.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "minter/tx/tx_view.h"
+
+namespace {
+
+// reads canonical big-endian unsigned integer, as RLP stores it
+template<typename T>
+T read_uint(dev::bytesConstRef data, const char *field) {
+    if (data.size() > sizeof(T)) {
+        throw std::runtime_error(std::string("Transaction field is too big: ") + field);
+    }
+    if (!data.empty() && data[0] == 0) {
+        throw std::runtime_error(std::string("Transaction field has leading zeroes: ") + field);
+    }
+
+    T out = 0;
+    for (size_t i = 0; i < data.size(); i++) {
+        out = (T) ((out << 8) | data[i]);
+    }
+    return out;
+}
+
+void require_list(dev::bytesConstRef data, const char *field) {
+    // throws if list header doesn't match its content
+    dev::RLP rlp(data);
+    if (!rlp.isList()) {
+        throw std::runtime_error(std::string("Transaction field must be RLP list: ") + field);
+    }
+}
+
+}
+
+constexpr size_t minter::tx_view::fields_count;
+
+minter::tx_view::tx_view(dev::bytesConstRef encoded) :
+    m_encoded(encoded) {
+    dev::RLP s(encoded);
+    if (!s.isList()) {
+        throw std::runtime_error("Invalid transaction: RLP list required");
+    }
+
+    size_t n = 0;
+    for (const auto &item: s) {
+        if (n == fields_count) {
+            throw std::runtime_error("Invalid RLP length: required 10 elements");
+        }
+        if (!item.isData()) {
+            throw std::runtime_error("Invalid transaction: all fields must be RLP strings");
+        }
+        m_fields[n++] = item.toBytesConstRef();
+    }
+    if (n != fields_count) {
+        throw std::runtime_error("Invalid RLP length: required 10 elements");
+    }
+
+    m_chain_id = read_uint<uint8_t>(m_fields[chain_id], "chain_id");
+    m_type = read_uint<uint16_t>(m_fields[type], "type");
+    m_signature_type = read_uint<uint8_t>(m_fields[signature_type], "signature_type");
+    if (m_fields[gas_coin].size() > minter::coin_symbol::max_length) {
+        throw std::runtime_error("Transaction field is too big: gas_coin");
+    }
+    require_list(m_fields[data], "data");
+    const minter::decode_status status = minter::tx::validate_signature(m_signature_type, m_fields[signature]);
+    if (!status) {
+        throw std::runtime_error(std::string("Invalid transaction signature: ") + status.message());
+    }
+}
+
+dev::bytesConstRef minter::tx_view::get_encoded() const {
+    return m_encoded;
+}
+
+dev::bytesConstRef minter::tx_view::get_nonce_raw() const {
+    return m_fields[nonce];
+}
+
+uint64_t minter::tx_view::get_nonce() const {
+    return read_uint<uint64_t>(m_fields[nonce], "nonce");
+}
+
+uint8_t minter::tx_view::get_chain_id() const {
+    return m_chain_id;
+}
+
+dev::bytesConstRef minter::tx_view::get_gas_price_raw() const {
+    return m_fields[gas_price];
+}
+
+uint64_t minter::tx_view::get_gas_price() const {
+    return read_uint<uint64_t>(m_fields[gas_price], "gas_price");
+}
+
+minter::coin_symbol minter::tx_view::get_gas_coin() const {
+    return minter::coin_symbol(m_fields[gas_coin]);
+}
+
+uint16_t minter::tx_view::get_type() const {
+    return m_type;
+}
+
+dev::bytesConstRef minter::tx_view::get_data_raw() const {
+    return m_fields[data];
+}
+
+dev::bytesConstRef minter::tx_view::get_payload() const {
+    return m_fields[payload];
+}
+
+dev::bytesConstRef minter::tx_view::get_service_data() const {
+    return m_fields[service_data];
+}
+
+uint8_t minter::tx_view::get_signature_type() const {
+    return m_signature_type;
+}
+
+dev::bytesConstRef minter::tx_view::get_signature_raw() const {
+    return m_fields[signature];
+}
@@ -0,0 +1,279 @@
+/*!
+ * minter_tx.
+ * tx_withdrawal_coalescer.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "minter/tx/tx_builder.h"
+#include "minter/tx/tx_multisend_planner.h"
+#include "minter/tx/tx_type.h"
+#include "minter/tx/tx_withdrawal_coalescer.h"
+#include "minter/tx/utils.h"
+
+namespace {
+
+// fee of a single item, sent as send coin transaction, in pips
+dev::bigint send_fee(const minter::tx_withdrawal_coalescer::options &opts) {
+    return minter::utils::normalize_value(minter::tx_send_coin_type::get_fee(opts.gas_price)
+                                              + minter::get_payload_fee(opts.payload.size(), opts.gas_price));
+}
+
+}
+
+minter::tx_withdrawal_coalescer::tx_withdrawal_coalescer(const minter::data::private_key &pk,
+                                                         minter::nonce_allocator &nonces,
+                                                         const minter::tx_withdrawal_coalescer::options &opts,
+                                                         minter::tx_withdrawal_coalescer::callback on_tx) :
+    m_pk(pk),
+    m_nonces(nonces),
+    m_opts(opts),
+    m_on_tx(std::move(on_tx)) {
+    if (m_opts.max_items == 0) {
+        throw std::runtime_error("Max items per transaction must be greater than 0");
+    }
+    m_batcher = std::thread([this] { run_batcher(); });
+    const size_t threads = std::max<size_t>(1, m_opts.threads);
+    for (size_t i = 0; i < threads; i++) {
+        m_signers.emplace_back([this] { run_signer(); });
+    }
+}
+
+minter::tx_withdrawal_coalescer::~tx_withdrawal_coalescer() {
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+        if (!m_current.empty()) {
+            close_batch();
+        }
+    }
+    m_batch_cv.notify_all();
+    m_sign_cv.notify_all();
+    m_batcher.join();
+    for (auto &t: m_signers) {
+        t.join();
+    }
+}
+
+std::future<minter::tx_withdrawal_coalescer::tx_ptr> minter::tx_withdrawal_coalescer::submit(
+    const minter::send_target &withdrawal) {
+    pending_item item;
+    item.target = withdrawal;
+    item.submitted = clock::now();
+    std::future<tx_ptr> out = item.done.get_future();
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_stop) {
+        throw std::runtime_error("Coalescer is stopped");
+    }
+    if (m_current.empty()) {
+        m_current_start = item.submitted;
+        m_batch_cv.notify_one();
+    }
+    m_current.push_back(std::move(item));
+    if (m_current.size() >= m_opts.max_items) {
+        close_batch();
+    }
+    return out;
+}
+
+void minter::tx_withdrawal_coalescer::flush() {
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (!m_current.empty()) {
+        close_batch();
+    }
+}
+
+minter::tx_coalescer_stats minter::tx_withdrawal_coalescer::stats() const {
+    minter::tx_coalescer_stats out;
+    std::vector<int64_t> latencies;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        out = m_stats;
+        latencies = m_latencies;
+    }
+    if (latencies.empty()) {
+        return out;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double q) {
+        const size_t i = std::min(latencies.size() - 1, (size_t) (q * latencies.size()));
+        return latencies[i] / 1e6;
+    };
+    out.latency_p50 = percentile(0.5);
+    out.latency_p90 = percentile(0.9);
+    out.latency_p99 = percentile(0.99);
+    out.latency_max = latencies.back() / 1e6;
+    return out;
+}
+
+void minter::tx_withdrawal_coalescer::run_batcher() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    for (;;) {
+        m_batch_cv.wait(lock, [this] { return m_stop || !m_current.empty(); });
+        if (m_stop) {
+            return;
+        }
+
+        // batch can be closed by submit() or flush() meanwhile, and next one started
+        const size_t seq = m_batch_seq;
+        const bool same_batch = !m_batch_cv.wait_until(lock, m_current_start + m_opts.window, [this, seq] {
+            return m_stop || m_batch_seq != seq;
+        });
+        if (same_batch) {
+            close_batch();
+        }
+    }
+}
+
+void minter::tx_withdrawal_coalescer::run_signer() {
+    for (;;) {
+        std::unique_ptr<batch> b;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_sign_cv.wait(lock, [this] { return m_stop || !m_closed.empty(); });
+            if (m_closed.empty()) {
+                return;
+            }
+            b = std::move(m_closed.front());
+            m_closed.pop_front();
+        }
+        sign_batch(*b);
+    }
+}
+
+void minter::tx_withdrawal_coalescer::close_batch() {
+    std::unique_ptr<batch> b(new batch());
+    b->seq = m_batch_seq++;
+    b->items = std::move(m_current);
+    m_current.clear();
+    if (m_delivered_seq < m_fail_until) {
+        // failed batches still hold lower nonces
+        m_deferred.push_back(std::move(b));
+        return;
+    }
+    b->nonce = m_nonces.reserve();
+    m_reserved_until = b->seq + 1;
+    m_closed.push_back(std::move(b));
+    m_sign_cv.notify_one();
+}
+
+void minter::tx_withdrawal_coalescer::sign_batch(minter::tx_withdrawal_coalescer::batch &b) {
+    std::shared_ptr<minter::coalesced_tx> tx;
+    std::exception_ptr error;
+    try {
+        tx = std::make_shared<minter::coalesced_tx>();
+        tx->nonce = b.nonce.nonce();
+        tx->items.reserve(b.items.size());
+        for (const auto &item: b.items) {
+            tx->items.push_back(item.target);
+        }
+        tx->fee = tx->items.size() == 1
+                  ? send_fee(m_opts)
+                  : minter::tx_multisend_planner::fee(tx->items.size(), m_opts.payload.size(), m_opts.gas_price);
+
+        auto builder = minter::new_tx();
+        builder->set_nonce(b.nonce)
+            .set_chain_id(m_opts.chain_id)
+            .set_gas_price(m_opts.gas_price)
+            .set_gas_coin(m_opts.gas_coin)
+            .set_payload(m_opts.payload);
+        if (tx->items.size() == 1) {
+            const minter::send_target &item = tx->items.front();
+            tx->data = builder->tx_send_coin()->set_coin(item.coin).set_to(item.to).set_value(item.amount)
+                .build()->sign_single(m_pk);
+        } else {
+            auto data = builder->tx_multisend();
+            for (const auto &item: tx->items) {
+                data->add_item(item.coin, item.to, item.amount);
+            }
+            tx->data = data->build()->sign_single(m_pk);
+        }
+        if (tx->data == minter::Data("0x0")) {
+            throw std::runtime_error("Unable to sign transaction with nonce " + std::to_string(tx->nonce));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    const clock::time_point now = clock::now();
+
+    // batches are signed concurrently: wait for the previous ones, so callback sends transactions in nonce order
+    bool behind_failed = false;
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_deliver_cv.wait(lock, [this, &b] { return m_delivered_seq == b.seq; });
+        behind_failed = b.seq < m_fail_until;
+        if (!error && behind_failed) {
+            error = std::make_exception_ptr(std::runtime_error("Transaction with lower nonce is not sent"));
+        }
+    }
+    if (!error) {
+        try {
+            if (m_on_tx) {
+                m_on_tx(tx);
+            }
+            b.nonce.commit();
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (error) {
+            // batches behind with reserved nonces can't be sent before this one: fail them too.
+            // Deferred batches have no nonces yet, they stay out of this range, so they are released below
+            if (!behind_failed) {
+                m_fail_until = std::max(m_fail_until, m_reserved_until);
+            }
+            b.nonce.release();
+        }
+        m_delivered_seq++;
+        for (const auto &item: b.items) {
+            add_latency(now - item.submitted);
+        }
+        if (!error) {
+            m_stats.items += tx->items.size();
+            m_stats.txs++;
+            m_stats.single_txs += tx->items.size() == 1 ? 1 : 0;
+            m_stats.fee += tx->fee;
+            m_stats.saved_fee += send_fee(m_opts) * tx->items.size() - tx->fee;
+        }
+        if (m_delivered_seq == m_fail_until && !m_deferred.empty()) {
+            // all failed nonces are released, batches closed meanwhile take them in order
+            for (auto &deferred: m_deferred) {
+                deferred->nonce = m_nonces.reserve();
+                m_reserved_until = deferred->seq + 1;
+                m_closed.push_back(std::move(deferred));
+            }
+            m_deferred.clear();
+            m_sign_cv.notify_all();
+        }
+    }
+    m_deliver_cv.notify_all();
+
+    for (auto &item: b.items) {
+        if (error) {
+            item.done.set_exception(error);
+        } else {
+            item.done.set_value(tx);
+        }
+    }
+}
+
+void minter::tx_withdrawal_coalescer::add_latency(std::chrono::nanoseconds latency) {
+    if (m_opts.latency_samples == 0) {
+        return;
+    }
+    if (m_latencies.size() < m_opts.latency_samples) {
+        m_latencies.push_back(latency.count());
+        return;
+    }
+    m_latencies[m_latency_pos] = latency.count();
+    m_latency_pos = (m_latency_pos + 1) % m_opts.latency_samples;
+}
@@ -0,0 +1,370 @@
+/*!
+ * minter_tx.
+ * value_tx.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <stdexcept>
+#include <string>
+#include "minter/tx/value_tx.h"
+#include "minter/hex.h"
+#include "minter/tx/signed_layout.h"
+#include "minter/tx/tx_type.h"
+#include "minter/tx/utils.h"
+
+namespace {
+
+struct type_visitor : public boost::static_visitor<uint16_t> {
+  template<typename T>
+  uint16_t operator()(const T &data) const {
+      return data.type();
+  }
+};
+
+// data types are known here, so schema functions are called directly, without virtual calls
+struct encode_visitor : public boost::static_visitor<dev::bytes> {
+  template<typename T>
+  dev::bytes operator()(const T &data) const {
+      return minter::schema_encode(data);
+  }
+};
+
+struct encoded_size_visitor : public boost::static_visitor<size_t> {
+  template<typename T>
+  size_t operator()(const T &data) const {
+      return minter::schema_encoded_size(data);
+  }
+};
+
+struct write_visitor : public boost::static_visitor<size_t> {
+  explicit write_visitor(uint8_t *out) : out(out) { }
+
+  template<typename T>
+  size_t operator()(const T &data) const {
+      return minter::schema_write(out, data);
+  }
+
+  uint8_t *out;
+};
+
+struct decode_visitor : public boost::static_visitor<void> {
+  explicit decode_visitor(dev::bytesConstRef encoded) : encoded(encoded) { }
+
+  template<typename T>
+  void operator()(T &data) const {
+      minter::schema_decode(data, dev::RLP(encoded));
+  }
+
+  dev::bytesConstRef encoded;
+};
+
+struct arena_visitor : public boost::static_visitor<void> {
+  explicit arena_visitor(minter::arena *arena) : arena(arena) { }
+
+  template<typename T>
+  void operator()(T &) const {
+  }
+  void operator()(minter::tx_multisend &data) const {
+      data.set_arena(arena);
+  }
+
+  minter::arena *arena;
+};
+
+// creating context allocates and precomputes tables, so every signing thread keeps one
+const minter::secp256k1_raii &thread_secp() {
+    thread_local const minter::secp256k1_raii secp;
+    return secp;
+}
+
+minter::tx_payload create_payload(uint16_t type) {
+    switch (type) {
+        case minter::tx_type_val::send_coin: return minter::tx_send_coin();
+        case minter::tx_type_val::sell_coin: return minter::tx_sell_coin();
+        case minter::tx_type_val::sell_all_coins: return minter::tx_sell_all_coins();
+        case minter::tx_type_val::buy_coin: return minter::tx_buy_coin();
+        case minter::tx_type_val::create_coin: return minter::tx_create_coin();
+        case minter::tx_type_val::declare_candidacy: return minter::tx_declare_candidacy();
+        case minter::tx_type_val::delegate: return minter::tx_delegate();
+        case minter::tx_type_val::unbond: return minter::tx_unbond();
+        case minter::tx_type_val::redeem_check: return minter::tx_redeem_check();
+        case minter::tx_type_val::set_candidate_on: return minter::tx_set_candidate_on();
+        case minter::tx_type_val::set_candidate_off: return minter::tx_set_candidate_off();
+        case minter::tx_type_val::create_multisig: return minter::tx_create_multisig_address();
+        case minter::tx_type_val::multisend: return minter::tx_multisend();
+        case minter::tx_type_val::edit_candidate: return minter::tx_edit_candidate();
+        default: throw std::runtime_error("Unknown transaction type");
+    }
+}
+
+}
+
+minter::value_tx::value_tx() :
+    value_tx(nullptr) {
+}
+
+minter::value_tx::value_tx(minter::arena *arena) :
+    m_chain_id(dev::bigint(chain_id::testnet)),
+    m_gas_price(dev::bigint("1")),
+    m_gas_coin("MNT"),
+    m_payload(arena),
+    m_service_data(arena),
+    m_signature(arena),
+    m_arena(arena) {
+}
+
+minter::value_tx minter::value_tx::decode(dev::bytesConstRef encoded) {
+    value_tx out;
+    decode_into(encoded, out);
+    return out;
+}
+
+minter::value_tx minter::value_tx::decode(dev::bytesConstRef encoded, minter::arena &arena) {
+    value_tx out(&arena);
+    decode_into(encoded, out);
+    return out;
+}
+
+void minter::value_tx::decode_into(dev::bytesConstRef encoded, minter::value_tx &out) {
+    // same checks as minter::tx::decode(), so below nothing is read outside of data
+    const minter::decode_status status = minter::tx::validate(encoded);
+    if (!status) {
+        throw std::runtime_error(
+            std::string("Invalid transaction: ") + status.message() + " at offset " + std::to_string(status.offset));
+    }
+
+    const dev::RLP s(encoded);
+    out.m_nonce = (dev::bigint) s[0];
+    out.m_chain_id = (dev::bigint) s[1];
+    out.m_gas_price = (dev::bigint) s[2];
+    out.m_gas_coin = minter::coin_symbol(s[3].toBytesConstRef());
+    out.m_data = create_payload((uint16_t) s[4]);
+    out.attach_arena();
+    boost::apply_visitor(decode_visitor(s[5].toBytesConstRef()), out.m_data);
+    out.m_payload = s[6].toBytesConstRef();
+    out.m_service_data = s[7].toBytesConstRef();
+    out.m_signature_type = (dev::bigint) s[8];
+    out.m_signature = s[9].toBytesConstRef();
+}
+
+minter::value_tx minter::value_tx::decode(const char *hexEncoded) {
+    const dev::bytes data = minter::from_hex(hexEncoded);
+    return decode(dev::bytesConstRef(&data));
+}
+
+minter::value_tx &minter::value_tx::set_nonce(const dev::bigint &nonce) {
+    m_nonce = nonce;
+    m_signature.clear();
+    return *this;
+}
+
+minter::value_tx &minter::value_tx::set_chain_id(uint8_t id) {
+    m_chain_id = id;
+    m_signature.clear();
+    return *this;
+}
+
+minter::value_tx &minter::value_tx::set_gas_price(const dev::bigint &amount) {
+    m_gas_price = amount;
+    m_signature.clear();
+    return *this;
+}
+
+minter::value_tx &minter::value_tx::set_gas_coin(const minter::coin_symbol &coin) {
+    m_gas_coin = coin;
+    m_signature.clear();
+    return *this;
+}
+
+minter::value_tx &minter::value_tx::set_payload(dev::bytesConstRef payload) {
+    m_payload = payload;
+    m_signature.clear();
+    return *this;
+}
+
+minter::value_tx &minter::value_tx::set_service_data(dev::bytesConstRef service_data) {
+    m_service_data = service_data;
+    m_signature.clear();
+    return *this;
+}
+
+minter::value_tx &minter::value_tx::set_data(const minter::tx_payload &data) {
+    m_data = data;
+    m_signature.clear();
+    attach_arena();
+    return *this;
+}
+
+minter::value_tx &minter::value_tx::set_data(minter::tx_payload &&data) {
+    m_data = std::move(data);
+    m_signature.clear();
+    attach_arena();
+    return *this;
+}
+
+void minter::value_tx::attach_arena() {
+    boost::apply_visitor(arena_visitor(m_arena), m_data);
+}
+
+dev::bigint minter::value_tx::get_nonce() const {
+    return m_nonce;
+}
+
+uint8_t minter::value_tx::get_chain_id() const {
+    return static_cast<uint8_t>(m_chain_id);
+}
+
+dev::bigint minter::value_tx::get_gas_price() const {
+    return m_gas_price;
+}
+
+minter::coin_symbol minter::value_tx::get_gas_coin() const {
+    return m_gas_coin;
+}
+
+uint16_t minter::value_tx::get_type() const {
+    return boost::apply_visitor(type_visitor(), m_data);
+}
+
+const minter::small_bytes<64> &minter::value_tx::get_payload() const {
+    return m_payload;
+}
+
+const minter::small_bytes<32> &minter::value_tx::get_service_data() const {
+    return m_service_data;
+}
+
+uint8_t minter::value_tx::get_signature_type() const {
+    return static_cast<uint8_t>(m_signature_type);
+}
+
+const minter::tx_payload &minter::value_tx::get_data_variant() const {
+    return m_data;
+}
+
+size_t minter::value_tx::encoded_size(minter::tx_encoding encoding) const {
+    return dev::rlpListSize(payload_size(encoding));
+}
+
+size_t minter::value_tx::payload_size(minter::tx_encoding encoding) const {
+    size_t payload_size = 0;
+    payload_size += dev::rlpItemSize(m_nonce);
+    payload_size += dev::rlpItemSize(m_chain_id);
+    payload_size += dev::rlpItemSize(m_gas_price);
+    payload_size += dev::rlpDataSize(minter::coin_symbol::max_length);
+    payload_size += dev::rlpItemSize(dev::bigint(get_type()));
+    payload_size += dev::rlpDataSize(boost::apply_visitor(encoded_size_visitor(), m_data));
+    payload_size += dev::rlpItemSize(m_payload);
+    payload_size += dev::rlpItemSize(m_service_data);
+    payload_size += dev::rlpItemSize(m_signature_type);
+
+    if (encoding == minter::tx_encoding::signed_tx) {
+        const size_t signature_size = !m_signature.empty() ? m_signature.size() : minter::single_signed_layout::signature_size;
+        payload_size += dev::rlpDataSize(signature_size);
+    }
+
+    return payload_size;
+}
+
+void minter::value_tx::encode_to(minter::rlp_sink &out, minter::tx_encoding encoding) const {
+    const bool is_signed = encoding == minter::tx_encoding::signed_tx;
+    if (is_signed && m_signature.empty()) {
+        throw std::runtime_error("Transaction is not signed");
+    }
+
+    // data of most types fits inline
+    minter::small_bytes<128> data;
+    data.resize(boost::apply_visitor(encoded_size_visitor(), m_data));
+    boost::apply_visitor(write_visitor(data.data()), m_data);
+
+    out.append_list(payload_size(encoding));
+    out.append(m_nonce)
+        .append(m_chain_id)
+        .append(m_gas_price)
+        .append(m_gas_coin.encoded())
+        .append(dev::bigint(get_type()))
+        .append(data.ref())
+        .append(m_payload.ref())
+        .append(m_service_data.ref())
+        .append(m_signature_type);
+
+    if (is_signed) {
+        out.append(m_signature.ref());
+    }
+}
+
+dev::bytes minter::value_tx::encode(minter::tx_encoding encoding) {
+    dev::bytes out;
+    out.reserve(encoded_size(encoding));
+    minter::rlp_buffer_sink sink(out);
+    encode_to(sink, encoding);
+    return out;
+}
+
+minter::Data minter::value_tx::sign_single(const minter::data::private_key &pk) {
+    m_signature_type = minter::signature_type::single;
+
+    // unsigned transaction is hashed as it is encoded, without building it
+    dev::bytes hash(32);
+    minter::rlp_hash_sink hasher;
+    encode_to(hasher, minter::tx_encoding::unsigned_data);
+    hasher.finish(hash.data());
+
+    minter::secp256k1_raii secp;
+    auto sig = minter::tx::sign_with_private(secp, hash, pk.get());
+
+    if (!sig.success) {
+        return minter::Data("0x0");
+    }
+
+    minter::signature_single_data sig_data;
+    sig_data.set_signature(sig);
+    m_signature = sig_data.encode();
+
+    return minter::Data(encode(minter::tx_encoding::signed_tx));
+}
+
+dev::bytesConstRef minter::value_tx::sign_single(const minter::data::private_key &pk, minter::arena &out) {
+    m_signature_type = minter::signature_type::single;
+
+    const dev::bigint type = get_type();
+    const size_t data_size = boost::apply_visitor(encoded_size_visitor(), m_data);
+    const size_t fields = dev::rlpItemSize(m_nonce) +
+        dev::rlpItemSize(m_chain_id) +
+        dev::rlpItemSize(m_gas_price) +
+        dev::rlpDataSize(minter::coin_symbol::max_length) +
+        dev::rlpItemSize(type) +
+        dev::rlpDataSize(data_size) +
+        dev::rlpItemSize(m_payload) +
+        dev::rlpItemSize(m_service_data) +
+        dev::rlpItemSize(m_signature_type);
+
+    const minter::single_signed_layout layout(fields);
+    dev::bytesRef buffer = out.allocate_bytes(layout.size());
+    uint8_t *p = buffer.data() + layout.fields_offset();
+    p += dev::rlpWriteItem(p, m_nonce);
+    p += dev::rlpWriteItem(p, m_chain_id);
+    p += dev::rlpWriteItem(p, m_gas_price);
+    p += dev::rlpWriteItem(p, m_gas_coin.encoded());
+    p += dev::rlpWriteItem(p, type);
+    p += dev::rlpWriteHeader(p, data_size, false);
+    p += boost::apply_visitor(write_visitor(p), m_data);
+    p += dev::rlpWriteItem(p, m_payload);
+    p += dev::rlpWriteItem(p, m_service_data);
+    dev::rlpWriteItem(p, m_signature_type);
+
+    const dev::bytesConstRef unsigned_data = layout.write_unsigned_header(buffer);
+    uint8_t hash[32];
+    minter::utils::sha3k_into(unsigned_data.data(), unsigned_data.size(), hash);
+
+    auto sig = minter::tx::sign_with_private(thread_secp(), hash, pk.get().data());
+    if (!sig.success) {
+        return dev::bytesConstRef();
+    }
+    m_signature = layout.write_signature(buffer, sig);
+
+    return dev::bytesConstRef(buffer.data(), buffer.size());
+}
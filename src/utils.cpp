@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <minter/crypto/sha3.h>
 #include <minter/tx/utils.h>
+#include <minter/hex.h>
 
 dev::bytes minter::utils::to_bytes(std::string &&input) {
     if(!input.size()) {
@@ -78,15 +79,18 @@ dev::bytes minter::utils::sha3k(const minter::Data &message) {
 }
 
 dev::bytes minter::utils::sha3k(const dev::bytes &message) {
-    SHA3_CTX hash_ctx;
     dev::bytes output(32);
-    keccak_256_Init(&hash_ctx);
-    keccak_Update(&hash_ctx, message.data(), message.size());
-    keccak_Final(&hash_ctx, &output[0]);
-
+    sha3k_into(message.data(), message.size(), output.data());
     return output;
 }
 
+void minter::utils::sha3k_into(const uint8_t *data, size_t size, uint8_t *out) {
+    SHA3_CTX hash_ctx;
+    keccak_256_Init(&hash_ctx);
+    keccak_Update(&hash_ctx, data, size);
+    keccak_Final(&hash_ctx, out);
+}
+
 dev::bigint minter::utils::to_bigint(const dev::bytes &bytes) {
     dev::bigint val;
     boost::multiprecision::import_bits(val, bytes.begin(), bytes.end());
@@ -180,18 +184,16 @@ dev::bigdec18 minter::utils::humanize_value(const dev::bigint &value) {
 }
 
 std::ostream &operator << (std::ostream &out, const minter::Data &d) {
-    out << d.toHex();
+    minter::write_hex(out, dev::bytesConstRef(&d.get()));
     return out;
 }
 
 std::ostream &operator << (std::ostream &out, const dev::bytes &d) {
-    minter::Data tmp(d);
-    out << tmp.toHex();
+    minter::write_hex(out, dev::bytesConstRef(&d));
     return out;
 }
 
 std::ostream &operator << (std::ostream &out, const dev::RLPStream &rlp) {
-    minter::Data tmp(rlp.out());
-    out << tmp.toHex();
+    minter::write_hex(out, dev::bytesConstRef(&rlp.out()));
     return out;
 }
\ No newline at end of file
@@ -0,0 +1,19 @@
+/*!
+ * minter_tx.
+ * alloc_counter.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TESTS_ALLOC_COUNTER_H
+#define MINTER_TESTS_ALLOC_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+
+/// \brief Number of operator new calls made by the test binary, see alloc_counter.cpp
+extern std::atomic<size_t> allocations;
+
+#endif //MINTER_TESTS_ALLOC_COUNTER_H
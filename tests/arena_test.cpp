@@ -0,0 +1,155 @@
+/*!
+ * minter_tx.
+ * arena_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <gtest/gtest.h>
+#include <minter/arena.h>
+#include <minter/small_bytes.h>
+#include <minter/tx/value_tx.h>
+#include "alloc_counter.h"
+
+TEST(Arena, AllocateAndRelease) {
+    minter::arena arena(1024);
+    ASSERT_EQ(0, arena.capacity());
+
+    void *a = arena.allocate(10, 1);
+    auto *b = (uint64_t *) arena.allocate(sizeof(uint64_t), alignof(uint64_t));
+    ASSERT_NE(nullptr, a);
+    ASSERT_EQ(0, ((uintptr_t) b) % alignof(uint64_t));
+    ASSERT_EQ(1024, arena.capacity());
+
+    // bigger than chunk
+    dev::bytesRef big = arena.allocate_bytes(5000);
+    ASSERT_EQ(5000, big.size());
+    ASSERT_GT(arena.capacity(), 5000);
+
+    arena.release();
+    ASSERT_EQ(0, arena.allocated());
+    ASSERT_EQ(1024, arena.capacity());
+}
+
+TEST(Arena, OversizedFirstChunkIsNotKept) {
+    minter::arena arena(1024);
+    arena.allocate_bytes(5000);
+    ASSERT_GE(arena.capacity(), 5000);
+
+    arena.release();
+    ASSERT_EQ(0, arena.allocated());
+    ASSERT_EQ(0, arena.capacity());
+
+    arena.allocate_bytes(10);
+    ASSERT_EQ(1024, arena.capacity());
+}
+
+TEST(Arena, SmallBytesInArena) {
+    minter::arena arena;
+    arena.allocate(1);
+    const dev::bytes source(100, 0xAB);
+
+    const size_t before = allocations;
+    minter::small_bytes<8> a(&arena);
+    a = dev::bytesConstRef(&source);
+    a.push_back(0x01);
+    minter::small_bytes<8> b = a;
+    ASSERT_EQ(before, allocations.load());
+
+    ASSERT_TRUE(arena.contains(a.data()));
+    ASSERT_TRUE(arena.contains(b.data()));
+    ASSERT_NE(a.data(), b.data());
+    ASSERT_EQ(101, b.size());
+    ASSERT_EQ(0x01, b[100]);
+    ASSERT_EQ(a, b);
+
+    b.resize(4);
+    ASSERT_TRUE(b.is_inline());
+    ASSERT_EQ(dev::bytes(4, 0xAB), b.to_bytes());
+
+    minter::small_bytes<8> heap;
+    heap = a;
+    ASSERT_EQ(&arena, heap.get_arena());
+    ASSERT_TRUE(arena.contains(heap.data()));
+}
+
+TEST(Arena, TxDataInArena) {
+    minter::arena arena;
+    const std::string payload(100, 'p');
+
+    minter::value_tx tx(&arena);
+    tx.set_payload(dev::bytesConstRef(payload))
+        .set_data<minter::tx_multisend>()
+        .add_item("MNT", minter::data::address("Mx0000000000000000000000000000000000000001"), "1")
+        .add_item("BIP", minter::data::address("Mx0000000000000000000000000000000000000002"), "2");
+    ASSERT_TRUE(arena.contains(tx.get_payload().data()));
+    const auto &items = tx.get_data<minter::tx_multisend>()->get_items();
+    ASSERT_EQ(&arena, items.get_arena());
+    ASSERT_TRUE(arena.contains(items.to(1).data()));
+
+    minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+    const dev::bytesConstRef signed_tx = tx.sign_single(pk, arena);
+
+    minter::value_tx expected;
+    expected.set_payload(dev::bytesConstRef(payload))
+        .set_data<minter::tx_multisend>()
+        .add_item("MNT", minter::data::address("Mx0000000000000000000000000000000000000001"), "1")
+        .add_item("BIP", minter::data::address("Mx0000000000000000000000000000000000000002"), "2");
+    ASSERT_EQ(nullptr, expected.get_data<minter::tx_multisend>()->get_items().get_arena());
+    ASSERT_EQ(expected.sign_single(pk).get(), signed_tx.toBytes());
+
+    minter::value_tx decoded = minter::value_tx::decode(signed_tx, arena);
+    ASSERT_TRUE(arena.contains(decoded.get_payload().data()));
+    ASSERT_TRUE(arena.contains(decoded.get_data<minter::tx_multisend>()->get_items().to(0).data()));
+    ASSERT_EQ(signed_tx.toBytes(), decoded.encode());
+}
+
+TEST(Arena, SignWithoutAllocations) {
+    minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+    minter::arena arena;
+    minter::value_tx tx(&arena);
+    tx.set_data<minter::tx_send_coin>()
+        .set_coin("MNT")
+        .set_to("Mx0000000000000000000000000000000000000000")
+        .set_value("1");
+    // first signing creates secp256k1 context of this thread and first arena chunk
+    ASSERT_FALSE(tx.sign_single(pk, arena).empty());
+
+    const size_t before = allocations;
+    for (size_t i = 2; i < 100; i++) {
+        tx.set_nonce(i);
+        ASSERT_FALSE(tx.sign_single(pk, arena).empty());
+    }
+    ASSERT_EQ(before, allocations.load());
+}
+
+TEST(Arena, SignBatch) {
+    minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+    minter::arena arena;
+
+    std::vector<minter::value_tx> batch(50, minter::value_tx(&arena));
+    std::vector<dev::bytesConstRef> signed_txs;
+    for (size_t i = 0; i < batch.size(); i++) {
+        batch[i].set_nonce(i + 1)
+            .set_payload(dev::bytesConstRef("batch payout"))
+            .set_data<minter::tx_send_coin>()
+            .set_coin("MNT")
+            .set_to("Mx0000000000000000000000000000000000000000")
+            .set_value(dev::bigint(i * 1000));
+        signed_txs.push_back(batch[i].sign_single(pk, arena));
+        ASSERT_EQ(batch[i].encoded_size(), signed_txs.back().size());
+    }
+
+    for (size_t i = 0; i < batch.size(); i++) {
+        minter::value_tx copy = batch[i];
+        ASSERT_EQ(copy.sign_single(pk).get(), signed_txs[i].toBytes());
+        ASSERT_EQ(signed_txs[i].toBytes(), batch[i].encode());
+    }
+
+    const size_t capacity = arena.capacity();
+    arena.release();
+    ASSERT_EQ(0, arena.allocated());
+    ASSERT_LE(arena.capacity(), capacity);
+}
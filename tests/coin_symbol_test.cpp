@@ -0,0 +1,47 @@
+/*!
+ * minter_tx.
+ * coin_symbol_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <gtest/gtest.h>
+#include <minter/coin_symbol.h>
+#include <minter/tx/utils.h>
+
+TEST(CoinSymbol, CreateAndCompare) {
+    minter::coin_symbol mnt("MNT");
+    ASSERT_STREQ("MNT", mnt.c_str());
+    ASSERT_EQ(3, mnt.size());
+    ASSERT_EQ(std::string("MNT"), (std::string) mnt);
+    ASSERT_TRUE(mnt == minter::coin_symbol(std::string("MNT")));
+    ASSERT_TRUE(mnt != minter::coin_symbol("BIP"));
+    ASSERT_TRUE(minter::coin_symbol().empty());
+    ASSERT_EQ(std::hash<minter::coin_symbol>()(mnt), std::hash<minter::coin_symbol>()(minter::coin_symbol("MNT")));
+}
+
+TEST(CoinSymbol, Encoded) {
+    minter::coin_symbol coin("SPRTEST");
+    ASSERT_EQ(minter::utils::to_bytes_fixed("SPRTEST", 10), coin.encoded().toBytes());
+
+    minter::coin_symbol decoded(coin.encoded());
+    ASSERT_EQ(coin, decoded);
+    ASSERT_STREQ("SPRTEST", decoded.c_str());
+
+    minter::coin_symbol full("ABCDEFGHIJ");
+    ASSERT_EQ(full, minter::coin_symbol(full.encoded()));
+}
+
+TEST(CoinSymbol, Validation) {
+    ASSERT_THROW(minter::coin_symbol("ABCDEFGHIJK"), std::runtime_error);
+    dev::bytes too_long(11, 'A');
+    ASSERT_THROW(minter::coin_symbol(dev::bytesConstRef(&too_long)), std::runtime_error);
+
+    ASSERT_TRUE(minter::coin_symbol("MNT").is_valid());
+    ASSERT_TRUE(minter::coin_symbol("ABCDEFGHI0").is_valid());
+    ASSERT_FALSE(minter::coin_symbol("MN").is_valid());
+    ASSERT_FALSE(minter::coin_symbol("mnt").is_valid());
+    ASSERT_FALSE(minter::coin_symbol().is_valid());
+}
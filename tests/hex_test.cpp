@@ -0,0 +1,124 @@
+/*!
+ * minter_tx.
+ * hex_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <gtest/gtest.h>
+#include <minter/hex.h>
+#include <minter/tx.hpp>
+#include <minter/tx/utils.h>
+
+static dev::bytes random_bytes(size_t size, std::mt19937 &rng) {
+    dev::bytes out(size);
+    for (auto &b: out) {
+        b = (uint8_t) rng();
+    }
+    return out;
+}
+
+TEST(Hex, AllCodecsMatchScalar) {
+    const auto codecs = minter::hex_codec::supported();
+    ASSERT_STREQ("scalar", codecs.front()->name);
+    const minter::hex_codec &scalar = *codecs.front();
+
+    std::mt19937 rng(42);
+    for (size_t size = 0; size < 300; size++) {
+        const dev::bytes data = random_bytes(size, rng);
+        std::string expected(size * 2, '\0');
+        scalar.encode(data.data(), size, &expected[0]);
+
+        for (const auto *codec: codecs) {
+            std::string hex(size * 2, '\0');
+            codec->encode(data.data(), size, &hex[0]);
+            ASSERT_EQ(expected, hex) << codec->name << " size " << size;
+
+            // upper case must be decoded too
+            for (size_t i = 0; i < hex.size(); i += 3) {
+                hex[i] = (char) toupper(hex[i]);
+            }
+            dev::bytes decoded(size);
+            size_t error_pos = 0;
+            ASSERT_TRUE(codec->decode(hex.data(), hex.size(), decoded.data(), error_pos)) << codec->name;
+            ASSERT_EQ(data, decoded) << codec->name << " size " << size;
+        }
+    }
+}
+
+TEST(Hex, InvalidCharPosition) {
+    const std::string valid(200, 'a');
+    const char bad[] = {'g', 'G', '/', ':', '@', '`', ' ', 'x', '\0', (char) 0x80, (char) 0xe1, (char) 0xff};
+
+    for (const auto *codec: minter::hex_codec::supported()) {
+        dev::bytes out(valid.size() / 2);
+        for (size_t pos = 0; pos < valid.size(); pos += 7) {
+            for (char c: bad) {
+                std::string hex = valid;
+                hex[pos] = c;
+                size_t error_pos = 0;
+                ASSERT_FALSE(codec->decode(hex.data(), hex.size(), out.data(), error_pos)) << codec->name;
+                ASSERT_EQ(pos, error_pos) << codec->name << " char " << (int) (uint8_t) c;
+            }
+        }
+    }
+}
+
+TEST(Hex, StringHelpers) {
+    const dev::bytes bytes{0x00, 0xff, 0x10, 0xab};
+    ASSERT_EQ("00ff10ab", minter::to_hex(dev::bytesConstRef(&bytes)));
+    ASSERT_EQ(dev::bytes({0x00, 0xff, 0x10, 0xab}), minter::from_hex("0x00FF10ab"));
+    ASSERT_EQ(dev::bytes({0x0a, 0xbc}), minter::from_hex("abc"));
+    ASSERT_EQ(dev::bytes(), minter::from_hex(""));
+    ASSERT_EQ(dev::bytes(), minter::from_hex("0x"));
+    ASSERT_THROW(minter::from_hex("0x0z"), std::runtime_error);
+    ASSERT_THROW(minter::from_hex("z00"), std::runtime_error);
+
+    size_t error_pos = 0;
+    uint8_t out[2];
+    ASSERT_FALSE(minter::hex_decode("abc", 3, out, error_pos));
+    ASSERT_EQ(3, error_pos);
+
+    const dev::bytes data{0xde, 0xad, 0xbe, 0xef};
+    std::stringstream ss;
+    ss << data;
+    ASSERT_EQ("deadbeef", ss.str());
+}
+
+TEST(Hex, DataTypesRoundTrip) {
+    const char *address = "Mx0123456789abcdef0123456789abcdef01234567";
+    ASSERT_STREQ(address, minter::data::address(address).to_string().c_str());
+
+    const char *pub_key = "Mp0eb98ea04ae466d8d38f490db3c99b3996a90e24243952ce9822c6dc1e2c1a43";
+    ASSERT_STREQ(pub_key, minter::pubkey_t(pub_key).to_string().c_str());
+
+    const char *priv_key = "df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f";
+    ASSERT_STREQ(priv_key, minter::privkey_t(priv_key).to_string().c_str());
+}
+
+TEST(Hex, DISABLED_Throughput) {
+    std::mt19937 rng(1);
+    const dev::bytes data = random_bytes(1024 * 1024, rng);
+    std::string hex(data.size() * 2, '\0');
+    dev::bytes decoded(data.size());
+
+    for (const auto *codec: minter::hex_codec::supported()) {
+        const auto start = std::chrono::steady_clock::now();
+        size_t error_pos = 0;
+        for (int i = 0; i < 16; i++) {
+            codec->encode(data.data(), data.size(), &hex[0]);
+            ASSERT_TRUE(codec->decode(hex.data(), hex.size(), decoded.data(), error_pos));
+        }
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        ASSERT_EQ(data, decoded);
+        std::cout << "hex " << codec->name << ": " << 16 / (seconds > 0 ? seconds : 1e-9)
+                  << " MiB/s encode+decode" << std::endl;
+    }
+}
@@ -0,0 +1,34 @@
+/*!
+ * minter_tx.
+ * multisig_tx.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TESTS_MULTISIG_TX_H
+#define MINTER_TESTS_MULTISIG_TX_H
+
+#include <minter/tx.hpp>
+#include <minter/tx/signature_data.h>
+
+/// \brief Same transaction with multisig signature of address: [address, [[v, r, s]]], holding the single
+/// signature of source transaction. Signature is not valid for multisig, it's only for decoding tests
+inline dev::bytes make_multisig_tx(const dev::bytes &single_signed, const minter::data::address &address) {
+    const dev::RLP fields(single_signed);
+    minter::signature_single_data sign;
+    sign.decode(dev::RLP(fields[9].payload()));
+    minter::signature_multi_data multi;
+    multi.set_signatures(address, {sign});
+
+    dev::RLPStream list(10);
+    for (size_t i = 0; i < 8; i++) {
+        list.appendRaw(fields[i].data());
+    }
+    list.append(dev::bigint(minter::signature_type::multi));
+    list.append(multi.encode());
+    return list.out();
+}
+
+#endif //MINTER_TESTS_MULTISIG_TX_H
@@ -0,0 +1,153 @@
+/*!
+ * minter_tx.
+ * nonce_allocator_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/nonce_allocator.h>
+
+TEST(NonceAllocator, ReserveCommitRelease) {
+    minter::nonce_allocator allocator(10);
+    auto a = allocator.reserve();
+    auto b = allocator.reserve();
+    auto c = allocator.reserve();
+    ASSERT_EQ(10, a.nonce());
+    ASSERT_EQ(11, b.nonce());
+    ASSERT_EQ(12, c.nonce());
+    ASSERT_EQ(13, allocator.next());
+
+    // not last one: waits for reuse
+    ASSERT_TRUE(a.release());
+    ASSERT_FALSE(a.valid());
+    ASSERT_FALSE(a.release());
+    ASSERT_EQ(1, allocator.released());
+    // last one: allocator steps back
+    c.release();
+    ASSERT_EQ(12, allocator.next());
+    b.commit();
+    ASSERT_FALSE(b.valid());
+
+    ASSERT_EQ(10, allocator.reserve().nonce());
+    // released by destructor above
+    ASSERT_EQ(10, allocator.reserve().nonce());
+    auto d = allocator.reserve();
+    d.commit();
+    ASSERT_EQ(10, d.nonce());
+    ASSERT_EQ(12, allocator.reserve().nonce());
+}
+
+TEST(NonceAllocator, Resync) {
+    minter::nonce_allocator allocator(1);
+    auto a = allocator.reserve();
+    auto b = allocator.reserve();
+    a.release();
+    ASSERT_EQ(1, allocator.released());
+
+    allocator.resync(100);
+    ASSERT_EQ(0, allocator.released());
+    ASSERT_EQ(100, allocator.next());
+    // reserved before resync: not returned
+    ASSERT_FALSE(b.release());
+    ASSERT_EQ(100, allocator.next());
+    ASSERT_EQ(0, allocator.released());
+    ASSERT_EQ(100, allocator.reserve().nonce());
+}
+
+TEST(NonceAllocator, ReleaseSlotsAreLimited) {
+    minter::nonce_allocator allocator(0, 2);
+    std::vector<minter::nonce_allocator::reservation> reserved;
+    for (int i = 0; i < 4; i++) {
+        reserved.push_back(allocator.reserve());
+    }
+    ASSERT_TRUE(reserved[0].release());
+    ASSERT_TRUE(reserved[1].release());
+    ASSERT_FALSE(reserved[2].release());
+    ASSERT_EQ(2, allocator.released());
+}
+
+TEST(NonceAllocator, ConcurrentSignersHaveNoGaps) {
+    const uint64_t first = 5;
+    const size_t threads_count = 8;
+    const size_t per_thread = 5000;
+    minter::nonce_allocator allocator(first, 256);
+
+    std::mutex lock;
+    std::vector<uint64_t> committed;
+    std::atomic<bool> bad_count(false);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threads_count; t++) {
+        threads.emplace_back([&allocator, &lock, &committed, &bad_count, t] {
+            std::mt19937 rng((unsigned) t);
+            std::vector<uint64_t> own;
+            while (own.size() < per_thread) {
+                if (allocator.released() > 256) {
+                    bad_count = true;
+                }
+                auto nonce = allocator.reserve();
+                // abandoned transaction
+                if (rng() % 4 == 0) {
+                    continue;
+                }
+                own.push_back(nonce.nonce());
+                nonce.commit();
+            }
+            std::lock_guard<std::mutex> guard(lock);
+            committed.insert(committed.end(), own.begin(), own.end());
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    // counter of released nonces never goes below zero, which would show as a huge value
+    ASSERT_FALSE(bad_count);
+
+    // released ones that nobody picked up yet
+    while (allocator.released() > 0) {
+        auto nonce = allocator.reserve();
+        committed.push_back(nonce.nonce());
+        nonce.commit();
+    }
+
+    std::sort(committed.begin(), committed.end());
+    ASSERT_LE(threads_count * per_thread, committed.size());
+    ASSERT_EQ(first + committed.size(), allocator.next());
+    for (size_t i = 0; i < committed.size(); i++) {
+        ASSERT_EQ(first + i, committed[i]);
+    }
+}
+
+TEST(NonceAllocator, RegistryAndBuilder) {
+    minter::nonce_registry registry;
+    const minter::address_t address("Mx0000000000000000000000000000000000000001");
+    ASSERT_EQ(nullptr, registry.find(address));
+
+    auto &allocator = registry.get(address, 7);
+    ASSERT_EQ(&allocator, registry.find(address));
+    // existing allocator keeps its state
+    ASSERT_EQ(&allocator, &registry.get(address, 100));
+
+    auto nonce = allocator.reserve();
+    auto tx = minter::new_tx()->set_nonce(nonce)
+        .set_chain_id(minter::mainnet)
+        .set_gas_price("1")
+        .set_gas_coin("BIP")
+        .tx_send_coin()
+        ->set_coin("MNT")
+        .set_to("Mx0000000000000000000000000000000000000001")
+        .set_value("1")
+        .build();
+    ASSERT_EQ(dev::bigint(7), tx->get_nonce());
+    nonce.commit();
+    ASSERT_THROW(minter::new_tx()->set_nonce(nonce), std::runtime_error);
+}
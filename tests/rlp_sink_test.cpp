@@ -0,0 +1,110 @@
+/*!
+ * minter_tx.
+ * rlp_sink_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <sstream>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/rlp_sink.h>
+#include <minter/tx/utils.h>
+#include "alloc_counter.h"
+#include "send_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+TEST(RlpSink, SameAsRlpStream) {
+    const dev::bytes long_data(100, 0x11);
+    const dev::bytes one_byte{0x7f};
+    const dev::bytes big_byte{0x80};
+    const dev::bigint big_value("123456789012345678901234567890");
+    // wider than u256
+    const dev::bigint huge_value = dev::bigint(1) << 300;
+
+    dev::RLPStream items;
+    items.append(dev::bytesConstRef(&long_data));
+    items.append(dev::bytesConstRef(&one_byte));
+    items.append(dev::bytesConstRef(&big_byte));
+    items.append(dev::bytesConstRef());
+    items.append(dev::bigint(0));
+    items.append(dev::bigint(5));
+    items.append(big_value);
+    items.append(huge_value);
+    dev::RLPStream expected;
+    expected.appendList(items);
+
+    const size_t payload = dev::rlpItemSize(long_data) + dev::rlpItemSize(one_byte) + dev::rlpItemSize(big_byte) +
+        dev::rlpItemSize(dev::bytes()) + dev::rlpItemSize(dev::bigint(0)) + dev::rlpItemSize(dev::bigint(5)) +
+        dev::rlpItemSize(big_value) + dev::rlpItemSize(huge_value);
+
+    dev::bytes out;
+    minter::rlp_buffer_sink sink(out);
+    sink.append_list(payload)
+        .append(dev::bytesConstRef(&long_data))
+        .append(dev::bytesConstRef(&one_byte))
+        .append(dev::bytesConstRef(&big_byte))
+        .append(dev::bytesConstRef())
+        .append(dev::bigint(0))
+        .append(dev::bigint(5))
+        .append(big_value)
+        .append(huge_value);
+    ASSERT_EQ(expected.out(), out);
+}
+
+TEST(RlpSink, TransactionToAllSinks) {
+    // long payload, so list header is not a single byte
+    auto tx = make_send_tx(255, "1000000000000000000", std::string(100, 'p'));
+    const dev::bytes signed_tx = tx->sign_single(pk).get();
+
+    dev::bytes buffer;
+    minter::rlp_buffer_sink buffer_sink(buffer);
+    tx->encode_to(buffer_sink);
+    ASSERT_EQ(signed_tx, buffer);
+    ASSERT_EQ(tx->encoded_size(), buffer.size());
+
+    std::stringstream file;
+    minter::rlp_stream_sink stream_sink(file);
+    tx->encode_to(stream_sink);
+    ASSERT_EQ(std::string(signed_tx.begin(), signed_tx.end()), file.str());
+
+    dev::bytes unsigned_tx;
+    minter::rlp_buffer_sink unsigned_sink(unsigned_tx);
+    tx->encode_to(unsigned_sink, minter::tx_encoding::unsigned_data);
+    ASSERT_EQ(tx->encoded_size(minter::tx_encoding::unsigned_data), unsigned_tx.size());
+
+    uint8_t hash[32];
+    minter::rlp_hash_sink hasher;
+    tx->encode_to(hasher, minter::tx_encoding::unsigned_data);
+    hasher.finish(hash);
+    ASSERT_EQ(minter::utils::sha3k(unsigned_tx), dev::bytes(hash, hash + 32));
+    // decoded transaction is encoded the same way
+    ASSERT_EQ(signed_tx, minter::tx::decode(signed_tx)->sign_single(pk).get());
+}
+
+TEST(RlpSink, SigningHashWithoutAllocations) {
+    auto tx = make_send_tx(255, "1000000000000000000", std::string(100, 'p'));
+    uint8_t hash[32];
+    minter::rlp_hash_sink hasher;
+
+    const size_t before = allocations;
+    tx->encode_to(hasher, minter::tx_encoding::unsigned_data);
+    hasher.finish(hash);
+    ASSERT_EQ(before, allocations.load());
+}
+
+TEST(RlpSink, Errors) {
+    auto tx = make_send_tx(1);
+    dev::bytes out;
+    minter::rlp_buffer_sink sink(out);
+    ASSERT_THROW(tx->encode_to(sink), std::runtime_error);
+
+    tx->sign_single(pk);
+    std::stringstream broken;
+    broken.setstate(std::ios::badbit);
+    minter::rlp_stream_sink stream_sink(broken);
+    ASSERT_THROW(tx->encode_to(stream_sink), std::runtime_error);
+}
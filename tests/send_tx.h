@@ -0,0 +1,46 @@
+/*!
+ * minter_tx.
+ * send_tx.h
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#ifndef MINTER_TESTS_SEND_TX_H
+#define MINTER_TESTS_SEND_TX_H
+
+#include <memory>
+#include <string>
+#include <minter/tx.hpp>
+
+/// \brief Key which signs make_signed_send() transactions
+inline const minter::privkey_t &send_tx_key() {
+    static const minter::privkey_t key("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+    return key;
+}
+
+/// \brief Unsigned mainnet transaction, sending value MNT to Mx00..01 with 1 BIP gas price
+inline std::shared_ptr<minter::tx> make_send_tx(const dev::bigint &nonce,
+                                                const char *value = "1",
+                                                const std::string &payload = "") {
+    return minter::new_tx()->set_nonce(nonce)
+        .set_chain_id(minter::mainnet)
+        .set_gas_price("1")
+        .set_gas_coin("BIP")
+        .set_payload(payload)
+        .tx_send_coin()
+        ->set_coin("MNT")
+        .set_to("Mx0000000000000000000000000000000000000001")
+        .set_value(value)
+        .build();
+}
+
+/// \brief make_send_tx() signed by send_tx_key()
+inline dev::bytes make_signed_send(const dev::bigint &nonce,
+                                   const char *value = "1",
+                                   const std::string &payload = "") {
+    return make_send_tx(nonce, value, payload)->sign_single(send_tx_key()).get();
+}
+
+#endif //MINTER_TESTS_SEND_TX_H
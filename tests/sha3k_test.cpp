@@ -0,0 +1,103 @@
+/*!
+ * minter_tx.
+ * sha3k_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <gtest/gtest.h>
+#include <minter/hex.h>
+#include <minter/tx/utils.h>
+
+static std::vector<dev::bytes> random_messages(size_t count, size_t max_size, std::mt19937 &rng) {
+    std::vector<dev::bytes> out(count);
+    for (auto &message: out) {
+        message.resize(rng() % (max_size + 1));
+        for (auto &b: message) {
+            b = (uint8_t) rng();
+        }
+    }
+    return out;
+}
+
+static std::vector<dev::bytesConstRef> refs(const std::vector<dev::bytes> &messages) {
+    std::vector<dev::bytesConstRef> out;
+    for (const auto &message: messages) {
+        out.emplace_back(&message);
+    }
+    return out;
+}
+
+TEST(Sha3k, Into) {
+    const dev::bytes empty;
+    uint8_t out[32];
+    minter::utils::sha3k_into(empty.data(), 0, out);
+    ASSERT_EQ(minter::utils::sha3k(empty), dev::bytes(out, out + 32));
+    ASSERT_EQ("c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470",
+              minter::to_hex(dev::bytesConstRef(out, 32)));
+}
+
+TEST(Sha3k, KernelsMatchScalar) {
+    std::mt19937 rng(7);
+    const auto kernels = minter::utils::sha3k_kernel::supported();
+    ASSERT_STREQ("scalar", kernels.front()->name);
+
+    // messages of different block counts in one group, including exact multiples of rate (136)
+    std::vector<dev::bytes> messages = random_messages(64, 600, rng);
+    for (size_t size: {135, 136, 137, 272, 0}) {
+        messages[size % 8].resize(size);
+    }
+    const auto message_refs = refs(messages);
+
+    for (const auto *kernel: kernels) {
+        for (size_t i = 0; i + kernel->lanes <= messages.size(); i += kernel->lanes) {
+            std::vector<uint8_t> out(kernel->lanes * 32);
+            kernel->hash(message_refs.data() + i, out.data());
+            for (size_t l = 0; l < kernel->lanes; l++) {
+                ASSERT_EQ(minter::utils::sha3k(messages[i + l]),
+                          dev::bytes(out.begin() + l * 32, out.begin() + (l + 1) * 32))
+                    << kernel->name << " message " << i + l << " size " << messages[i + l].size();
+            }
+        }
+    }
+}
+
+TEST(Sha3k, Batch) {
+    std::mt19937 rng(8);
+    for (size_t count = 0; count < 20; count++) {
+        const auto messages = random_messages(count, 300, rng);
+        const auto message_refs = refs(messages);
+        std::vector<uint8_t> out(count * 32);
+        minter::utils::sha3k_batch(message_refs.data(), count, out.data());
+        for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ(minter::utils::sha3k(messages[i]), dev::bytes(out.begin() + i * 32, out.begin() + (i + 1) * 32));
+        }
+    }
+}
+
+TEST(Sha3k, DISABLED_Throughput) {
+    std::mt19937 rng(9);
+    // size of unsigned send coin transaction
+    std::vector<dev::bytes> messages(4096, dev::bytes(96));
+    for (auto &message: messages) {
+        for (auto &b: message) {
+            b = (uint8_t) rng();
+        }
+    }
+    const auto message_refs = refs(messages);
+    std::vector<uint8_t> out(messages.size() * 32);
+
+    for (const auto *kernel: minter::utils::sha3k_kernel::supported()) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < messages.size(); i += kernel->lanes) {
+            kernel->hash(message_refs.data() + i, out.data() + i * 32);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "sha3k " << kernel->name << ": " << seconds * 1e9 / messages.size() << " ns/hash" << std::endl;
+    }
+}
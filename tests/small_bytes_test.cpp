@@ -0,0 +1,127 @@
+/*!
+ * minter_tx.
+ * small_bytes_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <gtest/gtest.h>
+#include <minter/small_bytes.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_delegate.h>
+#include <minter/tx/tx_redeem_check.h>
+#include <minter/tx/utils.h>
+#include "alloc_counter.h"
+
+TEST(SmallBytes, InlineDoesNotAllocate) {
+    dev::bytes source(32, 0xAB);
+    const size_t before = allocations;
+
+    minter::small_bytes<32> a(source);
+    minter::small_bytes<32> b = a;
+    minter::small_bytes<32> c(std::move(b));
+    c.resize(10);
+    c.push_back(0x01);
+    a = dev::bytesConstRef(&source);
+
+    ASSERT_EQ(before, allocations.load());
+    ASSERT_TRUE(a.is_inline());
+    ASSERT_EQ(source, a);
+    ASSERT_EQ(11, c.size());
+    ASSERT_EQ(0x01, c[10]);
+}
+
+TEST(SmallBytes, GrowsToHeap) {
+    minter::small_bytes<4> data;
+    for (uint8_t i = 0; i < 10; i++) {
+        data.push_back(i);
+    }
+    ASSERT_FALSE(data.is_inline());
+    ASSERT_EQ(10, data.size());
+    for (uint8_t i = 0; i < 10; i++) {
+        ASSERT_EQ(i, data[i]);
+    }
+
+    data.resize(3);
+    ASSERT_TRUE(data.is_inline());
+    ASSERT_EQ((dev::bytes{0, 1, 2}), data);
+
+    // long vector is adopted without copy
+    dev::bytes big(100, 0x11);
+    const uint8_t *big_data = big.data();
+    minter::small_bytes<4> adopted(std::move(big));
+    ASSERT_EQ(big_data, adopted.data());
+
+    minter::small_bytes<4> moved(std::move(adopted));
+    ASSERT_EQ(big_data, moved.data());
+    ASSERT_TRUE(adopted.empty());
+}
+
+TEST(SmallBytes, AssignFromOwnData) {
+    minter::small_bytes<4> data;
+    for (uint8_t i = 0; i < 10; i++) {
+        data.push_back(i);
+    }
+
+    data.assign(data.data() + 1, 8);
+    ASSERT_FALSE(data.is_inline());
+    ASSERT_EQ((dev::bytes{1, 2, 3, 4, 5, 6, 7, 8}), data);
+
+    data.assign(data.data() + 5, 3);
+    ASSERT_TRUE(data.is_inline());
+    ASSERT_EQ((dev::bytes{6, 7, 8}), data);
+}
+
+TEST(SmallBytes, AllocationsPerTx) {
+    dev::bytes pub_key(32, 0x77);
+    minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+    auto builder = minter::new_tx();
+    builder->set_nonce("1").set_gas_price("1").set_payload("hello").set_service_data("service");
+    auto signed_tx = builder->tx_delegate()
+        ->set_pub_key(pub_key)
+        .set_coin("MNT")
+        .set_stake("10")
+        .build()
+        ->sign_single(pk);
+
+    const size_t before = allocations;
+    auto decoded = minter::tx::decode(signed_tx.get());
+    const size_t per_tx = allocations - before;
+    RecordProperty("decode_allocations", (int) per_tx);
+    // tx object and its buffers only: short fields are stored inline, data is decoded on first get_data()
+    ASSERT_GE(5, per_tx);
+
+    ASSERT_TRUE(decoded->get_payload().is_inline());
+    ASSERT_TRUE(decoded->get_service_data().is_inline());
+    ASSERT_TRUE(decoded->get_data_raw().is_inline());
+    ASSERT_EQ(minter::pubkey_t(pub_key), decoded->get_data<minter::tx_delegate>()->get_pub_key());
+
+    // short fields are copied without allocations
+    const size_t before_copy = allocations;
+    minter::small_bytes<64> payload_copy = decoded->get_payload();
+    minter::small_bytes<32> service_copy = decoded->get_service_data();
+    minter::small_bytes<128> data_copy = decoded->get_data_raw();
+    ASSERT_EQ(before_copy, allocations.load());
+    ASSERT_EQ(minter::utils::to_bytes("hello"), payload_copy);
+    ASSERT_EQ(minter::utils::to_bytes("service"), service_copy);
+    ASSERT_EQ(decoded->get_data_raw(), data_copy);
+}
+
+TEST(SmallBytes, RedeemCheckFieldsInline) {
+    auto builder = minter::new_tx();
+    auto tx = builder->tx_redeem_check()
+        ->set_check(dev::bytes(180, 0x01))
+        .set_proof(dev::bytes(minter::PROOF_LEN, 0x02))
+        .build();
+
+    const size_t before = allocations;
+    auto data = tx->get_data<minter::tx_redeem_check>();
+    minter::small_bytes<256> check = data->get_check();
+    minter::small_bytes<minter::PROOF_LEN> proof = data->get_proof();
+    ASSERT_EQ(before, allocations.load());
+    ASSERT_EQ(dev::bytes(180, 0x01), check);
+    ASSERT_EQ(dev::bytes(minter::PROOF_LEN, 0x02), proof);
+}
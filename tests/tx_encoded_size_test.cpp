@@ -0,0 +1,181 @@
+/*!
+ * minter_tx.
+ * tx_encoded_size_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <random>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/eth/RLP.h>
+
+static std::mt19937_64 rnd(0x4d4e54);
+
+static dev::bigint random_int() {
+    // from 0 up to 256 bits, to cover single byte, short and long int encoding
+    const size_t bits = rnd() % 257;
+    dev::bigint out = 0;
+    for (size_t i = 0; i < bits; i += 64) {
+        out = (out << 64) | dev::bigint(rnd());
+    }
+    if (bits) {
+        out >>= (((bits + 63) / 64) * 64 - bits);
+    }
+    return out;
+}
+
+static dev::bytes random_bytes(size_t max_len) {
+    dev::bytes out(rnd() % (max_len + 1));
+    for (auto &b: out) {
+        b = (uint8_t) (rnd() % 3 == 0 ? rnd() % 0x80 : rnd());
+    }
+    return out;
+}
+
+static minter::address_t random_address() {
+    dev::bytes out(20);
+    for (auto &b: out) {
+        b = (uint8_t) rnd();
+    }
+    return minter::address_t(std::move(out));
+}
+
+static minter::pubkey_t random_pubkey() {
+    dev::bytes out(32);
+    for (auto &b: out) {
+        b = (uint8_t) rnd();
+    }
+    return minter::pubkey_t(std::move(out));
+}
+
+static minter::tx_builder random_header() {
+    auto builder = minter::new_tx();
+    builder->set_nonce(random_int())
+        .set_chain_id(rnd() % 2 ? minter::mainnet : minter::testnet)
+        .set_gas_price(random_int())
+        .set_gas_coin("MNT")
+        .set_payload(random_bytes(130))
+        .set_service_data(random_bytes(60));
+    return *builder;
+}
+
+static void check_sizes(const std::shared_ptr<minter::tx_data> &data) {
+    ASSERT_EQ(data->encode().size(), data->encoded_size());
+
+    auto tx = data->build();
+    ASSERT_EQ(data->encoded_size(), tx->get_data_raw().size());
+
+    const size_t expected_signed = tx->encoded_size();
+    minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+    auto signed_tx = tx->sign_single(pk);
+    ASSERT_EQ(signed_tx.size(), expected_signed);
+    ASSERT_EQ(signed_tx.size(), tx->encoded_size(minter::tx_encoding::signed_tx));
+
+    auto decoded = minter::tx::decode(signed_tx.get());
+    ASSERT_EQ(signed_tx.size(), decoded->encoded_size(minter::tx_encoding::signed_tx));
+    ASSERT_EQ(tx->encoded_size(minter::tx_encoding::unsigned_data),
+              decoded->encoded_size(minter::tx_encoding::unsigned_data));
+}
+
+TEST(TxEncodedSize, RlpItemSize) {
+    for (size_t i = 0; i < 1000; i++) {
+        dev::bigint num = random_int();
+        ASSERT_EQ(dev::rlp(num).size(), dev::rlpItemSize(num));
+
+        dev::bytes data = random_bytes(300);
+        ASSERT_EQ(dev::rlp(data).size(), dev::rlpItemSize(data));
+
+        dev::RLPStream lst;
+        lst.append(data);
+        ASSERT_EQ(dev::RLPStream().appendList(lst).out().size(), dev::rlpListSize(lst.out().size()));
+    }
+}
+
+TEST(TxEncodedSize, AllTypesMatchEncode) {
+    for (size_t i = 0; i < 50; i++) {
+        check_sizes(random_header().tx_send_coin()
+                        ->set_coin("MNT")
+                        .set_to(random_address())
+                        .set_value(random_int())
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_sell_coin()
+                        ->set_coin_to_sell("MNT")
+                        .set_coin_to_buy("TEST")
+                        .set_value_to_sell("1.5")
+                        .set_min_value_to_buy("0")
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_sell_all_coins()
+                        ->set_coin_to_sell("MNT")
+                        .set_coin_to_buy("TEST")
+                        .set_min_value_to_buy("100")
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_buy_coin()
+                        ->set_coin_to_buy("TEST")
+                        .set_value_to_buy(random_int())
+                        .set_coin_to_sell("MNT")
+                        .set_max_value_to_sell(random_int())
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_create_coin()
+                        ->set_name(std::string(rnd() % 70, 'n').c_str())
+                        .set_ticker("SPRTEST")
+                        .set_initial_amount(random_int())
+                        .set_initial_reserve(random_int())
+                        .set_crr((unsigned) (rnd() % 200))
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_declare_candidacy()
+                        ->set_address(random_address())
+                        .set_pub_key(random_pubkey())
+                        .set_commission((unsigned) (rnd() % 200))
+                        .set_coin("MNT")
+                        .set_stake("5")
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_delegate()
+                        ->set_pub_key(random_pubkey())
+                        .set_coin("MNT")
+                        .set_stake("10")
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_unbond()
+                        ->set_pub_key(random_pubkey())
+                        .set_coin("MNT")
+                        .set_value("10")
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_redeem_check()
+                        ->set_check(random_bytes(200))
+                        .set_proof(random_bytes(65))
+                        .shared_from_this());
+
+        check_sizes(random_header().tx_set_candidate_on()->set_pub_key(random_pubkey()).shared_from_this());
+        check_sizes(random_header().tx_set_candidate_off()->set_pub_key(random_pubkey()).shared_from_this());
+
+        auto multisig = random_header().tx_create_multisig_address();
+        multisig->set_threshold((unsigned) (rnd() % 1000));
+        for (size_t n = rnd() % 10; n > 0; n--) {
+            multisig->add_weight((unsigned) (rnd() % 1000));
+            multisig->add_address(random_address());
+        }
+        check_sizes(multisig);
+
+        auto multisend = random_header().tx_multisend();
+        for (size_t n = rnd() % 40; n > 0; n--) {
+            multisend->add_item("MNT", random_address(), "0.1");
+        }
+        check_sizes(multisend);
+
+        check_sizes(random_header().tx_edit_candidate()
+                        ->set_pub_key(random_pubkey())
+                        .set_reward_address(random_address())
+                        .set_owner_address(random_address())
+                        .shared_from_this());
+    }
+}
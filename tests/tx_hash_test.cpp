@@ -0,0 +1,86 @@
+/*!
+ * minter_tx.
+ * tx_hash_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/rlp_sink.h>
+#include "send_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+static const minter::privkey_t pk2("07bc17abdcee8b971bb8723e36fe9d2523306d5ab2d683631693238e0f9df142");
+
+TEST(TxHash, IsSha256OfEncoding) {
+    const dev::bytes abc{'a', 'b', 'c'};
+    ASSERT_STREQ("Mtba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+                 minter::tx::hash(dev::bytesConstRef(&abc)).to_string().c_str());
+}
+
+TEST(TxHash, SignedAndDecoded) {
+    auto tx = make_send_tx(1);
+    ASSERT_THROW(tx->get_hash(), std::runtime_error);
+
+    const dev::bytes signed_tx = tx->sign_single(pk).get();
+    const minter::hash_t expected = minter::tx::hash(dev::bytesConstRef(&signed_tx));
+    ASSERT_EQ(expected, tx->get_hash());
+    // cached
+    ASSERT_EQ(expected, tx->get_hash());
+    ASSERT_EQ(66, tx->get_hash().to_string().size());
+
+    ASSERT_EQ(expected, minter::tx::decode(signed_tx)->get_hash());
+
+    // signed again: hash is computed again
+    const dev::bytes resigned = tx->sign_single(pk2).get();
+    ASSERT_NE(signed_tx, resigned);
+    ASSERT_EQ(minter::tx::hash(dev::bytesConstRef(&resigned)), tx->get_hash());
+}
+
+TEST(TxHash, BuilderSetterResetsHash) {
+    auto builder = minter::new_tx();
+    builder->set_nonce("1").set_gas_coin("BIP");
+    auto tx = builder->tx_send_coin()
+        ->set_coin("MNT")
+        .set_to("Mx0000000000000000000000000000000000000001")
+        .set_value("1")
+        .build();
+    tx->sign_single(pk);
+    const minter::hash_t first = tx->get_hash();
+
+    auto encoded_hash = [&tx] {
+        dev::bytes encoded;
+        minter::rlp_buffer_sink sink(encoded);
+        tx->encode_to(sink);
+        return minter::tx::hash(dev::bytesConstRef(&encoded));
+    };
+    builder->set_nonce("2");
+    ASSERT_FALSE(first == tx->get_hash());
+    ASSERT_EQ(encoded_hash(), tx->get_hash());
+    builder->set_payload("changed");
+    ASSERT_EQ(encoded_hash(), tx->get_hash());
+    builder->set_gas_price("5").set_gas_coin("MNT").set_chain_id(minter::testnet).set_service_data("data");
+    ASSERT_EQ(encoded_hash(), tx->get_hash());
+}
+
+TEST(TxHash, Batch) {
+    std::vector<dev::bytes> txs;
+    for (size_t i = 0; i < 1000; i++) {
+        txs.push_back(make_signed_send(i + 1));
+    }
+
+    for (size_t threads: {0, 1, 3, 64}) {
+        const auto hashes = minter::tx::hash_batch(txs, threads);
+        ASSERT_EQ(txs.size(), hashes.size());
+        for (size_t i = 0; i < txs.size(); i++) {
+            ASSERT_EQ(minter::tx::hash(dev::bytesConstRef(&txs[i])), hashes[i]) << i;
+        }
+    }
+
+    ASSERT_TRUE(minter::tx::hash_batch(std::vector<dev::bytes>()).empty());
+}
@@ -0,0 +1,139 @@
+/*!
+ * minter_tx.
+ * tx_memory_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_send_coin.h>
+#include "alloc_counter.h"
+#include "send_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+// resident set size in bytes, 0 if unavailable
+static size_t current_rss() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total = 0, resident = 0;
+    if (!(statm >> total >> resident)) {
+        return 0;
+    }
+    return resident * (size_t) sysconf(_SC_PAGESIZE);
+}
+
+TEST(TxMemory, BuiltTxIsFreed) {
+    std::weak_ptr<minter::tx> tx_ref;
+    std::weak_ptr<minter::tx_data> data_ref;
+    {
+        auto tx = make_send_tx(1);
+        tx->sign_single(pk);
+        tx_ref = tx;
+        data_ref = tx->get_data();
+        ASSERT_FALSE(data_ref.expired());
+    }
+    ASSERT_TRUE(tx_ref.expired());
+    ASSERT_TRUE(data_ref.expired());
+}
+
+TEST(TxMemory, DecodedTxIsFreed) {
+    const dev::bytes encoded = make_signed_send(1);
+
+    std::weak_ptr<minter::tx> tx_ref;
+    std::weak_ptr<minter::tx_data> data_ref;
+    {
+        auto decoded = minter::tx::decode(encoded);
+        tx_ref = decoded;
+        data_ref = decoded->get_data();
+        ASSERT_EQ(dev::bigint("1"), decoded->get_nonce());
+    }
+    ASSERT_TRUE(tx_ref.expired());
+    ASSERT_TRUE(data_ref.expired());
+}
+
+TEST(TxMemory, DataKeepsTxUntilBuilt) {
+    std::weak_ptr<minter::tx> tx_ref;
+    std::shared_ptr<minter::tx_send_coin> data;
+    {
+        // builder is a temporary: data is the only owner of transaction before build()
+        data = minter::new_tx()->tx_send_coin();
+        data->set_coin("MNT").set_value("1");
+        auto tx = data->build();
+        tx_ref = tx;
+    }
+    // now transaction owns data, not vice versa
+    ASSERT_TRUE(tx_ref.expired());
+    ASSERT_THROW(data->build(), std::runtime_error);
+}
+
+TEST(TxMemory, DecodedDataIsCreatedOnFirstAccess) {
+    const dev::bytes encoded = make_signed_send(1);
+
+    const size_t before = allocations;
+    auto lazy = minter::tx::decode(encoded);
+    ASSERT_EQ(dev::bigint("1"), lazy->get_nonce());
+    const size_t decode_allocations = allocations - before;
+
+    auto data = lazy->get_data<minter::tx_send_coin>();
+    ASSERT_LT(decode_allocations, allocations - before);
+    ASSERT_NE(nullptr, data);
+    ASSERT_STREQ("MNT", data->get_coin().c_str());
+    // created once, then cached
+    ASSERT_EQ(data, lazy->get_data<minter::tx_send_coin>());
+    ASSERT_EQ(nullptr, lazy->get_data<minter::tx_delegate>());
+}
+
+TEST(TxMemory, ConcurrentDataAccessCreatesItOnce) {
+    const dev::bytes encoded = make_signed_send(1);
+
+    for (size_t round = 0; round < 20; round++) {
+        auto decoded = minter::tx::decode(encoded);
+        std::vector<std::shared_ptr<minter::tx_data>> seen(4);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < seen.size(); i++) {
+            threads.emplace_back([&decoded, &seen, i] {
+                seen[i] = decoded->get_data();
+            });
+        }
+        for (auto &t: threads) {
+            t.join();
+        }
+
+        ASSERT_NE(nullptr, seen[0]);
+        for (const auto &data: seen) {
+            ASSERT_EQ(seen[0], data);
+        }
+    }
+}
+
+// Soak: run manually with --gtest_also_run_disabled_tests --gtest_filter=TxMemory.*
+TEST(TxMemory, DISABLED_SoakBuildSignDecode) {
+    const size_t total = 2000000;
+    const size_t warmup = 20000;
+    size_t rss_after_warmup = 0;
+
+    for (size_t i = 0; i < total; i++) {
+        const dev::bytes encoded = make_signed_send(i);
+        auto decoded = minter::tx::decode(encoded);
+        ASSERT_EQ(dev::bigint(i), decoded->get_nonce());
+
+        if (i + 1 == warmup) {
+            rss_after_warmup = current_rss();
+        }
+    }
+
+    const size_t rss_end = current_rss();
+    std::cout << "RSS after warmup: " << rss_after_warmup << ", at the end: " << rss_end << std::endl;
+    if (rss_after_warmup == 0) {
+        return;
+    }
+    // allow allocator noise, leaking would be hundreds of megabytes
+    ASSERT_LT(rss_end, rss_after_warmup + 16 * 1024 * 1024);
+}
@@ -0,0 +1,185 @@
+/*!
+ * minter_tx.
+ * tx_multisend_planner_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_multisend_planner.h>
+#include <minter/tx/tx_stream_decoder.h>
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+static std::string address_of(size_t i) {
+    char buf[43];
+    snprintf(buf, sizeof(buf), "Mx%040zx", i);
+    return buf;
+}
+
+static std::string make_rows(size_t count) {
+    std::stringstream ss;
+    ss << "# coin,address,amount\n";
+    for (size_t i = 0; i < count; i++) {
+        ss << (i % 2 == 0 ? "MNT" : "BIP") << ", " << address_of(i) << " ," << i << "." << (i % 1000) << "\n";
+        if (i % 7 == 0) {
+            ss << "\n";
+        }
+    }
+    return ss.str();
+}
+
+TEST(TxMultisendPlanner, ParseRow) {
+    const std::string row = " MNT , Mx0000000000000000000000000000000000000001,\t1.5 ";
+    minter::send_target target = minter::tx_multisend_planner::parse_row(row.data(), row.size());
+    ASSERT_STREQ("MNT", target.coin.c_str());
+    ASSERT_STREQ("Mx0000000000000000000000000000000000000001", target.to.to_string().c_str());
+    ASSERT_EQ(dev::bigint("1500000000000000000"), target.amount);
+
+    auto amount = [](const std::string &value) {
+        const std::string r = "BIP,0000000000000000000000000000000000000001," + value;
+        return minter::tx_multisend_planner::parse_row(r.data(), r.size()).amount;
+    };
+    ASSERT_EQ(minter::utils::normalize_value("0.000000000000000001"), amount("0.000000000000000001"));
+    ASSERT_EQ(minter::utils::normalize_value("12345678901234567890.5"), amount("12345678901234567890.5"));
+    ASSERT_EQ(dev::bigint(0), amount("0"));
+    ASSERT_EQ(minter::utils::normalize_value(".5"), amount(".5"));
+
+    for (const char *bad: {"BIP,Mx01,1", "BIP,Mx000000000000000000000000000000000000000z,1",
+                           ",Mx0000000000000000000000000000000000000001,1",
+                           "BIP,Mx0000000000000000000000000000000000000001",
+                           "BIP,Mx0000000000000000000000000000000000000001,1,2",
+                           "BIP,Mx0000000000000000000000000000000000000001,1.2.3",
+                           "BIP,Mx0000000000000000000000000000000000000001,-1",
+                           "BIP,Mx0000000000000000000000000000000000000001,.",
+                           "BIP,Mx0000000000000000000000000000000000000001,0.0000000000000000001"}) {
+        ASSERT_THROW(minter::tx_multisend_planner::parse_row(bad, strlen(bad)), std::runtime_error) << bad;
+    }
+}
+
+TEST(TxMultisendPlanner, Fee) {
+    const dev::bigint unit("1000000000000000");
+    ASSERT_EQ(unit * 10, minter::tx_multisend_planner::fee(1, 0, 1));
+    ASSERT_EQ(unit * (10 + 99 * 5), minter::tx_multisend_planner::fee(100, 0, 1));
+    ASSERT_EQ(unit * (15 + 2 * 3) * 2, minter::tx_multisend_planner::fee(2, 3, 2));
+    // first item is the fee of multisend type
+    ASSERT_EQ(minter::utils::normalize_value(minter::tx_multisend_type::get_fee()),
+              minter::tx_multisend_planner::fee(1, 0, 1));
+}
+
+TEST(TxMultisendPlanner, PlansSequentialTransactions) {
+    const size_t rows_count = 1234;
+    std::stringstream rows(make_rows(rows_count));
+
+    minter::tx_multisend_planner::options opts;
+    opts.max_items = 50;
+    opts.threads = 3;
+    opts.batch_txs = 2;
+    opts.max_batches = 2;
+    opts.gas_coin = "MNT";
+    opts.payload = dev::bytes{'p', 'a', 'y'};
+    minter::tx_multisend_planner planner(pk, 7, opts);
+
+    std::vector<minter::planned_multisend> txs;
+    const auto stats = planner.plan(rows, [&txs](const minter::planned_multisend &tx) {
+        txs.push_back(tx);
+    });
+    ASSERT_EQ(rows_count, stats.rows);
+    ASSERT_EQ(25, stats.txs);
+    ASSERT_EQ(25, txs.size());
+
+    dev::bigint fee;
+    size_t row = 0;
+    for (size_t t = 0; t < txs.size(); t++) {
+        const auto &tx = txs[t];
+        ASSERT_EQ(7 + t, tx.nonce);
+        ASSERT_EQ(row, tx.first_row);
+        ASSERT_EQ(t + 1 < txs.size() ? 50 : 34, tx.items);
+        ASSERT_EQ(minter::tx_multisend_planner::fee(tx.items, 3, 1), tx.fee);
+        fee += tx.fee;
+
+        // same as built and signed by hand
+        auto builder = minter::new_tx();
+        builder->set_nonce(dev::bigint(tx.nonce))
+            .set_chain_id(minter::mainnet)
+            .set_gas_price("1")
+            .set_gas_coin("MNT")
+            .set_payload("pay");
+        auto data = builder->tx_multisend();
+        for (size_t i = 0; i < tx.items; i++, row++) {
+            std::stringstream amount;
+            amount << row << "." << (row % 1000);
+            data->add_item(row % 2 == 0 ? "MNT" : "BIP", address_of(row), amount.str().c_str());
+        }
+        ASSERT_EQ(data->build()->sign_single(pk).get(), tx.data.get()) << t;
+    }
+    ASSERT_EQ(fee, stats.fee);
+}
+
+TEST(TxMultisendPlanner, InvalidRowNumber) {
+    std::stringstream rows(make_rows(300) + "BIP,Mx01,1\n" + make_rows(10));
+    minter::tx_multisend_planner::options opts;
+    opts.max_items = 7;
+    opts.batch_txs = 3;
+    minter::tx_multisend_planner planner(pk, 1, opts);
+    try {
+        planner.plan(rows, [](const minter::planned_multisend &) {});
+        FAIL() << "must throw";
+    } catch (const std::runtime_error &e) {
+        ASSERT_EQ(0, std::string(e.what()).find("Invalid row 300: ")) << e.what();
+    }
+}
+
+TEST(TxMultisendPlanner, SigningFailure) {
+    // secp256k1 rejects zero key, sign_single() returns "0x0"
+    const minter::privkey_t zero("0000000000000000000000000000000000000000000000000000000000000000");
+    std::stringstream rows(make_rows(20));
+    minter::tx_multisend_planner::options opts;
+    opts.max_items = 7;
+    minter::tx_multisend_planner planner(zero, 1, opts);
+    size_t emitted = 0;
+    try {
+        planner.plan(rows, [&emitted](const minter::planned_multisend &) { emitted++; });
+        FAIL() << "must throw";
+    } catch (const std::runtime_error &e) {
+        ASSERT_EQ("Unable to sign rows 0-6", std::string(e.what()));
+    }
+    ASSERT_EQ(0, emitted);
+}
+
+TEST(TxMultisendPlanner, File) {
+    const std::string rows_path = "multisend_planner_rows.csv";
+    const std::string out_path = "multisend_planner_txs.txt";
+    const size_t rows_count = 20000;
+    {
+        std::ofstream out(rows_path);
+        out << make_rows(rows_count);
+    }
+
+    minter::tx_multisend_planner planner(pk, 1);
+    const auto stats = planner.plan_file(rows_path, out_path);
+    ASSERT_EQ(rows_count, stats.rows);
+    ASSERT_EQ(200, stats.txs);
+
+    size_t items = 0;
+    uint64_t nonce = 1;
+    minter::tx_stream_decoder decoder;
+    const auto decoded = decoder.decode_file(out_path, [&items, &nonce](const minter::tx_stream_record &record) {
+        ASSERT_TRUE(record.status);
+        ASSERT_EQ(dev::bigint(nonce++), record.tx->get_nonce());
+        items += record.tx->get_data<minter::tx_multisend>()->get_items().size();
+    });
+    ASSERT_EQ(200, decoded.records);
+    ASSERT_EQ(stats.bytes, decoded.bytes);
+    ASSERT_EQ(rows_count, items);
+
+    std::remove(rows_path.c_str());
+    std::remove(out_path.c_str());
+}
@@ -9,6 +9,7 @@
 
 #include <gtest/gtest.h>
 #include <minter/tx.hpp>
+#include "alloc_counter.h"
 
 TEST(TxMultisend, TestEncode) {
     const char *expected =
@@ -61,4 +62,87 @@ TEST(TxMultisend, TestDecode) {
     ASSERT_EQ(dev::bigdec18("0.2"), t2.get_amount());
     ASSERT_STREQ("MNT", t1.coin.c_str());
     ASSERT_STREQ("MNT", t2.coin.c_str());
-}
\ No newline at end of file
+}
+
+TEST(TxMultisend, DecodeLarge) {
+    const size_t count = 20000;
+    minter::tx_multisend data;
+    for (size_t i = 0; i < count; i++) {
+        data.add_item(minter::coin_symbol("MNT"), "Mxfe60014a6e9ac91618f5d1cab3fd58cded61ee99", dev::bigint(i));
+    }
+    dev::bytes encoded = data.encode();
+
+    minter::tx_multisend decoded;
+    decoded.decode(encoded);
+    ASSERT_EQ(count, decoded.get_items().size());
+    ASSERT_EQ(dev::bigint(count - 1), decoded.get_items().back().amount);
+}
+
+TEST(TxMultisend, ItemsAreStoredInArrays) {
+    minter::tx_multisend data;
+    data.add_item("MNT", "Mxfe60014a6e9ac91618f5d1cab3fd58cded61ee99", "0.1")
+        .add_item(minter::coin_symbol("BIP"), "Mxddab6281766ad86497741ff91b6b48fe85012e3c", dev::bigint(0))
+        .add_item(minter::coin_symbol("LONGCOIN10"), "Mxddab6281766ad86497741ff91b6b48fe85012e3c",
+                  dev::bigint("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));
+    ASSERT_THROW(data.add_item(minter::coin_symbol("BIP"), "Mxddab6281766ad86497741ff91b6b48fe85012e3c",
+                               dev::bigint(1) << 256), std::runtime_error);
+    ASSERT_THROW(data.add_item(minter::coin_symbol("BIP"), "Mxddab6281766ad86497741ff91b6b48fe85012e3c",
+                               dev::bigint(-1)), std::runtime_error);
+
+    const minter::send_target_list &items = data.get_items();
+    ASSERT_EQ(3, items.size());
+    ASSERT_STREQ("LONGCOIN10", items.coin(2).c_str());
+    ASSERT_EQ(minter::data::address("Mxfe60014a6e9ac91618f5d1cab3fd58cded61ee99").get(), items.to(0).toBytes());
+    ASSERT_EQ(dev::bytes({0x01, 0x63, 0x45, 0x78, 0x5d, 0x8a, 0x00, 0x00}), items.amount_bytes(0).toBytes());
+    ASSERT_EQ(0, items.amount_bytes(1).size());
+    ASSERT_EQ(32, items.amount_bytes(2).size());
+
+    size_t i = 0;
+    for (const minter::send_target &item: items) {
+        ASSERT_EQ(items.amount(i), item.amount);
+        ASSERT_EQ(items.coin(i), item.coin);
+        i++;
+    }
+    ASSERT_EQ(3, items.to_vector().size());
+
+    // same encoding as list of send_target
+    const dev::bytes encoded = data.encode();
+    ASSERT_EQ(minter::schema_encode(items.to_vector()[2]),
+              dev::bytes(encoded.end() - minter::schema_encoded_size(items.to_vector()[2]), encoded.end()));
+
+    minter::tx_multisend decoded;
+    ASSERT_TRUE(minter::schema_try_decode(decoded, dev::bytesConstRef(&encoded)).ok());
+    ASSERT_EQ(encoded, decoded.encode());
+}
+
+TEST(TxMultisend, DecodeAllocatesArraysOnly) {
+    minter::tx_multisend data;
+    for (size_t i = 0; i < 100; i++) {
+        data.add_item(minter::coin_symbol("MNT"), "Mxfe60014a6e9ac91618f5d1cab3fd58cded61ee99", dev::bigint(i) << 100);
+    }
+    const dev::bytes encoded = data.encode();
+    const dev::RLP rlp(encoded);
+
+    minter::tx_multisend decoded;
+    const size_t before = allocations;
+    ASSERT_TRUE(minter::schema_try_decode(decoded, rlp).ok());
+    // one per array
+    ASSERT_GE(before + 4, allocations.load());
+    ASSERT_EQ(100, decoded.get_items().size());
+    ASSERT_EQ(dev::bigint(99) << 100, decoded.get_items().amount(99));
+}
+
+TEST(TxMultisend, CheckRejectsNonCanonicalLength) {
+    // coin "MNT" with long length prefix
+    dev::bytes item{0xb8, 0x03, 'M', 'N', 'T', 0x94};
+    item.resize(item.size() + 20, 0x01);
+    item.push_back(0x01);
+    dev::bytes list{(uint8_t) (0xc1 + item.size()), (uint8_t) (0xc0 + item.size())};
+    list.insert(list.end(), item.begin(), item.end());
+
+    const dev::RLP rlp(list, dev::RLP::LaissezFaire);
+    minter::decode_context ctx(rlp);
+    ASSERT_FALSE(minter::rlp_codec<minter::send_target_list>::check(rlp, ctx));
+    ASSERT_EQ(minter::decode_error::non_canonical_rlp, ctx.status.error);
+    ASSERT_EQ(1, ctx.status.offset);
+}
@@ -8,12 +8,80 @@
  */
 
 #include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/rlp_sink.h>
 #include <minter/tx/tx_builder.h>
+#include "multisig_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+static const minter::data::address multisig("Mxdb4f4b6942cb927e8d7e3a1f602d0f1fb43b5bd2");
+
+static dev::bytes make_send() {
+    return minter::new_tx()->set_nonce("1")
+        .set_chain_id(minter::testnet)
+        .set_gas_price("1")
+        .set_gas_coin("MNT")
+        .tx_send_coin()
+        ->set_coin("MNT")
+        .set_to("Mx1b685a7c1e78726c48f619c497a07ed75fe00483")
+        .set_value("1")
+        .build()
+        ->sign_single(pk).get();
+}
 
 TEST(TxMultisig, TestEncode) {
+    minter::signature_single_data first, second;
+    first.set_signature(dev::bytes{0x1b}, dev::bytes(32, 0x01), dev::bytes(32, 0x02));
+    second.set_signature(dev::bytes{0x1c}, dev::bytes(32, 0x03), dev::bytes(32, 0x04));
+    minter::signature_multi_data multi;
+    multi.set_signatures(multisig, {first, second});
 
+    // one list: [address, [[v, r, s], [v, r, s]]]
+    const dev::bytes encoded = multi.encode();
+    ASSERT_EQ(multi.encoded_size(), encoded.size());
+    const dev::RLP rlp(encoded);
+    ASSERT_TRUE(rlp.isList());
+    ASSERT_EQ(2, rlp.itemCount());
+    ASSERT_EQ(multisig.get(), rlp[0].toBytes());
+    ASSERT_EQ(2, rlp[1].itemCount());
+    ASSERT_EQ(first.encode(), rlp[1][0].data().toBytes());
+    ASSERT_EQ(second.encode(), rlp[1][1].data().toBytes());
 }
 
 TEST(TxMultisig, TestDecode) {
+    const dev::bytes encoded = make_multisig_tx(make_send(), multisig);
+    ASSERT_TRUE(minter::tx::validate(dev::bytesConstRef(&encoded)).ok());
+
+    auto decoded = minter::tx::decode(encoded);
+    ASSERT_EQ(minter::signature_type::multi, decoded->get_signature_type());
+    auto sig = decoded->get_signature_data<minter::signature_multi_data>();
+    ASSERT_NE(nullptr, sig);
+    ASSERT_EQ(multisig, sig->get_address());
+    ASSERT_EQ(1, sig->get_signs().size());
+    ASSERT_EQ(32, sig->get_signs()[0].get_r().size());
+    ASSERT_EQ(32, sig->get_signs()[0].get_s().size());
 
-}
\ No newline at end of file
+    dev::bytes encoded_again;
+    minter::rlp_buffer_sink sink(encoded_again);
+    decoded->encode_to(sink);
+    ASSERT_EQ(encoded, encoded_again);
+    ASSERT_EQ(decoded->encoded_size(), encoded.size());
+}
+
+TEST(TxMultisig, RejectsBareAddressLayout) {
+    // address followed by signatures list, without wrapping list
+    const dev::bytes encoded = make_multisig_tx(make_send(), multisig);
+    const dev::RLP fields(encoded);
+    const dev::RLP signature(fields[9].payload());
+    dev::bytes bare = signature[0].data().toBytes();
+    const dev::bytes signs = signature[1].data().toBytes();
+    bare.insert(bare.end(), signs.begin(), signs.end());
+
+    dev::RLPStream list(10);
+    for (size_t i = 0; i < 9; i++) {
+        list.appendRaw(fields[i].data());
+    }
+    list.append(bare);
+    ASSERT_FALSE(minter::tx::validate(dev::bytesConstRef(&list.out())).ok());
+    ASSERT_THROW(minter::tx::decode(list.out()), std::runtime_error);
+}
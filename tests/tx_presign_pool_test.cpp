@@ -0,0 +1,146 @@
+/*!
+ * minter_tx.
+ * tx_presign_pool_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_presign_pool.h>
+#include "send_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+TEST(TxPresignPool, TakesReadyTransactions) {
+    minter::tx_presign_pool::options opts;
+    opts.depth = 3;
+    opts.threads = 2;
+    minter::tx_presign_pool pool(pk, 10, opts);
+    const size_t one = pool.add_template([](const dev::bigint &nonce) { return make_send_tx(nonce, "1"); });
+    const size_t two = pool.add_template([](const dev::bigint &nonce) { return make_send_tx(nonce, "2"); });
+    ASSERT_THROW(pool.ready(2), std::runtime_error);
+
+    ASSERT_TRUE(pool.wait_ready(one, std::chrono::seconds(10)));
+    ASSERT_TRUE(pool.wait_ready(two, std::chrono::seconds(10)));
+    ASSERT_EQ(3, pool.ready(one));
+
+    minter::tx_presign_pool::signed_tx out;
+    ASSERT_TRUE(pool.try_take(one, out));
+    ASSERT_EQ(10, out.nonce);
+    ASSERT_EQ(make_signed_send(10, "1"), out.data.get());
+    ASSERT_EQ(11, pool.next_nonce());
+    // nonce 10 of the second template is dropped
+    ASSERT_TRUE(pool.wait_ready(two, std::chrono::seconds(10)));
+    out = pool.take(two);
+    ASSERT_EQ(11, out.nonce);
+    ASSERT_EQ(make_signed_send(11, "2"), out.data.get());
+
+    // consumed elsewhere
+    pool.invalidate(20);
+    ASSERT_EQ(20, pool.next_nonce());
+    ASSERT_TRUE(pool.wait_ready(one, std::chrono::seconds(10)));
+    out = pool.take(one);
+    ASSERT_EQ(20, out.nonce);
+    ASSERT_EQ(make_signed_send(20, "1"), out.data.get());
+}
+
+TEST(TxPresignPool, SignsOnRequestPathIfNotReady) {
+    minter::tx_presign_pool pool(pk, 1);
+    const size_t id = pool.add_template([](const dev::bigint &nonce) { return make_send_tx(nonce, "5"); });
+    // taken right away, most likely not signed yet
+    for (uint64_t nonce = 1; nonce < 20; nonce++) {
+        const auto out = pool.take(id);
+        ASSERT_EQ(nonce, out.nonce);
+        ASSERT_EQ(make_signed_send(nonce, "5"), out.data.get());
+    }
+}
+
+TEST(TxPresignPool, TemplateErrorIsRethrown) {
+    minter::tx_presign_pool pool(pk, 1);
+    const size_t id = pool.add_template([](const dev::bigint &) { return make_send_tx(dev::bigint(0), "1"); });
+    ASSERT_FALSE(pool.wait_ready(id, std::chrono::milliseconds(200)));
+    ASSERT_THROW(pool.take(id), std::runtime_error);
+    ASSERT_EQ(1, pool.next_nonce());
+}
+
+TEST(TxPresignPool, RequestPathErrorKeepsNonce) {
+    minter::tx_presign_pool::options opts;
+    // nothing is signed ahead, so take() always signs on calling thread
+    opts.depth = 0;
+    minter::tx_presign_pool pool(pk, 5, opts);
+    std::atomic<bool> fail(true);
+    const size_t id = pool.add_template([&fail](const dev::bigint &nonce) {
+        if (fail) {
+            throw std::runtime_error("template failed");
+        }
+        return make_send_tx(nonce, "1");
+    });
+
+    ASSERT_THROW(pool.take(id), std::runtime_error);
+    ASSERT_EQ(5, pool.next_nonce());
+
+    fail = false;
+    const auto out = pool.take(id);
+    ASSERT_EQ(5, out.nonce);
+    ASSERT_EQ(make_signed_send(5, "1"), out.data.get());
+    ASSERT_EQ(6, pool.next_nonce());
+}
+
+TEST(TxPresignPool, SigningFailureIsError) {
+    // secp256k1 rejects zero key, sign_single() returns "0x0"
+    const minter::privkey_t zero("0000000000000000000000000000000000000000000000000000000000000000");
+    minter::tx_presign_pool::options opts;
+    opts.depth = 0;
+    minter::tx_presign_pool on_request(zero, 5, opts);
+    const size_t id = on_request.add_template([](const dev::bigint &nonce) { return make_send_tx(nonce, "1"); });
+    ASSERT_THROW(on_request.take(id), std::runtime_error);
+    ASSERT_EQ(5, on_request.next_nonce());
+
+    minter::tx_presign_pool ahead(zero, 5);
+    const size_t ahead_id = ahead.add_template([](const dev::bigint &nonce) { return make_send_tx(nonce, "1"); });
+    ASSERT_FALSE(ahead.wait_ready(ahead_id, std::chrono::milliseconds(200)));
+    ASSERT_THROW(ahead.take(ahead_id), std::runtime_error);
+    ASSERT_EQ(5, ahead.next_nonce());
+}
+
+TEST(TxPresignPool, TakesWholeDepthWithoutWaiting) {
+    minter::tx_presign_pool::options opts;
+    opts.depth = 16;
+    minter::tx_presign_pool pool(pk, 1, opts);
+    const size_t id = pool.add_template([](const dev::bigint &nonce) { return make_send_tx(nonce, "1"); });
+    ASSERT_TRUE(pool.wait_ready(id, std::chrono::seconds(10)));
+
+    minter::tx_presign_pool::signed_tx out;
+    for (uint64_t nonce = 1; nonce <= 16; nonce++) {
+        ASSERT_TRUE(pool.try_take(id, out));
+        ASSERT_EQ(nonce, out.nonce);
+    }
+}
+
+TEST(TxPresignPool, DISABLED_Latency) {
+    minter::tx_presign_pool::options opts;
+    opts.depth = 16;
+    minter::tx_presign_pool pool(pk, 1, opts);
+    const size_t id = pool.add_template([](const dev::bigint &nonce) { return make_send_tx(nonce, "1"); });
+    ASSERT_TRUE(pool.wait_ready(id, std::chrono::seconds(10)));
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t nonce = 1; nonce <= 16; nonce++) {
+        make_send_tx(dev::bigint(nonce), "1")->sign_single(pk);
+    }
+    const double signing = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    minter::tx_presign_pool::signed_tx out;
+    for (int i = 0; i < 16; i++) {
+        ASSERT_TRUE(pool.try_take(id, out));
+    }
+    const double taking = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "presign pool: build+sign " << signing / 16 << " us, take " << taking / 16 << " us" << std::endl;
+}
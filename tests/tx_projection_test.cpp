@@ -0,0 +1,163 @@
+/*!
+ * minter_tx.
+ * tx_projection_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <chrono>
+#include <iostream>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_projection.h>
+#include <minter/tx/utils.h>
+#include "alloc_counter.h"
+#include "send_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+static dev::bytes make_delegate() {
+    return minter::new_tx()->set_nonce("2")
+        .set_chain_id(minter::testnet)
+        .set_gas_price("1")
+        .set_gas_coin("MNT")
+        .tx_delegate()
+        ->set_pub_key(minter::pubkey_t("Mp0eb98ea04ae466d8d38f490db3c99b3996a90e24243952ce9822c6dc1e2c1a43"))
+        .set_coin("MNT")
+        .set_stake("10")
+        .build()
+        ->sign_single(pk).get();
+}
+
+TEST(TxProjection, Header) {
+    const dev::bytes encoded = make_signed_send(128, "1", "payload");
+    minter::tx_projection proj;
+    auto status = minter::tx_projection::decode(dev::bytesConstRef(&encoded), minter::tx_field_mask::header, proj);
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    ASSERT_TRUE(proj.has(minter::tx_field_mask::header));
+    ASSERT_FALSE(proj.has(minter::tx_field_mask::payload));
+    ASSERT_FALSE(proj.has(minter::tx_field_mask::recipient));
+    ASSERT_EQ(128, proj.nonce);
+    ASSERT_EQ(minter::mainnet, proj.chain_id);
+    ASSERT_EQ(dev::bytes{0x01}, proj.gas_price.toBytes());
+    ASSERT_STREQ("BIP", proj.gas_coin.c_str());
+    ASSERT_EQ(minter::tx_send_coin_type::type(), proj.type);
+    ASSERT_TRUE(proj.payload.empty());
+}
+
+TEST(TxProjection, SameAsDecode) {
+    const dev::bytes encoded = make_signed_send(3, "1", "payload");
+    auto expected = minter::tx::decode(encoded);
+
+    minter::tx_projection proj;
+    const uint32_t all = minter::tx_field_mask::header | minter::tx_field_mask::data | minter::tx_field_mask::payload |
+        minter::tx_field_mask::service_data | minter::tx_field_mask::signature_type | minter::tx_field_mask::signature;
+    ASSERT_TRUE(minter::tx_projection::decode(dev::bytesConstRef(&encoded), all, proj).ok());
+
+    ASSERT_EQ(expected->get_nonce(), proj.nonce);
+    ASSERT_EQ(expected->get_gas_coin(), proj.gas_coin);
+    ASSERT_EQ(expected->get_data_raw(), proj.data.toBytes());
+    ASSERT_EQ(expected->get_payload(), proj.payload.toBytes());
+    ASSERT_EQ(expected->get_signature_type(), proj.signature_type);
+    ASSERT_EQ(expected->get_signature_data<minter::signature_single_data>()->encode(), proj.signature.toBytes());
+}
+
+TEST(TxProjection, Recipient) {
+    const dev::bytes send = make_signed_send(1);
+    minter::tx_projection proj;
+    ASSERT_TRUE(minter::tx_projection::decode(dev::bytesConstRef(&send), minter::tx_field_mask::recipient, proj).ok());
+    ASSERT_TRUE(proj.has(minter::tx_field_mask::recipient | minter::tx_field_mask::type));
+    ASSERT_EQ(minter::data::address("Mx0000000000000000000000000000000000000001").get(), proj.recipient.toBytes());
+
+    // not a send: no recipient, but no error
+    const dev::bytes delegate = make_delegate();
+    ASSERT_TRUE(minter::tx_projection::decode(dev::bytesConstRef(&delegate), minter::tx_field_mask::recipient, proj).ok());
+    ASSERT_FALSE(proj.has(minter::tx_field_mask::recipient));
+    ASSERT_EQ(minter::tx_delegate_type::type(), proj.type);
+}
+
+TEST(TxProjection, SkipsUnrequestedFields) {
+    dev::bytes encoded = make_signed_send(1);
+    // break signature list header: header fields are still readable
+    const dev::RLP s(encoded);
+    const size_t signature_offset = (size_t) (s[9].payload().data() - encoded.data());
+    encoded[signature_offset] = 0x00;
+
+    minter::tx_projection proj;
+    ASSERT_TRUE(minter::tx_projection::decode(dev::bytesConstRef(&encoded), minter::tx_field_mask::header, proj).ok());
+    ASSERT_FALSE(minter::tx::validate(dev::bytesConstRef(&encoded)).ok());
+}
+
+TEST(TxProjection, Errors) {
+    minter::tx_projection proj;
+    const dev::bytes not_list{0x01};
+    ASSERT_EQ(minter::decode_error::list_expected,
+              minter::tx_projection::decode(dev::bytesConstRef(&not_list), minter::tx_field_mask::nonce, proj).error);
+
+    const dev::bytes truncated{0xc5, 0x01};
+    ASSERT_EQ(minter::decode_error::truncated,
+              minter::tx_projection::decode(dev::bytesConstRef(&truncated), minter::tx_field_mask::nonce, proj).error);
+
+    const dev::bytes short_list{0xc1, 0x01};
+    ASSERT_EQ(minter::decode_error::invalid_field_count,
+              minter::tx_projection::decode(dev::bytesConstRef(&short_list), minter::tx_field_mask::type, proj).error);
+
+    // 9-byte nonce doesn't fit
+    dev::RLPStream list;
+    list.appendList(1);
+    list.append(dev::bytes(9, 0x01));
+    const dev::bytes big_nonce = list.out();
+    auto status = minter::tx_projection::decode(dev::bytesConstRef(&big_nonce), minter::tx_field_mask::nonce, proj);
+    ASSERT_EQ(minter::decode_error::int_too_big, status.error);
+    ASSERT_EQ(1, status.offset);
+}
+
+// filters transactions by type, as a mempool scanner would
+static size_t count_sends(const std::vector<dev::bytes> &txs) {
+    size_t sends = 0;
+    minter::tx_projection proj;
+    for (const auto &tx: txs) {
+        const uint32_t mask = minter::tx_field_mask::type | minter::tx_field_mask::gas_coin;
+        if (minter::tx_projection::decode(dev::bytesConstRef(&tx), mask, proj).ok() &&
+            proj.type == minter::tx_send_coin_type::type()) {
+            sends++;
+        }
+    }
+    return sends;
+}
+
+static std::vector<dev::bytes> make_mixed(size_t count) {
+    std::vector<dev::bytes> txs;
+    txs.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        txs.push_back(i % 2 == 0 ? make_signed_send(1) : make_delegate());
+    }
+    return txs;
+}
+
+TEST(TxProjection, FilterAllocatesNothing) {
+    const auto txs = make_mixed(200);
+    const size_t before = allocations;
+    ASSERT_EQ(100, count_sends(txs));
+    ASSERT_EQ(before, allocations.load());
+}
+
+TEST(TxProjection, DISABLED_FilterThroughput) {
+    const auto txs = make_mixed(20000);
+    size_t total_bytes = 0;
+    for (const auto &tx: txs) {
+        total_bytes += tx.size();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const size_t sends = count_sends(txs);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(txs.size() / 2, sends);
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::cout << "header filter: " << (total_bytes / 1024.0 / 1024.0) / (seconds > 0 ? seconds : 1e-9)
+              << " MiB/s" << std::endl;
+}
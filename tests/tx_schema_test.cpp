@@ -0,0 +1,87 @@
+/*!
+ * minter_tx.
+ * tx_schema_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_schema.h>
+
+TEST(TxSchema, SendCoinSameAsRlpStream) {
+    minter::tx_send_coin data;
+    data.set_coin("MNT")
+        .set_to("Mx0000000000000000000000000000000000000001")
+        .set_value(dev::bigint("1000000000000000000"));
+
+    dev::RLPStream lst;
+    lst.append(minter::coin_symbol("MNT").encoded());
+    lst.append(minter::address_t("Mx0000000000000000000000000000000000000001").get());
+    lst.append(dev::bigint("1000000000000000000"));
+    dev::RLPStream expected;
+    expected.appendList(lst);
+
+    ASSERT_EQ(expected.out(), minter::schema_encode(data));
+    ASSERT_EQ(expected.out().size(), minter::schema_encoded_size(data));
+}
+
+TEST(TxSchema, NestedListsRoundTrip) {
+    minter::tx_multisend multisend;
+    multisend.add_item("MNT", "Mx0000000000000000000000000000000000000001", "1")
+        .add_item("BIP", "Mx0000000000000000000000000000000000000002", "0");
+
+    dev::bytes encoded = multisend.encode();
+    ASSERT_EQ(encoded.size(), multisend.encoded_size());
+
+    minter::tx_multisend decoded;
+    decoded.decode(encoded);
+    ASSERT_EQ(2, decoded.get_items().size());
+    ASSERT_STREQ("BIP", decoded.get_items()[1].coin.c_str());
+    ASSERT_EQ(dev::bigint(0), decoded.get_items()[1].amount);
+    ASSERT_EQ(encoded, decoded.encode());
+
+    minter::tx_create_multisig_address multisig;
+    multisig.set_threshold(2)
+        .add_weight(1)
+        .add_weight(1)
+        .add_address("Mx0000000000000000000000000000000000000001")
+        .add_address("Mx0000000000000000000000000000000000000002");
+
+    minter::tx_create_multisig_address multisig_decoded;
+    multisig_decoded.decode(multisig.encode());
+    ASSERT_EQ(2, multisig_decoded.get_threshold());
+    ASSERT_EQ(multisig.get_weights(), multisig_decoded.get_weights());
+    ASSERT_EQ(multisig.get_addresses(), multisig_decoded.get_addresses());
+}
+
+TEST(TxSchema, VisitFields) {
+    minter::tx_create_coin data;
+    data.set_name("Super coin")
+        .set_ticker("SPRTEST")
+        .set_initial_amount("100")
+        .set_initial_reserve("10")
+        .set_crr(10);
+
+    std::vector<std::string> names;
+    minter::schema_visit(data, [&names](const char *name, const auto &) {
+        names.push_back(name);
+    });
+
+    std::vector<std::string> expected{"name", "ticker", "initial_amount", "initial_reserve", "crr"};
+    ASSERT_EQ(expected, names);
+    ASSERT_EQ(5, minter::tx_schema<minter::tx_create_coin>::fields::size);
+}
+
+TEST(TxSchema, InheritedSchema) {
+    minter::tx_set_candidate_on data;
+    data.set_pub_key(minter::pubkey_t("Mpeadea542b99de3b414806b362910cc518a177f8217b8452a8385a18d1687a80b"));
+
+    minter::tx_set_candidate_off decoded;
+    decoded.decode(minter::schema_encode(data));
+    ASSERT_EQ(data.get_pub_key(), decoded.get_pub_key());
+}
@@ -0,0 +1,88 @@
+/*!
+ * minter_tx.
+ * tx_send_coin_template_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <random>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_send_coin.h>
+#include <minter/tx/tx_send_coin_template.h>
+
+static std::shared_ptr<minter::tx> make_send(const dev::bigint &nonce,
+                                             const minter::address_t &to,
+                                             const dev::bigint &value,
+                                             const dev::bytes &payload) {
+    auto builder = minter::new_tx();
+    builder->set_nonce(nonce)
+        .set_chain_id(minter::mainnet)
+        .set_gas_price("1")
+        .set_gas_coin("MNT")
+        .set_payload(dev::bytes(payload));
+
+    return builder->tx_send_coin()
+        ->set_coin("BIP")
+        .set_to(to)
+        .set_value(value)
+        .build();
+}
+
+TEST(TxSendCoinTemplate, MatchesBuilder) {
+    std::mt19937_64 rnd(0x74706c);
+    minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+    for (size_t payload_size: {0, 1, 60, 200}) {
+        dev::bytes payload(payload_size, 0x70);
+        minter::tx_send_coin_template tpl(make_send(0, minter::address_t(dev::bytes(20)), 0, payload));
+
+        for (size_t i = 0; i < 100; i++) {
+            dev::bigint nonce = i == 0 ? 0 : dev::bigint(rnd() >> (rnd() % 64));
+            dev::bigint value = dev::bigint(rnd()) << (rnd() % 128);
+            dev::bytes to_data(20);
+            for (auto &b: to_data) {
+                b = (uint8_t) rnd();
+            }
+            minter::address_t to(std::move(to_data));
+
+            auto expected = make_send(nonce, to, value, payload)->sign_single(pk);
+            auto actual = tpl.sign_single(nonce, to, value, pk);
+            ASSERT_EQ(expected.toHex(), actual.toHex());
+            ASSERT_EQ(expected.size(), tpl.encoded_size(nonce, value));
+        }
+    }
+}
+
+TEST(TxSendCoinTemplate, SignBatchMatchesSingle) {
+    std::mt19937_64 rnd(0x626174);
+    minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+    for (size_t payload_size: {0, 200}) {
+        minter::tx_send_coin_template tpl(
+            make_send(0, minter::address_t(dev::bytes(20)), 0, dev::bytes(payload_size, 0x70)));
+
+        std::vector<minter::tx_send_coin_template::transfer> transfers;
+        // not a multiple of any kernel width
+        for (size_t i = 0; i < 13; i++) {
+            dev::bytes to_data(20, (uint8_t) i);
+            transfers.push_back({dev::bigint(rnd() >> (rnd() % 64)), minter::address_t(std::move(to_data)),
+                                 dev::bigint(rnd()) << (rnd() % 128)});
+        }
+
+        const auto signed_txs = tpl.sign_batch(transfers, pk);
+        ASSERT_EQ(transfers.size(), signed_txs.size());
+        for (size_t i = 0; i < transfers.size(); i++) {
+            ASSERT_EQ(tpl.sign_single(transfers[i].nonce, transfers[i].to, transfers[i].value, pk).toHex(),
+                      signed_txs[i].toHex());
+        }
+    }
+}
+
+TEST(TxSendCoinTemplate, RejectsOtherTypes) {
+    auto builder = minter::new_tx();
+    auto tx = builder->tx_delegate()->set_coin("MNT").set_stake("1").build();
+    ASSERT_THROW(minter::tx_send_coin_template tpl(tx), std::runtime_error);
+}
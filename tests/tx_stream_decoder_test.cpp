@@ -0,0 +1,182 @@
+/*!
+ * minter_tx.
+ * tx_stream_decoder_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_stream_decoder.h>
+#include "multisig_tx.h"
+#include "send_tx.h"
+
+static std::vector<minter::Data> make_txs(size_t count) {
+    std::vector<minter::Data> out;
+    for (size_t i = 0; i < count; i++) {
+        out.push_back(minter::Data(make_signed_send(i + 1)));
+    }
+    return out;
+}
+
+static minter::tx_stream_decoder::options small_batches(minter::tx_stream_format format) {
+    minter::tx_stream_decoder::options opts;
+    opts.format = format;
+    opts.threads = 4;
+    opts.batch_size = 3;
+    opts.max_batches = 2;
+    // small chunks, so records cross chunk boundaries
+    opts.chunk_size = 64;
+    opts.max_record_size = 1024;
+    return opts;
+}
+
+TEST(TxStreamDecoder, HexLinesInOrder) {
+    const auto txs = make_txs(50);
+    std::stringstream in;
+    for (size_t i = 0; i < txs.size(); i++) {
+        if (i % 2 == 0) {
+            in << "0x";
+        }
+        in << txs[i].toHex() << (i % 3 == 0 ? "\r\n" : "\n");
+        if (i == 10) {
+            in << "\n";
+        }
+    }
+
+    std::vector<minter::tx_stream_record> records;
+    minter::tx_stream_decoder decoder(small_batches(minter::tx_stream_format::hex_lines));
+    auto stats = decoder.decode(in, [&records](const minter::tx_stream_record &record) {
+        records.push_back(record);
+    });
+
+    ASSERT_EQ(txs.size(), stats.records);
+    ASSERT_EQ(0, stats.failed);
+    ASSERT_EQ(in.str().size(), stats.bytes);
+    ASSERT_EQ(txs.size(), records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        ASSERT_EQ(i, records[i].index);
+        ASSERT_TRUE(records[i].status.ok()) << records[i].status.message();
+        ASSERT_EQ(dev::bigint(i + 1), records[i].tx->get_nonce());
+    }
+}
+
+TEST(TxStreamDecoder, BadRecordsAreReported) {
+    const auto txs = make_txs(2);
+    std::stringstream in;
+    in << txs[0].toHex() << "\n";
+    in << "zz" << "\n";
+    in << std::string(5000, 'a') << "\n";
+    in << "c0\n";
+    // last line without line end
+    in << txs[1].toHex();
+
+    std::vector<minter::tx_stream_record> records;
+    minter::tx_stream_decoder decoder(small_batches(minter::tx_stream_format::hex_lines));
+    auto stats = decoder.decode(in, [&records](const minter::tx_stream_record &record) {
+        records.push_back(record);
+    });
+
+    ASSERT_EQ(5, stats.records);
+    ASSERT_EQ(3, stats.failed);
+    ASSERT_TRUE(records[0].status.ok());
+    ASSERT_EQ(minter::decode_error::invalid_data, records[1].status.error);
+    ASSERT_EQ(minter::decode_error::oversize, records[2].status.error);
+    ASSERT_EQ(minter::decode_error::invalid_field_count, records[3].status.error);
+    ASSERT_EQ(nullptr, records[3].tx);
+    ASSERT_TRUE(records[4].status.ok());
+    ASSERT_EQ(dev::bigint(2), records[4].tx->get_nonce());
+}
+
+TEST(TxStreamDecoder, MultiSignatureRecords) {
+    const minter::data::address multisig("Mxdb4f4b6942cb927e8d7e3a1f602d0f1fb43b5bd2");
+    const auto txs = make_txs(10);
+    std::stringstream in;
+    for (size_t i = 0; i < txs.size(); i++) {
+        if (i % 3 == 1) {
+            in << minter::Data(make_multisig_tx(txs[i].get(), multisig)).toHex() << "\n";
+        } else {
+            in << txs[i].toHex() << "\n";
+        }
+    }
+
+    std::vector<minter::tx_stream_record> records;
+    minter::tx_stream_decoder decoder(small_batches(minter::tx_stream_format::hex_lines));
+    auto stats = decoder.decode(in, [&records](const minter::tx_stream_record &record) {
+        records.push_back(record);
+    });
+
+    ASSERT_EQ(txs.size(), stats.records);
+    ASSERT_EQ(0, stats.failed);
+    for (size_t i = 0; i < records.size(); i++) {
+        ASSERT_TRUE(records[i].status.ok()) << records[i].status.message();
+        ASSERT_EQ(dev::bigint(i + 1), records[i].tx->get_nonce());
+        const uint8_t expected_type = i % 3 == 1 ? minter::signature_type::multi : minter::signature_type::single;
+        ASSERT_EQ(expected_type, records[i].tx->get_signature_type());
+    }
+}
+
+static void write_prefixed(std::ostream &out, const dev::bytes &data) {
+    const uint8_t size[4] = {
+        (uint8_t) (data.size() >> 24), (uint8_t) (data.size() >> 16), (uint8_t) (data.size() >> 8),
+        (uint8_t) data.size()
+    };
+    out.write((const char *) size, 4);
+    out.write((const char *) data.data(), data.size());
+}
+
+TEST(TxStreamDecoder, LengthPrefixed) {
+    const auto txs = make_txs(20);
+    std::stringstream in;
+    for (const auto &tx: txs) {
+        write_prefixed(in, tx.get());
+    }
+
+    size_t next = 0;
+    minter::tx_stream_decoder decoder(small_batches(minter::tx_stream_format::length_prefixed));
+    auto stats = decoder.decode(in, [&next](const minter::tx_stream_record &record) {
+        ASSERT_EQ(next++, record.index);
+        ASSERT_TRUE(record.status.ok());
+    });
+    ASSERT_EQ(txs.size(), stats.records);
+    ASSERT_EQ(txs.size(), next);
+}
+
+TEST(TxStreamDecoder, BrokenLengthPrefixedStream) {
+    const auto txs = make_txs(1);
+    minter::tx_stream_decoder decoder(small_batches(minter::tx_stream_format::length_prefixed));
+    auto ignore = [](const minter::tx_stream_record &) { };
+
+    // hostile length
+    std::stringstream too_big;
+    write_prefixed(too_big, txs[0].get());
+    too_big.write("\x7f\xff\xff\xff", 4);
+    ASSERT_THROW(decoder.decode(too_big, ignore), std::runtime_error);
+
+    std::stringstream truncated;
+    write_prefixed(truncated, txs[0].get());
+    truncated.write("\x00\x00\x00\x10\x01", 5);
+    ASSERT_THROW(decoder.decode(truncated, ignore), std::runtime_error);
+}
+
+TEST(TxStreamDecoder, CallbackExceptionStopsDecoding) {
+    const auto txs = make_txs(30);
+    std::stringstream in;
+    for (const auto &tx: txs) {
+        in << tx.toHex() << "\n";
+    }
+
+    size_t calls = 0;
+    minter::tx_stream_decoder decoder(small_batches(minter::tx_stream_format::hex_lines));
+    ASSERT_THROW(decoder.decode(in, [&calls](const minter::tx_stream_record &) {
+        if (++calls == 5) {
+            throw std::logic_error("stop");
+        }
+    }), std::logic_error);
+    ASSERT_EQ(5, calls);
+}
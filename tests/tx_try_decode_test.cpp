@@ -0,0 +1,205 @@
+/*!
+ * minter_tx.
+ * tx_try_decode_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/decode_status.h>
+#include <minter/tx/utils.h>
+#include "multisig_tx.h"
+#include "send_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+static dev::bytes make_tx(const dev::bigint &type, const dev::bytes &data) {
+    dev::RLPStream list;
+    list.append(dev::bigint(1));
+    list.append(dev::bigint(1));
+    list.append(dev::bigint(1));
+    list.append(minter::coin_symbol("BIP").encoded());
+    list.append(type);
+    list.append(data);
+    list.append(dev::bytes());
+    list.append(dev::bytes());
+    list.append(dev::bigint(1));
+    list.append(dev::bytes());
+
+    dev::RLPStream out;
+    out.appendList(list);
+    return out.out();
+}
+
+static minter::decode_status validate(const dev::bytes &data) {
+    return minter::validate_rlp(dev::bytesConstRef(&data));
+}
+
+TEST(RLPValidate, Valid) {
+    ASSERT_TRUE(validate(make_signed_send(1)).ok());
+    ASSERT_TRUE(validate(dev::bytes{0x80}).ok());
+    ASSERT_TRUE(validate(dev::bytes{0xc0}).ok());
+}
+
+TEST(RLPValidate, Truncated) {
+    auto status = validate(dev::bytes{0x83, 'a', 'b'});
+    ASSERT_EQ(minter::decode_error::truncated, status.error);
+    ASSERT_EQ(0, status.offset);
+
+    // list with truncated second item
+    status = validate(dev::bytes{0xc4, 0x01, 0x83, 'a', 'b'});
+    ASSERT_EQ(minter::decode_error::truncated, status.error);
+
+    // long string length prefix claims more than whole address space
+    status = validate(dev::bytes{0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01});
+    ASSERT_FALSE(status.ok());
+
+    ASSERT_EQ(minter::decode_error::truncated, validate(dev::bytes()).error);
+}
+
+TEST(RLPValidate, NonCanonical) {
+    // single byte below 0x80 must not have a header
+    auto status = validate(dev::bytes{0xc2, 0x81, 0x05});
+    ASSERT_EQ(minter::decode_error::non_canonical_rlp, status.error);
+    ASSERT_EQ(1, status.offset);
+
+    // short string must not use long form
+    status = validate(dev::bytes{0xb8, 0x01, 'a'});
+    ASSERT_EQ(minter::decode_error::non_canonical_rlp, status.error);
+}
+
+TEST(RLPValidate, Oversize) {
+    auto status = validate(dev::bytes{0x01, 0x02});
+    ASSERT_EQ(minter::decode_error::oversize, status.error);
+    ASSERT_EQ(1, status.offset);
+}
+
+TEST(RLPValidate, TooDeep) {
+    // every list contains the next one
+    const size_t depth = dev::c_rlpMaxDepth + 8;
+    dev::bytes nested(depth);
+    for (size_t i = 0; i < depth; i++) {
+        nested[i] = (uint8_t) (0xc0 + (depth - 1 - i));
+    }
+
+    ASSERT_EQ(minter::decode_error::too_deep, validate(nested).error);
+    ASSERT_TRUE(validate(dev::bytes(nested.begin() + 8, nested.end())).ok());
+}
+
+TEST(TxTryDecode, SameAsDecode) {
+    dev::bytes encoded = make_signed_send(1, "1", "payload");
+    auto expected = minter::tx::decode(encoded);
+
+    std::shared_ptr<minter::tx> decoded;
+    auto status = minter::tx::try_decode(dev::bytesConstRef(&encoded), decoded);
+    ASSERT_TRUE(status.ok()) << status.message();
+    ASSERT_NE(nullptr, decoded);
+
+    ASSERT_EQ(expected->get_nonce(), decoded->get_nonce());
+    ASSERT_EQ(expected->get_chain_id(), decoded->get_chain_id());
+    ASSERT_EQ(expected->get_gas_coin(), decoded->get_gas_coin());
+    ASSERT_EQ(expected->get_type(), decoded->get_type());
+    ASSERT_EQ(expected->get_payload(), decoded->get_payload());
+    ASSERT_EQ(expected->get_data_raw(), decoded->get_data_raw());
+    ASSERT_EQ(expected->get_signature_data<minter::signature_single_data>()->get_s(),
+              decoded->get_signature_data<minter::signature_single_data>()->get_s());
+
+    auto data = decoded->get_data<minter::tx_send_coin>();
+    ASSERT_STREQ("MNT", data->get_coin().c_str());
+    ASSERT_EQ(minter::data::address("Mx0000000000000000000000000000000000000001"), data->get_to());
+}
+
+TEST(TxTryDecode, MultiSignature) {
+    const minter::data::address multisig("Mxdb4f4b6942cb927e8d7e3a1f602d0f1fb43b5bd2");
+    dev::bytes encoded = make_multisig_tx(minter::new_tx()->set_nonce("7")
+                                              .set_gas_coin("BIP")
+                                              .tx_send_coin()
+                                              ->set_coin("MNT")
+                                              .set_to("Mx0000000000000000000000000000000000000001")
+                                              .set_value("1")
+                                              .build()
+                                              ->sign_single(pk).get(), multisig);
+    ASSERT_TRUE(minter::tx::validate(dev::bytesConstRef(&encoded)).ok());
+
+    std::shared_ptr<minter::tx> decoded;
+    minter::decode_status status;
+    ASSERT_NO_THROW(status = minter::tx::try_decode(dev::bytesConstRef(&encoded), decoded));
+    ASSERT_TRUE(status.ok()) << status.message();
+    ASSERT_EQ(dev::bigint(7), decoded->get_nonce());
+    ASSERT_EQ(minter::signature_type::multi, decoded->get_signature_type());
+    ASSERT_EQ(multisig, decoded->get_signature_data<minter::signature_multi_data>()->get_address());
+}
+
+TEST(TxTryDecode, Junk) {
+    std::shared_ptr<minter::tx> decoded;
+    auto try_decode = [&decoded](const dev::bytes &data) {
+        return minter::tx::try_decode(dev::bytesConstRef(&data), decoded);
+    };
+
+    ASSERT_EQ(minter::decode_error::list_expected, try_decode(dev::bytes{0x01}).error);
+    ASSERT_EQ(minter::decode_error::invalid_field_count, try_decode(dev::bytes{0xc2, 0x01, 0x02}).error);
+
+    dev::bytes encoded = make_signed_send(1);
+    dev::bytes truncated(encoded.begin(), encoded.end() - 1);
+    ASSERT_EQ(minter::decode_error::truncated, try_decode(truncated).error);
+
+    // every single byte flip either decodes or reports an error, but never throws
+    for (size_t i = 0; i < encoded.size(); i++) {
+        dev::bytes broken = encoded;
+        broken[i] ^= 0xff;
+        ASSERT_NO_THROW(try_decode(broken));
+    }
+}
+
+TEST(TxTryDecode, UnknownType) {
+    dev::bytes encoded = make_tx(0x7f, dev::bytes{0xc0});
+    dev::RLP s(encoded);
+
+    std::shared_ptr<minter::tx> decoded;
+    auto status = minter::tx::try_decode(dev::bytesConstRef(&encoded), decoded);
+    ASSERT_EQ(minter::decode_error::unknown_type, status.error);
+    ASSERT_EQ((size_t) (s[4].data().data() - encoded.data()), status.offset);
+    ASSERT_EQ(nullptr, decoded);
+}
+
+TEST(TxTryDecode, DataErrorOffset) {
+    dev::RLPStream data;
+    data.append(minter::coin_symbol("MNT").encoded());
+    data.append(dev::bytes(19));
+    data.append(dev::bigint(1));
+    dev::RLPStream data_list;
+    data_list.appendList(data);
+    const dev::bytes encoded_data = data_list.out();
+
+    // data decoded alone reports offset inside data
+    auto send = minter::tx_send_coin();
+    auto status = send.try_decode(dev::bytesConstRef(&encoded_data));
+    ASSERT_EQ(minter::decode_error::invalid_length, status.error);
+    const size_t address_offset = (size_t) (dev::RLP(encoded_data)[1].data().data() - encoded_data.data());
+    ASSERT_EQ(address_offset, status.offset);
+
+    // and inside transaction, offset is relative to transaction start
+    dev::bytes encoded = make_tx(minter::tx_send_coin_type::type(), encoded_data);
+    const size_t data_offset = (size_t) (dev::RLP(encoded)[5].payload().data() - encoded.data());
+
+    std::shared_ptr<minter::tx> decoded;
+    status = minter::tx::try_decode(dev::bytesConstRef(&encoded), decoded);
+    ASSERT_EQ(minter::decode_error::invalid_length, status.error);
+    ASSERT_EQ(data_offset + address_offset, status.offset);
+}
+
+TEST(TxTryDecode, NonCanonicalInt) {
+    dev::RLPStream data;
+    data.append(minter::coin_symbol("MNT").encoded());
+    data.append(dev::bytes(20));
+    data.append(dev::bytes{0x00, 0x01});
+    dev::RLPStream data_list;
+    data_list.appendList(data);
+    const dev::bytes encoded_data = data_list.out();
+
+    auto send = minter::tx_send_coin();
+    ASSERT_EQ(minter::decode_error::non_canonical_int, send.try_decode(dev::bytesConstRef(&encoded_data)).error);
+}
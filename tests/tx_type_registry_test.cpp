@@ -0,0 +1,91 @@
+/*!
+ * minter_tx.
+ * tx_type_registry_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <string>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_type.h>
+
+namespace minter {
+
+// custom transaction type, unknown to library
+class tx_test_custom: public virtual minter::tx_data {
+public:
+    explicit tx_test_custom(std::shared_ptr<minter::tx> tx = nullptr) : tx_data(std::move(tx)) { }
+    uint16_t type() const override;
+    dev::bytes encode() override {
+        dev::RLPStream out;
+        out.appendList(1);
+        out.append(m_value);
+        return out.out();
+    }
+    size_t encoded_size() const override {
+        return dev::rlpListSize(dev::rlpItemSize(m_value));
+    }
+
+    dev::bigint m_value;
+
+protected:
+    void decode_internal(dev::RLP rlp) override {
+        m_value = (dev::bigint) rlp[0];
+    }
+};
+
+create_tx_type(tx_test_custom, 0x40);
+
+}
+
+define_tx_type_funcs(tx_test_custom, 1)
+
+uint16_t minter::tx_test_custom::type() const {
+    return minter::tx_test_custom_type::type();
+}
+
+static_assert(minter::tx_send_coin_type::type() == minter::tx_type_val::send_coin, "type id must be constexpr");
+static_assert(minter::tx_edit_candidate_type::type() == 0x0E, "type id must be constexpr");
+
+TEST(TxTypeRegistry, BuiltinTypes) {
+    ASSERT_STREQ("send", minter::tx_type_registry::name(minter::tx_type_val::send_coin));
+    ASSERT_STREQ("edit candidate", minter::tx_type_registry::name(minter::tx_type_val::edit_candidate));
+    ASSERT_EQ(nullptr, minter::tx_type_registry::find(0));
+    ASSERT_EQ(nullptr, minter::tx_type_registry::find(0x0F));
+    ASSERT_EQ(nullptr, minter::tx_type_registry::find(1000));
+
+    const minter::tx_type_info *info = minter::tx_type_registry::find(minter::tx_type_val::delegate);
+    ASSERT_NE(nullptr, info);
+    ASSERT_EQ(minter::tx_delegate_type::get_fee(), info->get_fee());
+
+    switch (minter::tx_type_val::multisend) {
+        case minter::tx_multisend_type::type(): break;
+        default: FAIL() << "type id must be usable in switch";
+    }
+}
+
+TEST(TxTypeRegistry, InvalidRegistration) {
+    minter::tx_type_info info;
+    info.name = "invalid";
+    EXPECT_THROW(minter::tx_type_registry::add(0x41, info), std::runtime_error);
+    info.create = &minter::tx_type_registry::create_data<minter::tx_test_custom>;
+    EXPECT_THROW(minter::tx_type_registry::add(256, info), std::runtime_error);
+}
+
+TEST(TxTypeRegistry, CustomTypeDecode) {
+    minter::tx_type_registry::add<minter::tx_test_custom>("test custom");
+    ASSERT_STREQ("test custom", minter::tx_type_registry::name(0x40));
+
+    auto data = minter::new_tx()->set_nonce("1").tx_data<minter::tx_test_custom>();
+    data->m_value = 12345;
+    auto encoded = data->build()->sign_single(minter::privkey_t("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f"));
+
+    auto decoded = minter::tx::decode(encoded.get());
+    ASSERT_EQ(0x40, decoded->get_type());
+    auto custom = decoded->get_data<minter::tx_test_custom>();
+    ASSERT_NE(nullptr, custom);
+    ASSERT_EQ(dev::bigint(12345), custom->m_value);
+}
@@ -0,0 +1,183 @@
+/*!
+ * minter_tx.
+ * tx_validate_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/decode_status.h>
+#include <minter/tx/utils.h>
+#include "alloc_counter.h"
+#include "send_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+static std::shared_ptr<minter::tx_builder> make_builder() {
+    auto builder = minter::new_tx();
+    builder->set_nonce("1")
+        .set_chain_id(minter::mainnet)
+        .set_gas_price("1")
+        .set_gas_coin("BIP");
+    return builder;
+}
+
+static dev::bytes make_raw(dev::bytesConstRef gas_coin,
+                           const dev::bytes &data,
+                           const dev::bytes &signature,
+                           const dev::bigint &signature_type = minter::signature_type::single) {
+    dev::RLPStream list;
+    list.append(dev::bigint(1));
+    list.append(dev::bigint(1));
+    list.append(dev::bigint(1));
+    list.append(gas_coin);
+    list.append(dev::bigint(minter::tx_send_coin_type::type()));
+    list.append(data);
+    list.append(dev::bytes());
+    list.append(dev::bytes());
+    list.append(signature_type);
+    list.append(signature);
+
+    dev::RLPStream out;
+    out.appendList(list);
+    return out.out();
+}
+
+static dev::bytes make_send_data(const dev::bytes &to) {
+    dev::RLPStream data;
+    data.append(minter::coin_symbol("MNT").encoded());
+    data.append(to);
+    data.append(dev::bigint(1));
+    dev::RLPStream out;
+    out.appendList(data);
+    return out.out();
+}
+
+static dev::bytes make_signature(const dev::bytes &r) {
+    dev::RLPStream sig;
+    sig.append(dev::bytes{0x1b});
+    sig.append(r);
+    sig.append(dev::bytes(32, 0x01));
+    dev::RLPStream out;
+    out.appendList(sig);
+    return out.out();
+}
+
+static minter::decode_status validate(const dev::bytes &data) {
+    return minter::tx::validate(dev::bytesConstRef(&data));
+}
+
+TEST(TxValidate, ValidTransactions) {
+    ASSERT_TRUE(validate(make_signed_send(1)).ok());
+
+    dev::bytes delegate = make_builder()->tx_delegate()
+        ->set_pub_key(minter::pubkey_t("Mp0eb98ea04ae466d8d38f490db3c99b3996a90e24243952ce9822c6dc1e2c1a43"))
+        .set_coin("MNT")
+        .set_stake("10")
+        .build()
+        ->sign_single(pk).get();
+    ASSERT_TRUE(validate(delegate).ok());
+
+    dev::bytes multisend = make_builder()->tx_multisend()
+        ->add_item("MNT", "Mx0000000000000000000000000000000000000001", "1")
+        .add_item("BIP", "Mx0000000000000000000000000000000000000002", "2")
+        .build()
+        ->sign_single(pk).get();
+    ASSERT_TRUE(validate(multisend).ok());
+
+    minter::signature_single_data sign;
+    sign.set_signature(dev::bytes{0x1b}, dev::bytes(32, 0x01), dev::bytes(32, 0x02));
+    minter::signature_multi_data multi;
+    multi.set_signatures(minter::data::address("Mxdb4f4b6942cb927e8d7e3a1f602d0f1fb43b5bd2"), {sign, sign});
+    dev::bytes multisig = make_raw(minter::coin_symbol("BIP").encoded(),
+                                   make_send_data(dev::bytes(20)),
+                                   multi.encode(),
+                                   minter::signature_type::multi);
+    ASSERT_TRUE(validate(multisig).ok());
+}
+
+TEST(TxValidate, DoesNotAllocate) {
+    const dev::bytes valid = make_signed_send(1);
+    const dev::bytes invalid = make_raw(minter::coin_symbol("BIP").encoded(),
+                                        make_send_data(dev::bytes(19)),
+                                        make_signature(dev::bytes(32, 0x01)));
+
+    const size_t before = allocations;
+    ASSERT_TRUE(validate(valid).ok());
+    ASSERT_FALSE(validate(invalid).ok());
+    ASSERT_EQ(before, allocations.load());
+}
+
+TEST(TxValidate, HostileLengthPrefix) {
+    // list header claims 2^62 bytes
+    dev::bytes data{0xf8 + 7, 0x40, 0, 0, 0, 0, 0, 0, 0, 0xc0};
+    auto status = validate(data);
+    ASSERT_EQ(minter::decode_error::truncated, status.error);
+    ASSERT_EQ(0, status.offset);
+    ASSERT_THROW(minter::tx::decode(data), std::runtime_error);
+
+    // same inside valid outer list, at data field
+    dev::bytes encoded = make_raw(minter::coin_symbol("BIP").encoded(),
+                                  dev::bytes{0xb8 + 7, 0x40, 0, 0, 0, 0, 0, 0, 0},
+                                  make_signature(dev::bytes(32, 0x01)));
+    const size_t data_offset = (size_t) (dev::RLP(encoded)[5].payload().data() - encoded.data());
+    status = validate(encoded);
+    ASSERT_EQ(minter::decode_error::truncated, status.error);
+    ASSERT_EQ(data_offset, status.offset);
+}
+
+TEST(TxValidate, FieldWidths) {
+    const dev::bytes good_data = make_send_data(dev::bytes(20));
+    const dev::bytes good_signature = make_signature(dev::bytes(32, 0x01));
+    ASSERT_TRUE(validate(make_raw(minter::coin_symbol("BIP").encoded(), good_data, good_signature)).ok());
+
+    // 11-byte gas coin
+    const dev::bytes long_coin(11, 'A');
+    dev::bytes encoded = make_raw(dev::bytesConstRef(&long_coin), good_data, good_signature);
+    auto status = validate(encoded);
+    ASSERT_EQ(minter::decode_error::invalid_length, status.error);
+    ASSERT_EQ((size_t) (dev::RLP(encoded)[3].data().data() - encoded.data()), status.offset);
+
+    // 19-byte recipient address
+    encoded = make_raw(minter::coin_symbol("BIP").encoded(), make_send_data(dev::bytes(19)), good_signature);
+    status = validate(encoded);
+    ASSERT_EQ(minter::decode_error::invalid_length, status.error);
+    const dev::RLP data(dev::RLP(encoded)[5].payload());
+    ASSERT_EQ((size_t) (data[1].data().data() - encoded.data()), status.offset);
+
+    // 33-byte r
+    encoded = make_raw(minter::coin_symbol("BIP").encoded(), good_data, make_signature(dev::bytes(33, 0x01)));
+    status = validate(encoded);
+    ASSERT_EQ(minter::decode_error::invalid_length, status.error);
+    const dev::RLP signature(dev::RLP(encoded)[9].payload());
+    ASSERT_EQ((size_t) (signature[1].data().data() - encoded.data()), status.offset);
+    ASSERT_THROW(minter::tx::decode(encoded), std::runtime_error);
+
+    // 31-byte r
+    encoded = make_raw(minter::coin_symbol("BIP").encoded(), good_data, make_signature(dev::bytes(31, 0x01)));
+    ASSERT_EQ(minter::decode_error::invalid_length, validate(encoded).error);
+}
+
+TEST(TxValidate, FieldCount) {
+    dev::RLPStream list;
+    list.appendList(9);
+    for (size_t i = 0; i < 9; i++) {
+        list.append(dev::bigint(1));
+    }
+    auto status = validate(list.out());
+    ASSERT_EQ(minter::decode_error::invalid_field_count, status.error);
+    ASSERT_EQ(0, status.offset);
+
+    // send data with extra field
+    dev::RLPStream data;
+    data.appendList(4);
+    data.append(minter::coin_symbol("MNT").encoded());
+    data.append(dev::bytes(20));
+    data.append(dev::bigint(1));
+    data.append(dev::bigint(1));
+    status = validate(make_raw(minter::coin_symbol("BIP").encoded(), data.out(), make_signature(dev::bytes(32, 0x01))));
+    ASSERT_EQ(minter::decode_error::invalid_field_count, status.error);
+}
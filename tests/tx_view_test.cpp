@@ -0,0 +1,116 @@
+/*!
+ * minter_tx.
+ * tx_view_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_view.h>
+#include <minter/tx/utils.h>
+#include "alloc_counter.h"
+#include "multisig_tx.h"
+#include "send_tx.h"
+
+TEST(TxView, SameAsDecode) {
+    const dev::bytes encoded = make_signed_send(128, "1.5", "payload");
+    auto expected = minter::tx::decode(encoded);
+
+    minter::tx_view view{dev::bytesConstRef(&encoded)};
+    ASSERT_EQ(128, view.get_nonce());
+    ASSERT_EQ(minter::mainnet, view.get_chain_id());
+    ASSERT_EQ(1, view.get_gas_price());
+    ASSERT_STREQ("BIP", view.get_gas_coin().c_str());
+    ASSERT_EQ(minter::tx_send_coin_type::type(), view.get_type());
+    ASSERT_EQ(expected->get_data_raw(), view.get_data_raw().toBytes());
+    ASSERT_EQ(minter::utils::to_bytes("payload"), view.get_payload().toBytes());
+    ASSERT_TRUE(view.get_service_data().empty());
+    ASSERT_EQ(minter::signature_type::single, view.get_signature_type());
+
+    // fields point into source buffer
+    ASSERT_GE(view.get_payload().data(), encoded.data());
+    ASSERT_LE(view.get_payload().data(), encoded.data() + encoded.size());
+
+    auto data = view.get_data<minter::tx_send_coin>();
+    ASSERT_STREQ("MNT", data.get_coin().c_str());
+    ASSERT_EQ(dev::bigdec18("1.5"), data.get_value());
+    ASSERT_THROW(view.get_data<minter::tx_delegate>(), std::runtime_error);
+
+    auto sig = view.get_signature_data<minter::signature_single_data>();
+    ASSERT_EQ(expected->get_signature_data<minter::signature_single_data>()->get_r(), sig.get_r());
+}
+
+TEST(TxView, MultiSignature) {
+    const minter::data::address multisig("Mxdb4f4b6942cb927e8d7e3a1f602d0f1fb43b5bd2");
+    const dev::bytes encoded = make_multisig_tx(make_signed_send(3), multisig);
+
+    minter::tx_view view{dev::bytesConstRef(&encoded)};
+    ASSERT_EQ(3, view.get_nonce());
+    ASSERT_EQ(minter::signature_type::multi, view.get_signature_type());
+    auto sig = view.get_signature_data<minter::signature_multi_data>();
+    ASSERT_EQ(multisig, sig.get_address());
+    ASSERT_EQ(1, sig.get_signs().size());
+
+    // signature is address only, not a list
+    dev::RLPStream list(10);
+    const dev::RLP fields(encoded);
+    for (size_t i = 0; i < 9; i++) {
+        list.appendRaw(fields[i].data());
+    }
+    list.append(dev::rlp(multisig.get()));
+    ASSERT_THROW(minter::tx_view(dev::bytesConstRef(&list.out())), std::runtime_error);
+}
+
+TEST(TxView, Invalid) {
+    const dev::bytes encoded = make_signed_send(1);
+    dev::bytes truncated(encoded.begin(), encoded.end() - 1);
+    ASSERT_ANY_THROW(minter::tx_view(dev::bytesConstRef(&truncated)));
+
+    dev::RLPStream short_list;
+    short_list.appendList(2);
+    short_list.append(dev::bigint(1));
+    short_list.append(dev::bigint(2));
+    ASSERT_THROW(minter::tx_view(dev::bytesConstRef(&short_list.out())), std::runtime_error);
+
+    dev::RLPStream not_list;
+    not_list.append(dev::bigint(1));
+    ASSERT_THROW(minter::tx_view(dev::bytesConstRef(&not_list.out())), std::runtime_error);
+
+    // 31-byte r: rejected by tx::validate() too
+    dev::RLPStream sig(3);
+    sig.append(dev::bytes{0x1b});
+    sig.append(dev::bytes(31, 0x01));
+    sig.append(dev::bytes(32, 0x02));
+    dev::RLPStream short_r(10);
+    const dev::RLP fields(encoded);
+    for (size_t i = 0; i < 9; i++) {
+        short_r.appendRaw(fields[i].data());
+    }
+    short_r.append(sig.out());
+    ASSERT_FALSE(minter::tx::validate(dev::bytesConstRef(&short_r.out())).ok());
+    ASSERT_THROW(minter::tx_view(dev::bytesConstRef(&short_r.out())), std::runtime_error);
+}
+
+TEST(TxView, ScanWithoutAllocations) {
+    std::vector<dev::bytes> block;
+    for (size_t i = 1; i <= 100; i++) {
+        block.push_back(make_signed_send(i));
+    }
+
+    uint64_t nonce_sum = 0;
+    size_t send_count = 0;
+    const size_t before = allocations;
+    for (const auto &encoded: block) {
+        minter::tx_view view{dev::bytesConstRef(&encoded)};
+        nonce_sum += view.get_nonce();
+        if (view.get_type() == minter::tx_type_val::send_coin && view.get_gas_coin() == minter::coin_symbol("BIP")) {
+            send_count++;
+        }
+    }
+    ASSERT_EQ(before, allocations.load());
+    ASSERT_EQ(5050, nonce_sum);
+    ASSERT_EQ(100, send_count);
+}
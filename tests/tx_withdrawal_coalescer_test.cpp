@@ -0,0 +1,301 @@
+/*!
+ * minter_tx.
+ * tx_withdrawal_coalescer_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <future>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/tx_multisend_planner.h>
+#include <minter/tx/tx_withdrawal_coalescer.h>
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+
+static minter::send_target withdrawal(size_t i) {
+    char address[43];
+    snprintf(address, sizeof(address), "Mx%040zx", i + 1);
+    return minter::send_target{minter::coin_symbol("MNT"), minter::data::address(address), dev::bigint(i + 1)};
+}
+
+TEST(TxWithdrawalCoalescer, BatchesByCount) {
+    minter::nonce_allocator nonces(5);
+    minter::tx_withdrawal_coalescer::options opts;
+    opts.max_items = 10;
+    opts.window = std::chrono::seconds(60);
+    opts.threads = 2;
+
+    std::atomic<size_t> sent(0);
+    minter::tx_withdrawal_coalescer coalescer(pk, nonces, opts, [&sent](const minter::tx_withdrawal_coalescer::tx_ptr &) {
+        sent++;
+    });
+
+    std::vector<std::future<minter::tx_withdrawal_coalescer::tx_ptr>> results;
+    for (size_t i = 0; i < 30; i++) {
+        results.push_back(coalescer.submit(withdrawal(i)));
+    }
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto tx = results[i].get();
+        ASSERT_EQ(5 + i / 10, tx->nonce);
+        ASSERT_EQ(10, tx->items.size());
+        ASSERT_EQ(withdrawal(i).to, tx->items[i % 10].to);
+
+        auto decoded = minter::tx::decode(tx->data.get());
+        ASSERT_EQ(dev::bigint(tx->nonce), decoded->get_nonce());
+        const auto items = decoded->get_data<minter::tx_multisend>()->get_items();
+        ASSERT_EQ(10, items.size());
+        ASSERT_EQ(withdrawal(i).amount, items[i % 10].amount);
+    }
+    ASSERT_EQ(3, sent.load());
+    ASSERT_EQ(8, nonces.next());
+
+    const auto stats = coalescer.stats();
+    ASSERT_EQ(30, stats.items);
+    ASSERT_EQ(3, stats.txs);
+    ASSERT_EQ(0, stats.single_txs);
+    ASSERT_EQ(minter::tx_multisend_planner::fee(10, 0, 1) * 3, stats.fee);
+    ASSERT_EQ(minter::utils::normalize_value(minter::tx_send_coin_type::get_fee()) * 30 - stats.fee, stats.saved_fee);
+    ASSERT_LE(stats.latency_p50, stats.latency_p90);
+    ASSERT_LE(stats.latency_p99, stats.latency_max);
+}
+
+TEST(TxWithdrawalCoalescer, WindowAndSingleton) {
+    minter::nonce_allocator nonces(1);
+    minter::tx_withdrawal_coalescer::options opts;
+    opts.window = std::chrono::milliseconds(20);
+    minter::tx_withdrawal_coalescer coalescer(pk, nonces, opts);
+
+    // closed by window
+    auto single = coalescer.submit(withdrawal(0));
+    const auto tx = single.get();
+    ASSERT_EQ(1, tx->nonce);
+    ASSERT_EQ(1, tx->items.size());
+    auto decoded = minter::tx::decode(tx->data.get());
+    ASSERT_EQ(minter::tx_send_coin_type::type(), decoded->get_type());
+    ASSERT_EQ(withdrawal(0).to, decoded->get_data<minter::tx_send_coin>()->get_to());
+    ASSERT_GE(coalescer.stats().latency_max, 19.0);
+
+    // closed by flush
+    auto a = coalescer.submit(withdrawal(1));
+    auto b = coalescer.submit(withdrawal(2));
+    coalescer.flush();
+    const auto batched = a.get();
+    ASSERT_EQ(batched, b.get());
+    ASSERT_EQ(2, batched->nonce);
+
+    const auto stats = coalescer.stats();
+    ASSERT_EQ(3, stats.items);
+    ASSERT_EQ(2, stats.txs);
+    ASSERT_EQ(1, stats.single_txs);
+}
+
+TEST(TxWithdrawalCoalescer, CallbackErrorAndShutdown) {
+    minter::nonce_allocator nonces(1);
+    std::future<minter::tx_withdrawal_coalescer::tx_ptr> failed, pending;
+    {
+        minter::tx_withdrawal_coalescer::options opts;
+        opts.window = std::chrono::seconds(60);
+        minter::tx_withdrawal_coalescer coalescer(pk, nonces, opts, [](const minter::tx_withdrawal_coalescer::tx_ptr &tx) {
+            if (tx->nonce == 1) {
+                throw std::runtime_error("can't send");
+            }
+        });
+        failed = coalescer.submit(withdrawal(0));
+        coalescer.flush();
+        ASSERT_THROW(failed.get(), std::runtime_error);
+        ASSERT_EQ(0, coalescer.stats().txs);
+        ASSERT_EQ(1, nonces.next());
+
+        pending = coalescer.submit(withdrawal(1));
+    }
+    // signed on destruction; nonce of failed callback is reused, callback fails again
+    ASSERT_THROW(pending.get(), std::runtime_error);
+    ASSERT_EQ(1, nonces.next());
+}
+
+TEST(TxWithdrawalCoalescer, CallbackInNonceOrder) {
+    minter::nonce_allocator nonces(1);
+    minter::tx_withdrawal_coalescer::options opts;
+    opts.window = std::chrono::seconds(60);
+    opts.max_items = 1;
+    opts.threads = 4;
+
+    std::vector<uint64_t> sent;
+    std::atomic<int> calls(0);
+    bool concurrent = false;
+    std::vector<std::future<minter::tx_withdrawal_coalescer::tx_ptr>> results;
+    {
+        minter::tx_withdrawal_coalescer coalescer(pk, nonces, opts, [&](const minter::tx_withdrawal_coalescer::tx_ptr &tx) {
+            if (calls++ != 0) {
+                concurrent = true;
+            }
+            sent.push_back(tx->nonce);
+            calls--;
+        });
+        for (size_t i = 0; i < 40; i++) {
+            results.push_back(coalescer.submit(withdrawal(i)));
+        }
+    }
+
+    ASSERT_FALSE(concurrent);
+    ASSERT_EQ(40, sent.size());
+    for (size_t i = 0; i < sent.size(); i++) {
+        ASSERT_EQ(1 + i, sent[i]);
+        ASSERT_EQ(1 + i, results[i].get()->nonce);
+    }
+}
+
+TEST(TxWithdrawalCoalescer, FailureFailsBatchesBehind) {
+    minter::nonce_allocator nonces(1);
+    minter::tx_withdrawal_coalescer::options opts;
+    opts.window = std::chrono::seconds(60);
+    opts.max_items = 1;
+    opts.threads = 4;
+
+    std::promise<void> go;
+    std::shared_future<void> gate = go.get_future().share();
+    std::atomic<bool> fail(true);
+    std::vector<uint64_t> sent;
+    std::vector<std::future<minter::tx_withdrawal_coalescer::tx_ptr>> results;
+    {
+        minter::tx_withdrawal_coalescer coalescer(pk, nonces, opts, [&](const minter::tx_withdrawal_coalescer::tx_ptr &tx) {
+            if (fail.exchange(false)) {
+                gate.wait();
+                throw std::runtime_error("can't send");
+            }
+            sent.push_back(tx->nonce);
+        });
+        // nonces 2 and 3 are signed before nonce 1 fails
+        for (size_t i = 0; i < 3; i++) {
+            results.push_back(coalescer.submit(withdrawal(i)));
+        }
+        go.set_value();
+        for (auto &result: results) {
+            ASSERT_THROW(result.get(), std::runtime_error);
+        }
+        ASSERT_EQ(0, coalescer.stats().txs);
+
+        results.clear();
+        for (size_t i = 0; i < 3; i++) {
+            results.push_back(coalescer.submit(withdrawal(3 + i)));
+        }
+    }
+
+    ASSERT_EQ(std::vector<uint64_t>({1, 2, 3}), sent);
+    for (size_t i = 0; i < results.size(); i++) {
+        ASSERT_EQ(1 + i, results[i].get()->nonce);
+    }
+    ASSERT_EQ(4, nonces.next());
+}
+
+TEST(TxWithdrawalCoalescer, BatchClosedAfterFailureTakesReleasedNonce) {
+    minter::nonce_allocator nonces(1);
+    minter::tx_withdrawal_coalescer::options opts;
+    opts.window = std::chrono::seconds(60);
+    opts.threads = 1;
+
+    std::atomic<bool> fail(true);
+    std::vector<uint64_t> sent;
+    std::vector<std::future<minter::tx_withdrawal_coalescer::tx_ptr>> behind;
+    std::future<minter::tx_withdrawal_coalescer::tx_ptr> first, deferred;
+    {
+        minter::tx_withdrawal_coalescer coalescer(pk, nonces, opts, [&](const minter::tx_withdrawal_coalescer::tx_ptr &tx) {
+            if (fail.exchange(false)) {
+                throw std::runtime_error("can't send");
+            }
+            sent.push_back(tx->nonce);
+        });
+        first = coalescer.submit(withdrawal(0));
+        coalescer.flush();
+        // full multisend with nonce 2: the only signer builds it after nonce 1 fails, that takes a while
+        for (size_t i = 0; i < opts.max_items; i++) {
+            behind.push_back(coalescer.submit(withdrawal(1 + i)));
+        }
+        ASSERT_THROW(first.get(), std::runtime_error);
+
+        // closed while nonce 2 is not delivered yet: waits for failed nonces and takes the first one
+        deferred = coalescer.submit(withdrawal(1000));
+        coalescer.flush();
+        ASSERT_EQ(std::future_status::ready, deferred.wait_for(std::chrono::seconds(30)));
+    }
+
+    for (auto &result: behind) {
+        ASSERT_THROW(result.get(), std::runtime_error);
+    }
+    ASSERT_EQ(1, deferred.get()->nonce);
+    ASSERT_EQ(std::vector<uint64_t>({1}), sent);
+    ASSERT_EQ(2, nonces.next());
+    ASSERT_EQ(0, nonces.released());
+}
+
+TEST(TxWithdrawalCoalescer, SigningFailure) {
+    // secp256k1 rejects zero key, sign_single() returns "0x0"
+    const minter::privkey_t zero("0000000000000000000000000000000000000000000000000000000000000000");
+    minter::nonce_allocator nonces(1);
+    std::atomic<int> sent(0);
+    std::future<minter::tx_withdrawal_coalescer::tx_ptr> result;
+    {
+        minter::tx_withdrawal_coalescer::options opts;
+        opts.window = std::chrono::seconds(60);
+        minter::tx_withdrawal_coalescer coalescer(zero, nonces, opts, [&sent](const minter::tx_withdrawal_coalescer::tx_ptr &) {
+            sent++;
+        });
+        result = coalescer.submit(withdrawal(0));
+    }
+    ASSERT_THROW(result.get(), std::runtime_error);
+    ASSERT_EQ(0, sent.load());
+    ASSERT_EQ(1, nonces.next());
+}
+
+TEST(TxWithdrawalCoalescer, ConcurrentSubmitters) {
+    minter::nonce_allocator nonces(1);
+    minter::tx_withdrawal_coalescer::options opts;
+    opts.window = std::chrono::milliseconds(5);
+    opts.max_items = 16;
+    opts.threads = 2;
+    minter::tx_withdrawal_coalescer coalescer(pk, nonces, opts);
+
+    const size_t per_thread = 50;
+    std::vector<std::thread> threads;
+    std::vector<std::vector<std::future<minter::tx_withdrawal_coalescer::tx_ptr>>> results(4);
+    for (size_t t = 0; t < results.size(); t++) {
+        threads.emplace_back([&coalescer, &results, t] {
+            for (size_t i = 0; i < per_thread; i++) {
+                results[t].push_back(coalescer.submit(withdrawal(t * per_thread + i)));
+                if (i % 10 == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        });
+    }
+    for (auto &t: threads) {
+        t.join();
+    }
+
+    std::set<uint64_t> tx_nonces;
+    size_t items = 0;
+    for (auto &thread_results: results) {
+        for (auto &result: thread_results) {
+            const auto tx = result.get();
+            if (tx_nonces.insert(tx->nonce).second) {
+                items += tx->items.size();
+            }
+        }
+    }
+    ASSERT_EQ(4 * per_thread, items);
+    ASSERT_EQ(1, *tx_nonces.begin());
+    ASSERT_EQ(tx_nonces.size(), *tx_nonces.rbegin());
+
+    const auto stats = coalescer.stats();
+    ASSERT_EQ(tx_nonces.size(), stats.txs);
+    ASSERT_EQ(4 * per_thread, stats.items);
+}
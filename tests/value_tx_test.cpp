@@ -0,0 +1,227 @@
+/*!
+ * minter_tx.
+ * value_tx_test.cpp
+ *
+ * \date 2019
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <minter/tx.hpp>
+#include <minter/tx/rlp_sink.h>
+#include <minter/tx/value_tx.h>
+#include "multisig_tx.h"
+
+static const minter::privkey_t pk("df1f236d0396cc43147e44206c341a65573326e907d033690e31a21323c03a9f");
+static const minter::pubkey_t pub_key("Mpeadea542b99de3b414806b362910cc518a177f8217b8452a8385a18d1687a80b");
+
+static minter::tx_builder make_header() {
+    auto builder = minter::new_tx();
+    builder->set_nonce("5")
+        .set_chain_id(minter::mainnet)
+        .set_gas_price("2")
+        .set_gas_coin("BIP")
+        .set_payload("payload")
+        .set_service_data("service");
+    return *builder;
+}
+
+static minter::value_tx make_value_header() {
+    minter::value_tx tx;
+    tx.set_nonce(5)
+        .set_chain_id(minter::mainnet)
+        .set_gas_price(2)
+        .set_gas_coin("BIP")
+        .set_payload(dev::bytesConstRef("payload"))
+        .set_service_data(dev::bytesConstRef("service"));
+    return tx;
+}
+
+TEST(ValueTx, SendCoinSameAsTx) {
+    auto expected = make_header().tx_send_coin()
+        ->set_coin("MNT")
+        .set_to("Mx0000000000000000000000000000000000000000")
+        .set_value("10")
+        .build();
+
+    minter::value_tx tx = make_value_header();
+    tx.set_data<minter::tx_send_coin>()
+        .set_coin("MNT")
+        .set_to("Mx0000000000000000000000000000000000000000")
+        .set_value("10");
+
+    ASSERT_EQ(minter::tx_send_coin_type::type(), tx.get_type());
+    ASSERT_EQ(expected->encoded_size(), tx.encoded_size());
+
+    auto expected_signed = expected->sign_single(pk);
+    auto actual_signed = tx.sign_single(pk);
+    ASSERT_EQ(expected_signed.toHex(), actual_signed.toHex());
+    ASSERT_EQ(actual_signed.size(), tx.encoded_size());
+
+    dev::bytes written;
+    minter::rlp_buffer_sink sink(written);
+    tx.encode_to(sink);
+    ASSERT_EQ(actual_signed.get(), written);
+}
+
+TEST(ValueTx, DelegateAndMultisendSameAsTx) {
+    {
+        auto expected = make_header().tx_delegate()
+            ->set_pub_key(pub_key)
+            .set_coin("MNT")
+            .set_stake("100")
+            .build()
+            ->sign_single(pk);
+
+        minter::value_tx tx = make_value_header();
+        tx.set_data<minter::tx_delegate>()
+            .set_pub_key(pub_key)
+            .set_coin("MNT")
+            .set_stake("100");
+        ASSERT_EQ(expected.toHex(), tx.sign_single(pk).toHex());
+    }
+    {
+        auto builder = make_header();
+        auto multisend = builder.tx_multisend();
+        multisend->add_item("MNT", "Mx0000000000000000000000000000000000000001", "1");
+        multisend->add_item("BIP", "Mx0000000000000000000000000000000000000002", "2.5");
+        auto expected = multisend->build()->sign_single(pk);
+
+        minter::value_tx tx = make_value_header();
+        tx.set_data<minter::tx_multisend>()
+            .add_item("MNT", "Mx0000000000000000000000000000000000000001", "1")
+            .add_item("BIP", "Mx0000000000000000000000000000000000000002", "2.5");
+        ASSERT_EQ(expected.toHex(), tx.sign_single(pk).toHex());
+    }
+    {
+        // data doesn't fit inline buffer of encoder
+        auto builder = make_header();
+        auto multisend = builder.tx_multisend();
+        minter::value_tx tx = make_value_header();
+        auto &data = tx.set_data<minter::tx_multisend>();
+        for (int i = 0; i < 10; i++) {
+            multisend->add_item("MNT", "Mx0000000000000000000000000000000000000001", dev::bigint(i));
+            data.add_item(minter::coin_symbol("MNT"), "Mx0000000000000000000000000000000000000001", dev::bigint(i));
+        }
+        ASSERT_EQ(multisend->build()->sign_single(pk).toHex(), tx.sign_single(pk).toHex());
+    }
+}
+
+TEST(ValueTx, DecodeRoundTrip) {
+    auto encoded = make_header().tx_unbond()
+        ->set_pub_key(pub_key)
+        .set_coin("MNT")
+        .set_value("3")
+        .build()
+        ->sign_single(pk);
+
+    auto decoded = minter::value_tx::decode(encoded.toHex().c_str());
+    ASSERT_EQ(dev::bigint(5), decoded.get_nonce());
+    ASSERT_EQ(minter::mainnet, decoded.get_chain_id());
+    ASSERT_EQ(dev::bigint(2), decoded.get_gas_price());
+    ASSERT_STREQ("BIP", decoded.get_gas_coin().c_str());
+    ASSERT_EQ(minter::utils::to_bytes("payload"), decoded.get_payload());
+    ASSERT_EQ(minter::signature_type::single, decoded.get_signature_type());
+    ASSERT_EQ(nullptr, decoded.get_data<minter::tx_send_coin>());
+
+    const minter::tx_unbond *data = decoded.get_data<minter::tx_unbond>();
+    ASSERT_NE(nullptr, data);
+    ASSERT_EQ(pub_key, data->get_pub_key());
+    ASSERT_STREQ("MNT", data->get_coin().c_str());
+    ASSERT_EQ(dev::bigdec18("3"), data->get_value());
+
+    auto reference = minter::tx::decode(encoded.get());
+    auto sig = decoded.get_signature_data<minter::signature_single_data>();
+    ASSERT_EQ(reference->get_signature_data<minter::signature_single_data>()->get_r(), sig.get_r());
+
+    ASSERT_EQ(encoded.get(), decoded.encode());
+}
+
+TEST(ValueTx, RejectsUnsignedAndInvalid) {
+    minter::value_tx tx = make_value_header();
+    tx.set_data<minter::tx_unbond>()
+        .set_pub_key(pub_key)
+        .set_coin("MNT")
+        .set_value("3");
+    ASSERT_THROW(tx.encode(minter::tx_encoding::signed_tx), std::runtime_error);
+    ASSERT_FALSE(tx.encode(minter::tx_encoding::unsigned_data).empty());
+
+    // rejected the same way as by minter::tx::decode()
+    dev::bytes encoded = make_header().tx_unbond()
+        ->set_pub_key(pub_key)
+        .set_coin("MNT")
+        .set_value("3")
+        .build()
+        ->sign_single(pk)
+        .get();
+    ASSERT_NO_THROW(minter::value_tx::decode(dev::bytesConstRef(&encoded)));
+    dev::bytes truncated(encoded.begin(), encoded.end() - 1);
+    ASSERT_THROW(minter::value_tx::decode(dev::bytesConstRef(&truncated)), std::runtime_error);
+    ASSERT_THROW(minter::tx::decode(truncated), std::runtime_error);
+    ASSERT_THROW(tx.get_signature_data<minter::signature_single_data>(), std::runtime_error);
+}
+
+TEST(ValueTx, SetterDropsSignature) {
+    minter::value_tx tx = make_value_header();
+    tx.set_data<minter::tx_send_coin>()
+        .set_coin("MNT")
+        .set_to("Mx0000000000000000000000000000000000000000")
+        .set_value("1");
+    tx.sign_single(pk);
+    ASSERT_NO_THROW(tx.encode());
+
+    tx.set_nonce(6);
+    ASSERT_THROW(tx.encode(), std::runtime_error);
+    ASSERT_THROW(tx.get_signature_data<minter::signature_single_data>(), std::runtime_error);
+
+    tx.sign_single(pk);
+    const dev::bytes encoded = tx.encode();
+    ASSERT_EQ(6, minter::value_tx::decode(dev::bytesConstRef(&encoded)).get_nonce());
+
+    tx.set_data<minter::tx_send_coin>();
+    ASSERT_THROW(tx.encode(), std::runtime_error);
+}
+
+TEST(ValueTx, MultiSignature) {
+    const minter::data::address multisig("Mxdb4f4b6942cb927e8d7e3a1f602d0f1fb43b5bd2");
+    const dev::bytes encoded = make_multisig_tx(make_header().tx_send_coin()
+                                                    ->set_coin("MNT")
+                                                    .set_to("Mx0000000000000000000000000000000000000001")
+                                                    .set_value("1")
+                                                    .build()
+                                                    ->sign_single(pk)
+                                                    .get(), multisig);
+
+    minter::value_tx tx = minter::value_tx::decode(dev::bytesConstRef(&encoded));
+    ASSERT_EQ(minter::signature_type::multi, tx.get_signature_type());
+    const auto sig = tx.get_signature_data<minter::signature_multi_data>();
+    ASSERT_EQ(multisig, sig.get_address());
+    ASSERT_EQ(1, sig.get_signs().size());
+    ASSERT_EQ(encoded, tx.encode());
+}
+
+TEST(ValueTx, ContiguousBatch) {
+    std::vector<minter::value_tx> batch;
+    batch.reserve(100);
+    for (size_t i = 0; i < 100; i++) {
+        minter::value_tx tx = make_value_header();
+        tx.set_nonce(i + 1);
+        tx.set_data<minter::tx_send_coin>()
+            .set_coin("MNT")
+            .set_to("Mx0000000000000000000000000000000000000000")
+            .set_value(dev::bigint(i));
+        batch.push_back(std::move(tx));
+    }
+
+    for (size_t i = 0; i < batch.size(); i++) {
+        auto expected = make_header().set_nonce(dev::bigint(i + 1)).tx_send_coin()
+            ->set_coin("MNT")
+            .set_to("Mx0000000000000000000000000000000000000000")
+            .set_value(dev::bigint(i))
+            .build()
+            ->sign_single(pk);
+        ASSERT_EQ(expected.toHex(), batch[i].sign_single(pk).toHex());
+    }
+}